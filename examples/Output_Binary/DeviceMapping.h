@@ -0,0 +1,135 @@
+#pragma once
+// ============================================================================
+//  Generated by tools/gen_mapping.py from DiscoveryMapping.json — DO NOT EDIT.
+//  Re-run the generator after changing the mapping (or DeviceParams.h).
+// ============================================================================
+#include <Arduino.h>
+#include "HAIotBridge.h"
+#include "HestiaCore.h"
+
+// Format: { internalName, typeHA, topicTo, topicFrom, resolution, defaultValue
+//           [, deadband, minIntervalMs, maxSilenceMs] }
+static constexpr BridgeConfig bridge_config[] PROGMEM = {
+    { "IotBridge_HA_online", TypeHA::HA_ENTITIES, "", "HA/domotique/online", "", "false" },
+    { "IotBridge_HA_heartbeat", TypeHA::HA_ENTITIES, "", "HA/Heartbeat/fromHA", "", "0" },
+    { "IotBridge_restartLog", TypeHA::HA_ENTITIES, "HA/restartLog/toHESTIASDK", "", "", "false" },
+    { "IotBridge_iotHeartbeat", TypeHA::HA_INDICATOR, "Virgo/iotHeartbeat/toHA", "Virgo/iotHeartbeat/fromHA", "", "" },
+    { "IotBridge_ip", TypeHA::HA_INDICATOR, "Virgo/ip/toHA", "", "", "0.0.0.0" },
+    { "IotBridge_SW_version", TypeHA::HA_INDICATOR, "Virgo/SW_version/toHA", "", "", "v" },
+    { "IotBridge_OTA", TypeHA::HA_BUTTON, "", "Virgo/OTA/fromHA", "", "" },
+};
+
+static const size_t BRIDGE_COUNT = sizeof(bridge_config) / sizeof(BridgeConfig);
+
+// Discovery JSON (runtime-parsed form; DiscoveryTable.h is the pre-serialized one)
+static const char config_json[] PROGMEM = R"rawliteral(
+{
+  "device": {
+    "identifiers": "Virgo",
+    "name": "Virgo",
+    "manufacturer": "Jacques Bherer",
+    "model": "Hestia_SDK",
+    "sw_version": "1.0.1"
+  },
+  "o": {
+    "name": "Virgo"
+  },
+  "cmps": {
+    "ha_log_topic": {
+      "p": "sensor",
+      "name": "ha_log_topic",
+      "unique_id": "Virgo_ha_log_topic",
+      "stat_t": "Virgo/log/toHA",
+      "icon": "mdi:notebook-edit"
+    },
+    "iotHeartbeat": {
+      "p": "sensor",
+      "name": "iotHeartbeat",
+      "unique_id": "Virgo_iotHeartbeat",
+      "stat_t": "Virgo/iotHeartbeat/toHA",
+      "icon": "mdi:heart-pulse"
+    },
+    "ip": {
+      "p": "sensor",
+      "name": "ip",
+      "unique_id": "Virgo_ip",
+      "stat_t": "Virgo/ip/toHA",
+      "icon": "mdi:wifi-arrow-up",
+      "availability": [
+        {
+          "topic": "Virgo/availability"
+        }
+      ]
+    },
+    "SW_version": {
+      "p": "sensor",
+      "name": "SW_version",
+      "unique_id": "Virgo_SW_version",
+      "stat_t": "Virgo/SW_version/toHA",
+      "icon": "mdi:language-cpp",
+      "availability": [
+        {
+          "topic": "Virgo/availability"
+        }
+      ]
+    },
+    "OTA": {
+      "p": "button",
+      "name": "OTA",
+      "unique_id": "Virgo_OTA",
+      "cmd_t": "Virgo/OTA/fromHA",
+      "device_class": "update",
+      "availability": [
+        {
+          "topic": "Virgo/availability"
+        }
+      ]
+    }
+  }
+}
+)rawliteral";
+
+// HA_ID(name): compile-time row of "IotBridge_<name>"; unknown names fail the build.
+#define HA_ID(name) (HestiaCore::detail::CheckedHandle< \
+                       HestiaCore::handleOf(bridge_config, "IotBridge_" name)>::value)
+#define HA(name)    HestiaCore::at(HA_ID(name))
+
+#define HA_FIXED(name, dec) HestiaCore::FixedHandle<dec>(HA_ID(name))
+#define HA_INT(name)        HestiaCore::IntHandle(HA_ID(name))
+#define HA_BOOL(name)       HestiaCore::BoolHandle(HA_ID(name))
+
+// Entity handles. ID_ prefix: a bare name would collide with HA_<name> macros.
+namespace HestiaEntity {
+  constexpr HestiaCore::BridgeHandle ID_HA_online    = 0;
+  constexpr HestiaCore::BridgeHandle ID_HA_heartbeat = 1;
+  constexpr HestiaCore::BridgeHandle ID_restartLog   = 2;
+  constexpr HestiaCore::BridgeHandle ID_iotHeartbeat = 3;
+  constexpr HestiaCore::BridgeHandle ID_ip           = 4;
+  constexpr HestiaCore::BridgeHandle ID_SW_version   = 5;
+  constexpr HestiaCore::BridgeHandle ID_OTA          = 6;
+}
+
+static_assert(HA_ID("HA_online") == HestiaEntity::ID_HA_online, "bridge_config[] out of sync");
+static_assert(HA_ID("HA_heartbeat") == HestiaEntity::ID_HA_heartbeat, "bridge_config[] out of sync");
+static_assert(HA_ID("restartLog") == HestiaEntity::ID_restartLog, "bridge_config[] out of sync");
+static_assert(HA_ID("iotHeartbeat") == HestiaEntity::ID_iotHeartbeat, "bridge_config[] out of sync");
+static_assert(HA_ID("ip") == HestiaEntity::ID_ip, "bridge_config[] out of sync");
+static_assert(HA_ID("SW_version") == HestiaEntity::ID_SW_version, "bridge_config[] out of sync");
+static_assert(HA_ID("OTA") == HestiaEntity::ID_OTA, "bridge_config[] out of sync");
+
+#define HA_online       HestiaCore::at(HestiaEntity::ID_HA_online)
+#define HA_heartbeat    HestiaCore::at(HestiaEntity::ID_HA_heartbeat)
+#define HA_restartLog   HestiaCore::at(HestiaEntity::ID_restartLog)
+#define HA_iotHeartbeat HestiaCore::at(HestiaEntity::ID_iotHeartbeat)
+#define HA_ip           HestiaCore::at(HestiaEntity::ID_ip)
+#define HA_SW_version   HestiaCore::at(HestiaEntity::ID_SW_version)
+#define HA_OTA          HestiaCore::at(HestiaEntity::ID_OTA)
+
+// Inbound topics: 3, perfect hash fnv1a(topicFrom, seed) & 7
+static const uint16_t HESTIA_TOPIC_SLOTS[8] = {
+    0, 6, 0xFFFF, 0xFFFF, 0xFFFF, 1, 0xFFFF, 0xFFFF
+};
+
+static constexpr HestiaCore::TopicIndex HESTIA_TOPIC_INDEX = {
+    HESTIA_TOPIC_SLOTS, 8, 0x811c9dc5u
+};
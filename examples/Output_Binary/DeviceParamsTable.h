@@ -0,0 +1,73 @@
+#pragma once
+// ============================================================================
+//  Generated by tools/gen_device_params.py from DeviceParams.h — DO NOT EDIT.
+//  Re-run the generator after changing the DeviceParams JSON schema.
+// ============================================================================
+#include "HestiaParamSchema.h"
+
+static const HestiaConfig::ParamDescriptor HESTIA_PARAM_TABLE[] = {
+  // key, label, default, type, pattern, flags, decimals, minLen, maxLen, min, max, options
+  { "model", "Device Model", "Hestia_SDK",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED, 0, 1, 32, 0.0, 0.0, nullptr },
+  { "device_id", "Device Identifier", "Virgo",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED, 0, 1, 32, 0.0, 0.0, nullptr },
+  { "version_prog", "Firmware Version", "1.0.1",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED, 0, 1, 16, 0.0, 0.0, nullptr },
+  { "iot_alive_ms", "IoT Alive Interval (ms)", "5000",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 100.0, 60000.0, nullptr },
+  { "watchdog_ms", "Watchdog Timeout (ms)", "20000",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 1000.0, 120000.0, nullptr },
+  { "mqtt_flush_window", "MQTT Flush Window (ms)", "500",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 10.0, 10000.0, nullptr },
+  { "nvs_commit_ms", "NVS Commit Delay (ms)", "2000",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 0.0, 60000.0, nullptr },
+  { "mqtt_budget_ms", "MQTT Connect Budget (ms)", "1000",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 50.0, 10000.0, nullptr },
+  { "mqtt_rx_buffer", "MQTT RX Buffer (bytes)", "1024",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 256.0, 16384.0, nullptr },
+  { "ha_heartbeat_timeout_ms", "HA Heartbeat Timeout (ms)", "16000",
+    HestiaConfig::ParamType::NUMBER, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 5000.0, 300000.0, nullptr },
+  { "ha_log_topic", "Home Assistant Log Topic", "Virgo/log/toHA",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_REQUIRED, 0, 1, 128, 0.0, 0.0, nullptr },
+  { "wifi_ssid", "WiFi SSID", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL, 0, 1, 32, 0.0, 0.0, nullptr },
+  { "wifi_pass", "WiFi Password", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL, 0, 1, 64, 0.0, 0.0, nullptr },
+  { "mqtt_ip", "MQMQTT Broker IP", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::IP,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL, 0, -1, -1, 0.0, 0.0, nullptr },
+  { "mqtt_port", "MQTT Port", "1883",
+    HestiaConfig::ParamType::INT, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL | HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX, 0, -1, -1, 1.0, 65535.0, nullptr },
+  { "mqtt_user", "MQTT Username", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL, 0, 1, 64, 0.0, 0.0, nullptr },
+  { "mqtt_pass", "MQTT Password", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED | HestiaConfig::PF_CRITICAL, 0, 1, 64, 0.0, 0.0, nullptr },
+  { "timezone", "Timezone", "America/Toronto",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING | HestiaConfig::PF_REQUIRED, 0, -1, -1, 0.0, 0.0, "Pacific/Midway|Pacific/Honolulu|America/Anchorage|America/Los_Angeles|America/Denver|America/Chicago|America/Toronto|America/Santiago|America/Sao_Paulo|Atlantic/South_Georgia|Atlantic/Azores|Europe/London|Europe/Paris|Europe/Athens|Europe/Moscow|Asia/Dubai|Asia/Karachi|Asia/Dhaka|Asia/Bangkok|Asia/Hong_Kong|Asia/Tokyo|Australia/Sydney|Pacific/Noumea|Pacific/Auckland" },
+  { "iot_user", "IoT Username", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING, 0, 0, 64, 0.0, 0.0, nullptr },
+  { "iot_pass", "IoT Password", "",
+    HestiaConfig::ParamType::STRING, HestiaConfig::PatternType::ANYTHING,
+    HestiaConfig::PF_PROVISIONING, 0, 0, 64, 0.0, 0.0, nullptr },
+};
+
+static constexpr size_t HESTIA_PARAM_COUNT =
+    sizeof(HESTIA_PARAM_TABLE) / sizeof(HESTIA_PARAM_TABLE[0]);
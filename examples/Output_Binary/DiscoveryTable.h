@@ -0,0 +1,38 @@
+#pragma once
+// ============================================================================
+//  Generated by tools/gen_discovery.py from DiscoveryMapping.json — DO NOT EDIT.
+//  Re-run the generator after changing the discovery JSON.
+// ============================================================================
+#include "HestiaNetSDK.h"
+
+// ha_log_topic: 211 bytes
+static const char HESTIA_DISC_TOPIC_0[] PROGMEM = "homeassistant/sensor/Virgo_ha_log_topic/config";
+static const char HESTIA_DISC_PAYLOAD_0[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"ha_log_topic\",\"uniq_id\":\"Virgo_ha_log_topic\",\"stat_t\":\"Virgo/log/toHA\",\"ic\":\"mdi:notebook-edit\",\"dev\":{\"ids\":[\"Virgo\"],\"name\":\"Virgo\",\"mf\":\"Jacques Bherer\",\"mdl\":\"Hestia_SDK\",\"sw\":\"1.0.1\"}}";
+
+// iotHeartbeat: 149 bytes
+static const char HESTIA_DISC_TOPIC_1[] PROGMEM = "homeassistant/sensor/Virgo_iotHeartbeat/config";
+static const char HESTIA_DISC_PAYLOAD_1[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"iotHeartbeat\",\"uniq_id\":\"Virgo_iotHeartbeat\",\"stat_t\":\"Virgo/iotHeartbeat/toHA\",\"ic\":\"mdi:heart-pulse\",\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// ip: 157 bytes
+static const char HESTIA_DISC_TOPIC_2[] PROGMEM = "homeassistant/sensor/Virgo_ip/config";
+static const char HESTIA_DISC_PAYLOAD_2[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"ip\",\"uniq_id\":\"Virgo_ip\",\"stat_t\":\"Virgo/ip/toHA\",\"ic\":\"mdi:wifi-arrow-up\",\"avty\":[{\"t\":\"Virgo/availability\"}],\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// SW_version: 180 bytes
+static const char HESTIA_DISC_TOPIC_3[] PROGMEM = "homeassistant/sensor/Virgo_SW_version/config";
+static const char HESTIA_DISC_PAYLOAD_3[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"SW_version\",\"uniq_id\":\"Virgo_SW_version\",\"stat_t\":\"Virgo/SW_version/toHA\",\"ic\":\"mdi:language-cpp\",\"avty\":[{\"t\":\"Virgo/availability\"}],\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// OTA: 155 bytes
+static const char HESTIA_DISC_TOPIC_4[] PROGMEM = "homeassistant/button/Virgo_OTA/config";
+static const char HESTIA_DISC_PAYLOAD_4[] PROGMEM = "{\"p\":\"button\",\"name\":\"OTA\",\"uniq_id\":\"Virgo_OTA\",\"cmd_t\":\"Virgo/OTA/fromHA\",\"dev_cla\":\"update\",\"avty\":[{\"t\":\"Virgo/availability\"}],\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+static const HestiaNet::DiscoveryEntry HESTIA_DISCOVERY_TABLE[] = {
+  // topic, payload, fnv1a(payload, fnv1a(topic))
+  { HESTIA_DISC_TOPIC_0, HESTIA_DISC_PAYLOAD_0, 0xdee6b3fau },
+  { HESTIA_DISC_TOPIC_1, HESTIA_DISC_PAYLOAD_1, 0x3e7e2489u },
+  { HESTIA_DISC_TOPIC_2, HESTIA_DISC_PAYLOAD_2, 0x957380d5u },
+  { HESTIA_DISC_TOPIC_3, HESTIA_DISC_PAYLOAD_3, 0x4eec845eu },
+  { HESTIA_DISC_TOPIC_4, HESTIA_DISC_PAYLOAD_4, 0xf5d013e2u },
+};
+
+static constexpr size_t HESTIA_DISCOVERY_COUNT =
+    sizeof(HESTIA_DISCOVERY_TABLE) / sizeof(HESTIA_DISCOVERY_TABLE[0]);
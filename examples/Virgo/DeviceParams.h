@@ -8,13 +8,15 @@
  * non-provisioning firmware parameters. The HestiaSDK library remains neutral
  * and independent from these values.
  *
- * The JSON schema is loaded at boot through:
- *      HestiaConfig::loadDeviceParams(HESTIA_PARAM_JSON);
+ * tools/gen_device_params.py compiles this schema into DeviceParamsTable.h
+ * (flash-resident ParamDescriptor table) which is loaded at boot through:
+ *      HestiaConfig::loadDeviceParams(HESTIA_PARAM_TABLE, HESTIA_PARAM_COUNT);
+ * Re-run the generator after editing this file. The JSON itself is only
+ * needed by the JSON loader fallback.
  *
  * IMPORTANT:
  *  - Only firmware-driven (non-provisioning) parameters are defined here.
  *  - Provisioning parameters (WiFi, MQTT, etc.) will be migrated later.
- *  - This file will eventually be auto-generated by the future Hestia Generator.
  *
 
  * ============================================================================
@@ -96,7 +98,9 @@
  *   Supported values:
  *     - "anything"  (default)
  *     - "ip"        (IPv4 address)
- *     - "hostname"
+ *     - "hostname"  (dotted labels of [A-Za-z0-9-])
+ *     - "url"       (http/https/mqtt/mqtts/ws/wss://host[:port][/path])
+ *     - "email"     (local@domain.tld)
  *     - "bool"
  *
  * --------------------------------------------------------------------------
@@ -209,6 +213,39 @@ static const char HESTIA_PARAM_JSON[] PROGMEM = R"json(
       "decimals": 0,
       "validate": { "min": 10, "max": 10000 }
     },
+    {
+      "key": "nvs_commit_ms",
+      "type": "number",
+      "label": "NVS Commit Delay (ms)",
+      "provisioning": false,
+      "required": true,
+      "critical": false,
+      "default": "2000",
+      "decimals": 0,
+      "validate": { "min": 0, "max": 60000 }
+    },
+    {
+      "key": "mqtt_budget_ms",
+      "type": "number",
+      "label": "MQTT Connect Budget (ms)",
+      "provisioning": false,
+      "required": true,
+      "critical": false,
+      "default": "1000",
+      "decimals": 0,
+      "validate": { "min": 50, "max": 10000 }
+    },
+    {
+      "key": "mqtt_rx_buffer",
+      "type": "number",
+      "label": "MQTT RX Buffer (bytes)",
+      "provisioning": false,
+      "required": true,
+      "critical": false,
+      "default": "1024",
+      "decimals": 0,
+      "validate": { "min": 256, "max": 16384 }
+    },
     {
       "key": "ha_heartbeat_timeout_ms",
       "type": "number",
@@ -383,11 +420,16 @@ static const char HESTIA_PARAM_JSON[] PROGMEM = R"json(
 
 // ============================================================================
 // Aliases for device parameters (auto-linked to HestiaConfig)
+//   Each alias resolves its key once through the hash index, then returns the
+//   cached pointer. Requires: using HestiaConfig::literals::operator"" _pid;
 // ============================================================================
-#define PARAM_MODEL              (HestiaConfig::getParamObj("model"))
-#define PARAM_VERSION_PROG       (HestiaConfig::getParamObj("version_prog"))
-#define PARAM_IOT_ALIVE_MS       (HestiaConfig::getParamObj("iot_alive_ms"))
-#define PARAM_WATCHDOG_MS        (HestiaConfig::getParamObj("watchdog_ms"))
-#define PARAM_MQTT_FLUSH_WINDOW  (HestiaConfig::getParamObj("mqtt_flush_window"))
-#define PARAM_DEVICE_ID          (HestiaConfig::getParamObj("device_id"))
-#define PARAM_HA_LOG_TOPIC       (HestiaConfig::getParamObj("ha_log_topic"))
+#define PARAM_MODEL              (HestiaConfig::param<"model"_pid>())
+#define PARAM_VERSION_PROG       (HestiaConfig::param<"version_prog"_pid>())
+#define PARAM_IOT_ALIVE_MS       (HestiaConfig::param<"iot_alive_ms"_pid>())
+#define PARAM_WATCHDOG_MS        (HestiaConfig::param<"watchdog_ms"_pid>())
+#define PARAM_MQTT_FLUSH_WINDOW  (HestiaConfig::param<"mqtt_flush_window"_pid>())
+#define PARAM_NVS_COMMIT_MS      (HestiaConfig::param<"nvs_commit_ms"_pid>())
+#define PARAM_MQTT_BUDGET_MS     (HestiaConfig::param<"mqtt_budget_ms"_pid>())
+#define PARAM_MQTT_RX_BUFFER     (HestiaConfig::param<"mqtt_rx_buffer"_pid>())
+#define PARAM_DEVICE_ID          (HestiaConfig::param<"device_id"_pid>())
+#define PARAM_HA_LOG_TOPIC       (HestiaConfig::param<"ha_log_topic"_pid>())
@@ -0,0 +1,38 @@
+#pragma once
+// ============================================================================
+//  Generated by tools/gen_discovery.py from main.h — DO NOT EDIT.
+//  Re-run the generator after changing the discovery JSON.
+// ============================================================================
+#include "HestiaNetSDK.h"
+
+// ip: 180 bytes
+static const char HESTIA_DISC_TOPIC_0[] PROGMEM = "homeassistant/sensor/Virgo_IP Address/config";
+static const char HESTIA_DISC_PAYLOAD_0[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"ip\",\"uniq_id\":\"Virgo_IP Address\",\"stat_t\":\"Virgo/ip/toHA\",\"dev\":{\"ids\":[\"Virgo\"],\"name\":\"Virgo\",\"mf\":\"Jacques Bherer\",\"mdl\":\"Hestia SDK Device\",\"sw\":\"1.0.0\"}}";
+
+// log: 99 bytes
+static const char HESTIA_DISC_TOPIC_1[] PROGMEM = "homeassistant/sensor/Virgo_log/config";
+static const char HESTIA_DISC_PAYLOAD_1[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"log\",\"uniq_id\":\"Virgo_log\",\"stat_t\":\"Virgo/log/toHA\",\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// iotHeartbeat: 126 bytes
+static const char HESTIA_DISC_TOPIC_2[] PROGMEM = "homeassistant/sensor/Virgo_iotHeartbeat/config";
+static const char HESTIA_DISC_PAYLOAD_2[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"iotHeartbeat\",\"uniq_id\":\"Virgo_iotHeartbeat\",\"stat_t\":\"Virgo/iotHeartbeat/toHA\",\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// SW_version: 156 bytes
+static const char HESTIA_DISC_TOPIC_3[] PROGMEM = "homeassistant/sensor/Virgo_SW_version/config";
+static const char HESTIA_DISC_PAYLOAD_3[] PROGMEM = "{\"p\":\"sensor\",\"name\":\"SW_version\",\"uniq_id\":\"Virgo_SW_version\",\"stat_t\":\"Virgo/SW_version/toHA\",\"avty\":[{\"t\":\"Virgo/availability\"}],\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+// OTA: 202 bytes
+static const char HESTIA_DISC_TOPIC_4[] PROGMEM = "homeassistant/button/Virgo_OTA2/config";
+static const char HESTIA_DISC_PAYLOAD_4[] PROGMEM = "{\"p\":\"button\",\"name\":\"OTA update\",\"ic\":\"mdi:cellphone-arrow-down\",\"uniq_id\":\"Virgo_OTA2\",\"stat_t\":\"Virgo/OTA/toHA\",\"cmd_t\":\"Virgo/OTA/fromHA\",\"avty\":[{\"t\":\"Virgo/availability\"}],\"dev\":{\"ids\":[\"Virgo\"]}}";
+
+static const HestiaNet::DiscoveryEntry HESTIA_DISCOVERY_TABLE[] = {
+  // topic, payload, fnv1a(payload, fnv1a(topic))
+  { HESTIA_DISC_TOPIC_0, HESTIA_DISC_PAYLOAD_0, 0x0ca8cd40u },
+  { HESTIA_DISC_TOPIC_1, HESTIA_DISC_PAYLOAD_1, 0x170c1941u },
+  { HESTIA_DISC_TOPIC_2, HESTIA_DISC_PAYLOAD_2, 0xb3014c15u },
+  { HESTIA_DISC_TOPIC_3, HESTIA_DISC_PAYLOAD_3, 0x65871100u },
+  { HESTIA_DISC_TOPIC_4, HESTIA_DISC_PAYLOAD_4, 0x39bf6d65u },
+};
+
+static constexpr size_t HESTIA_DISCOVERY_COUNT =
+    sizeof(HESTIA_DISCOVERY_TABLE) / sizeof(HESTIA_DISCOVERY_TABLE[0]);
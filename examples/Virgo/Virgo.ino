@@ -33,9 +33,12 @@
 #include "HestiaProvisioning.h"
 #include "HestiaParam.h"
 #include "DeviceParams.h"
+#include "DeviceParamsTable.h"   // generated: tools/gen_device_params.py DeviceParams.h
+#include "DiscoveryTable.h"      // generated: tools/gen_discovery.py main.h
 #include "HestiaOTA.h"
 #include "HestiaTempo.h"
 using Tempo::literals::operator"" _id;
+using HestiaConfig::literals::operator"" _pid;
 
 // ***** OBJECTS INITIALISATION  **********************************************************
 
@@ -51,7 +54,10 @@ int pinProvisioning = 9;
 // ***** SETUP SETUP  SETUP SETUP  SETUP SETUP  SETUP SETUP  ******************************
 void setup() 
 {
-    HestiaCore::initCore(HESTIA_PARAM_JSON, bridge_config, BRIDGE_COUNT, config_json);
+    HestiaCore::initCore(HESTIA_PARAM_TABLE, HESTIA_PARAM_COUNT,
+                         bridge_config, BRIDGE_COUNT,
+                         HESTIA_DISCOVERY_TABLE, HESTIA_DISCOVERY_COUNT);
+    // HestiaCore::startNetworkTask();      // optional: Wi-Fi/MQTT in their own task (core 0)
  
     // 1) INPUT / OUTPUT SETUP
     // ---------------------------------------------------------------------
@@ -105,6 +111,7 @@ void loop()
     if (InitHAOK && HA_OTA_Update->onChange()) {
         String ip = WiFi.localIP().toString();
         HestiaCore::logBook("Entering OTA mode. Go to OTA URL: http://" + ip + "/ota");
+        HestiaCore::stopNetworkTask();          // back to single-loop mode (no-op if not started)
         HestiaNet::disconnectMQTT();            // gracefully disconnect MQTT
         HestiaOTA_Web_Start();
     }
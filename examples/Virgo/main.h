@@ -33,14 +33,16 @@
 //  ----------------------------------------------------------------------------
 //  Each entry describes a single Home Assistant entity exposed by the device.
 //  Format: { internalName, typeHA, topicTo, topicFrom, resolution, defaultValue }
+//  Optional trailing fields: deadband ("0.5" / "5%"), minIntervalMs, maxSilenceMs
 //
 //  All fields are passed verbatim to the HAIoTBridge constructor.
 //
 //  This table must remain PROGMEM-resident: entities are instantiated once and
-//  never modified at runtime.
+//  never modified at runtime. It is declared constexpr so the HA(...) macros
+//  below resolve entity names to registry handles at compile time.
 // ============================================================================
 
-static const BridgeConfig bridge_config[] PROGMEM = {
+static constexpr BridgeConfig bridge_config[] PROGMEM = {
 
     // ------------------------------------------------------------------------
     //  System Diagnostics Entities
@@ -125,8 +127,9 @@ static const size_t BRIDGE_COUNT =
 //    • const char[]
 //    • Null-terminated
 //
-//  The actual JSON structure is injected through HestiaNet::loadDiscoveryJson()
-//  in main.cpp.
+//  It is the source of DiscoveryTable.h (tools/gen_discovery.py main.h):
+//  re-run the generator after editing it. Passing config_json itself to
+//  initCore() still works, at the cost of parsing it at runtime.
 // ============================================================================
 
 
@@ -189,19 +192,23 @@ static const char config_json[] PROGMEM = R"rawliteral(
 
 
 
-// ============================================================================
-// Forward Declarations
-// ============================================================================
-class HAIoTBridge;
-
-namespace HestiaCore {
-  HAIoTBridge* get(const String& name);
-}
-
 // ============================================================================
 // Macros — Simplified Entity Access
+// ----------------------------------------------------------------------------
+//  HA_ID(name) is a compile-time constant: the row of "IotBridge_<name>" in
+//  bridge_config[]. An unknown name is a build error.
+//  HA(name) is then a plain array index into the bridge registry — no String,
+//  no scan, no allocation — and is safe to use in loop().
 // ============================================================================
-#define HA(name) HestiaCore::get("IotBridge_" name)
+#define HA_ID(name) (HestiaCore::detail::CheckedHandle< \
+                       HestiaCore::handleOf(bridge_config, "IotBridge_" name)>::value)
+#define HA(name)    HestiaCore::at(HA_ID(name))
+
+// Typed access for numeric / boolean entities (see HestiaCore::FixedHandle):
+//   HA_FIXED("temperature", 1).write(21.5f);   HA_BOOL("relay").read();
+#define HA_FIXED(name, dec) HestiaCore::FixedHandle<dec>(HA_ID(name))
+#define HA_INT(name)        HestiaCore::IntHandle(HA_ID(name))
+#define HA_BOOL(name)       HestiaCore::BoolHandle(HA_ID(name))
 
 #define HA_restartLog     HA("restartLog")
 #define HA_iotHeartbeat   HA("iotHeartbeat")
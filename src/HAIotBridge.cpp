@@ -1,6 +1,19 @@
 #include <Arduino.h>
+#include <math.h>
 #include "HAIotBridge.h"
+#include "HestiaFixed.h"
 #include "HestiaCore.h"
+#include "HestiaPersist.h"
+
+namespace {
+  using HestiaFixed::POW10;
+  using HestiaFixed::parseScaled;
+  using HestiaFixed::formatScaled;
+  using HestiaFixed::rescale;
+
+  const char* const BOOL_TRUE[]  = { "ON",  "on",  "true",  "TRUE"  };
+  const char* const BOOL_FALSE[] = { "OFF", "off", "false", "FALSE" };
+}
 
 // ============================================================================
 // HAIoTBridge — Implementation
@@ -10,28 +23,27 @@
 // Constructor
 // -----------------------------------------------------------------------------
 // Initializes the bridge from a static BridgeConfig structure.
-// All null pointers in cfg are safely replaced with empty strings.
-// Computes decimal precision from the resolution string and prepares
-// the shortened NVS key used to persist HA_CONTROL values.
+// Metadata is not copied: the bridge keeps a pointer to the table row, and
+// accessors replace null pointers with empty strings.
+// Computes decimal precision from the resolution string, selects the value
+// storage kind and prepares the shortened NVS key used to persist HA_CONTROL
+// values.
 //
 HAIoTBridge::HAIoTBridge(const BridgeConfig& cfg)
-: _name(cfg.name),
+: _cfg(&cfg),
   _type(cfg.type),
-  _topicTo(cfg.topicTo ? cfg.topicTo : ""),
-  _topicFrom(cfg.topicFrom ? cfg.topicFrom : ""),
-  _resolution(cfg.resolution ? cfg.resolution : ""),
-  _defaultValue(cfg.defaultValue ? cfg.defaultValue : ""),
   _decimals(0),
-  _value(""),
-  _valueMem(""),
+  _kind(ValueKind::TEXT),
   _initialized(false),
   _logWrites(true)
 {
-  _decimals = computeDecimals(_resolution);
-  _nvsKey = shortenKey(_name);
+  _decimals = computeDecimals(cfg.resolution);
+  _kind     = selectKind(_type, cfg.resolution, _decimals, defaultValue());
+  shortenKey(name(), _nvsKey);
+  setupDeadband();
 
   Serial.printf("[HAIoTBridge] %-28s → NVS key: %s\n",
-                _name.c_str(), _nvsKey.c_str());
+                name(), _nvsKey);
 }
 
 // -----------------------------------------------------------------------------
@@ -43,27 +55,30 @@ HAIoTBridge::HAIoTBridge(const BridgeConfig& cfg)
 // Once initialized, the bridge automatically publishes its current state.
 //
 void HAIoTBridge::init() {
+  Preferences prefs;
+  bool open = (_type == TypeHA::HA_CONTROL) && prefs.begin(NVS_NAMESPACE, true);
+  init(prefs);
+  if (open) prefs.end();
+}
+
+void HAIoTBridge::init(Preferences& prefs) {
   if (_type == TypeHA::HA_CONTROL) {
-    preferences.begin("Pref", true);
-    String val = preferences.getString(_nvsKey.c_str(), "");
-    preferences.end();
+    String val = prefs.getString(_nvsKey, "");
 
-    if (val.isEmpty() && !_defaultValue.isEmpty()) {
+    if (val.isEmpty() && defaultValue()[0] != '\0') {
       Serial.printf("  ↳ No NVS value for %s, using default value: %s\n",
-                    _name.c_str(), _defaultValue.c_str());
-      _value = _defaultValue;
-      _valueMem = _defaultValue;
+                    name(), defaultValue());
+      parse(defaultValue(), _value);
     } else {
-      _value = normalize(_decimals, val);
-      _valueMem = _value;
+      parse(val.c_str(), _value);
       Serial.printf("  ↳ %s restored from NVS, value: %s\n",
-                    _name.c_str(), val.c_str());
+                    name(), val.c_str());
     }
   } else {
-    Serial.printf("  ↳ No NVS restore for: %s\n", _name.c_str());
-    _value = _defaultValue;
-    _valueMem = _defaultValue;
+    Serial.printf("  ↳ No NVS restore for: %s\n", name());
+    parse(defaultValue(), _value);
   }
+  _valueMem = _value;
 
   _initialized = true;
 
@@ -75,7 +90,8 @@ void HAIoTBridge::init() {
 
 void HAIoTBridge::publishValueToHA(){
   if (_type == TypeHA::HA_CONTROL) {
-    publish(_value);
+    char buf[FMT_BUF];
+    publish(format(_value, buf));
   }
 }
 
@@ -83,21 +99,84 @@ void HAIoTBridge::publishValueToHA(){
 // -----------------------------------------------------------------------------
 // Updates the internal value and publishes it.
 // If the bridge is HA_CONTROL, the value is saved to NVS before publishing.
+// Numeric and boolean overloads store directly into the typed slot when the
+// entity kind allows it; the payload is formatted once, on a stack buffer.
+//
+// Publication then goes through the shaping gate (deadband / min interval).
 //
-void HAIoTBridge::write(const String& v) { 
-  _value = v;
+void HAIoTBridge::commit() {
   _valueMem = _value;
-  if (_type == TypeHA::HA_CONTROL) {
-    saveAndPublish(_value);
-  } else {
-    publish(_value);
+  queueSave();
+
+  switch (publishGate(millis())) {
+    case PublishGate::PUBLISH:
+      break;
+    case PublishGate::DEFER:
+      _pubPending = true;
+      _suppressed++;
+      return;
+    case PublishGate::SUPPRESS:
+      _suppressed++;
+      return;
   }
+
+  char buf[FMT_BUF];
+  publish(format(_value, buf));
 }
 
-void HAIoTBridge::write(const char* v) { write(String(v)); }
-void HAIoTBridge::write(float v) { write(String(v, (unsigned int)_decimals)); }
-void HAIoTBridge::write(int v) { write(String(v)); }
-void HAIoTBridge::write(bool v) { write(v ? "ON" : "OFF"); }
+void HAIoTBridge::write(const String& v) { write(v.c_str()); }
+
+void HAIoTBridge::write(const char* v) {
+  parse(v ? v : "", _value);
+  commit();
+}
+
+void HAIoTBridge::write(float v) {
+  if ((_kind == ValueKind::FIXED || _kind == ValueKind::INTEGER)
+      && fabsf(v * POW10[_decimals]) < (float)INT32_MAX) {
+    _value.tag = _kind;
+    _value.num = (int32_t)lroundf(v * POW10[_decimals]);
+    _value.text = String();
+    commit();
+    return;
+  }
+  write(String(v, (unsigned int)_decimals));
+}
+
+void HAIoTBridge::write(int v) {
+  if (_kind == ValueKind::FIXED || _kind == ValueKind::INTEGER) {
+    writeScaled(v, 0);
+    return;
+  }
+  write(String(v));
+}
+
+void HAIoTBridge::write(bool v) {
+  if (_kind == ValueKind::BOOLEAN) {
+    _value.tag   = ValueKind::BOOLEAN;
+    _value.style = BOOL_ON_OFF;
+    _value.num   = v ? 1 : 0;
+    _value.text  = String();
+    commit();
+    return;
+  }
+  write(v ? "ON" : "OFF");
+}
+
+void HAIoTBridge::writeScaled(int32_t raw, uint8_t dec) {
+  int32_t num;
+  if ((_kind == ValueKind::FIXED || _kind == ValueKind::INTEGER)
+      && rescale(raw, dec, _decimals, num)) {
+    _value.tag = _kind;
+    _value.num = num;
+    _value.text = String();
+    commit();
+    return;
+  }
+  // Out of the slot's int32 range at this resolution: kept as text
+  char buf[FMT_BUF];
+  write(formatScaled(raw, dec, buf));
+}
 
 // -----------------------------------------------------------------------------
 // Change detection
@@ -107,11 +186,11 @@ void HAIoTBridge::write(bool v) { write(v ? "ON" : "OFF"); }
 // - Empty values are ignored.
 // -----------------------------------------------------------------------------
 bool HAIoTBridge::onChange() {
-  if (_value.isEmpty()) return false;
+  if (_value.empty()) return false;
 
   if (_type == TypeHA::HA_BUTTON) {
-    _value = "";
-    _valueMem = "";
+    _value = Value();
+    _valueMem = Value();
     return true;
   }
 
@@ -133,7 +212,7 @@ bool HAIoTBridge::onChange() {
 // -----------------------------------------------------------------------------
 bool HAIoTBridge::readMQTT(String &topic, String &payload, bool flushMode) {
   // 1) Check input channel eligibility
-  if (_topicFrom.isEmpty() || _type == TypeHA::HA_INDICATOR) {
+  if (topicFrom()[0] == '\0' || _type == TypeHA::HA_INDICATOR) {
     return false;
   }
   if (flushMode && _type != TypeHA::HA_ENTITIES) {
@@ -142,16 +221,17 @@ bool HAIoTBridge::readMQTT(String &topic, String &payload, bool flushMode) {
   }
 
   // 2) Check topic match
-  if (topic != _topicFrom) {
+  if (topic != topicFrom()) {
     return false;   // Not our topic
   }
 
   // 3) Process message
-  // Serial.printf("[MQTT] %s <- %s\n", _name.c_str(), payload.c_str());
-  _value = payload;
+  // Serial.printf("[MQTT] %s <- %s\n", name(), payload.c_str());
+  parse(payload.c_str(), _value);
   
   if (_type == TypeHA::HA_CONTROL) {
-    saveAndPublish(_value);
+    char buf[FMT_BUF];
+    saveAndPublish(format(_value, buf));
   }
   
   return true;  // Message consumed
@@ -161,23 +241,64 @@ bool HAIoTBridge::readMQTT(String &topic, String &payload, bool flushMode) {
 // Read operations
 // -----------------------------------------------------------------------------
 // Lightweight accessors providing the internal value in various formats.
+// Typed values are converted with integer math; TEXT keeps the legacy
+// String conversions.
 // -----------------------------------------------------------------------------
 String HAIoTBridge::read() const { 
-  return _value; 
+  if (_value.tag == ValueKind::TEXT) return _value.text;
+  char buf[FMT_BUF];
+  return String(format(_value, buf)); 
 }
 
 int HAIoTBridge::readInt() const { 
-  return _value.toInt(); 
+  switch (_value.tag) {
+    case ValueKind::INTEGER:
+    case ValueKind::BOOLEAN: return _value.num;
+    case ValueKind::FIXED:   return _value.num / POW10[_decimals];
+    default:                 return _value.text.toInt();
+  }
 }
 
 float HAIoTBridge::readFloat() const { 
-  return _value.toFloat(); 
+  switch (_value.tag) {
+    case ValueKind::INTEGER:
+    case ValueKind::BOOLEAN: return (float)_value.num;
+    case ValueKind::FIXED:   return (float)_value.num / POW10[_decimals];
+    default:                 return _value.text.toFloat();
+  }
+}
+
+int32_t HAIoTBridge::readScaled(uint8_t dec) const {
+  if (dec > MAX_FIXED_DECIMALS) dec = MAX_FIXED_DECIMALS;
+  switch (_value.tag) {
+    case ValueKind::INTEGER:
+    case ValueKind::BOOLEAN:
+    case ValueKind::FIXED: {
+      int32_t out;
+      rescale(_value.num, _value.tag == ValueKind::FIXED ? _decimals : 0, dec, out);   // Saturates
+      return out;
+    }
+    default: {
+      int32_t out = 0;
+      if (parseScaled(_value.text.c_str(), dec, out)) return out;
+      // Numeric text too large for this resolution (writeScaled fallback): saturate
+      if (parseScaled(_value.text.c_str(), 0, out)) rescale(out, 0, dec, out);
+      else out = 0;
+      return out;
+    }
+  }
 }
 
 bool HAIoTBridge::readBool() const { 
-  return _value.equalsIgnoreCase("true")
-        || _value.equalsIgnoreCase("on")
-        || _value == "1";
+  switch (_value.tag) {
+    case ValueKind::BOOLEAN: return _value.num != 0;
+    case ValueKind::INTEGER: return _value.num == 1;
+    case ValueKind::FIXED:   return _value.num == POW10[_decimals];
+    default:
+      return _value.text.equalsIgnoreCase("true")
+          || _value.text.equalsIgnoreCase("on")
+          || _value.text == "1";
+  }
 }
 // -----------------------------------------------------------------------------
 // NVS reset
@@ -186,11 +307,16 @@ bool HAIoTBridge::readBool() const {
 // HA_CONTROL state so that the next initialization will reload defaults.
 // -----------------------------------------------------------------------------
 void HAIoTBridge::reset() {
-  preferences.begin("Pref", false);
-  preferences.remove(_nvsKey.c_str());
-  preferences.end();
-  _value.clear();
-  _valueMem.clear();
+  if (_nvsDirty) {     // drop any pending write-behind save
+    _nvsDirty = false;
+    HestiaPersist::cancel(this);
+  }
+  Preferences prefs;
+  prefs.begin(NVS_NAMESPACE, false);
+  prefs.remove(_nvsKey);
+  prefs.end();
+  _value = Value();
+  _valueMem = Value();
 }
 
 // -----------------------------------------------------------------------------
@@ -200,16 +326,20 @@ bool HAIoTBridge::isInitialized() const {
   return _initialized; 
 }
 
-const String& HAIoTBridge::name() const { 
-  return _name; 
+const char* HAIoTBridge::name() const { 
+  return _cfg->name ? _cfg->name : ""; 
 }
 
-const String& HAIoTBridge::topicTo() const { 
-  return _topicTo; 
+const char* HAIoTBridge::topicTo() const { 
+  return _cfg->topicTo ? _cfg->topicTo : ""; 
 }
 
-const String& HAIoTBridge::topicFrom() const { 
-  return _topicFrom; 
+const char* HAIoTBridge::topicFrom() const { 
+  return _cfg->topicFrom ? _cfg->topicFrom : ""; 
+}
+
+const char* HAIoTBridge::defaultValue() const { 
+  return _cfg->defaultValue ? _cfg->defaultValue : ""; 
 }
 
 TypeHA HAIoTBridge::type() const { 
@@ -220,6 +350,10 @@ uint8_t HAIoTBridge::decimals() const {
   return _decimals; 
 }
 
+ValueKind HAIoTBridge::kind() const { 
+  return _kind; 
+}
+
 void HAIoTBridge::setLogWrites(bool enable) {
     _logWrites = enable;
 }
@@ -236,52 +370,85 @@ void HAIoTBridge::setLogWrites(bool enable) {
 //    "0.01" → 2 decimals
 //    "1"    → 0 decimals
 // -----------------------------------------------------------------------------
-uint8_t HAIoTBridge::computeDecimals(const String& res) {
-  int p = res.indexOf('.');
-  return (p < 0) ? 0 : (uint8_t)(res.length() - p - 1);
+uint8_t HAIoTBridge::computeDecimals(const char* res) {
+  if (!res) return 0;
+  const char* p = strchr(res, '.');
+  return p ? (uint8_t)strlen(p + 1) : 0;
 }
 
 // -----------------------------------------------------------------------------
-// isFloatLike
+// selectKind
 // -----------------------------------------------------------------------------
-// Returns true if the string can be interpreted as a float.
-// Rules:
-//   • Optional leading minus
-//   • At most one decimal point
-//   • Must contain at least one digit
+// Picks the storage kind for an entity (see ValueKind in HAIotBridge.h).
+// Buttons stay TEXT: they are stateless triggers, any payload is an event.
 // -----------------------------------------------------------------------------
-bool HAIoTBridge::isFloatLike(const String& s) {
-  if (s.isEmpty()) return false;
-  bool pointSeen = false, signSeen = false, digitSeen = false;
-  for (size_t i = 0; i < s.length(); ++i) {
-    char c = s[i];
-    if (c == '-' && i == 0 && !signSeen) { 
-      signSeen = true; 
-      continue; 
-    }
-    if (c == '.') { 
-      if (pointSeen) return false; 
-      pointSeen = true; 
-      continue; 
-    }
-    if (c < '0' || c > '9') return false;
-    digitSeen = true;
+ValueKind HAIoTBridge::selectKind(TypeHA type, const char* res, uint8_t dec, const char* def) {
+  if (type == TypeHA::HA_BUTTON) return ValueKind::TEXT;
+
+  if (res && res[0] != '\0') {
+    if (dec == 0)                  return ValueKind::INTEGER;
+    if (dec <= MAX_FIXED_DECIMALS) return ValueKind::FIXED;
+    return ValueKind::TEXT;
   }
-  return digitSeen;
+
+  bool b;
+  uint8_t style;
+  if (parseBool(def, b, style)) return ValueKind::BOOLEAN;
+
+  return ValueKind::TEXT;
+}
+
+// -----------------------------------------------------------------------------
+// parseBool
+// -----------------------------------------------------------------------------
+bool HAIoTBridge::parseBool(const char* s, bool& out, uint8_t& style) {
+  if (!s) return false;
+  for (uint8_t i = 0; i < 4; ++i) {
+    if (strcmp(s, BOOL_TRUE[i]) == 0)  { out = true;  style = i; return true; }
+    if (strcmp(s, BOOL_FALSE[i]) == 0) { out = false; style = i; return true; }
+  }
+  return false;
 }
 
 // -----------------------------------------------------------------------------
-// normalize
+// parse / format
 // -----------------------------------------------------------------------------
-// Normalizes numeric values according to the decimal precision.
-// For float-like strings, the value is formatted with the given number of
-// decimals; otherwise, the string is returned untouched.
+// Convert between payload text and the typed slot. Parsing falls back to TEXT
+// so that unexpected payloads (e.g. "unavailable") are kept verbatim.
 // -----------------------------------------------------------------------------
-String HAIoTBridge::normalize(uint8_t dec, const String& s) {
-  if (isFloatLike(s)) {
-    return String(s.toFloat(), (unsigned int)dec);
+void HAIoTBridge::parse(const char* s, Value& out) const {
+  bool ok = false;
+  switch (_kind) {
+    case ValueKind::INTEGER:
+    case ValueKind::FIXED:
+      ok = parseScaled(s, _decimals, out.num);
+      break;
+    case ValueKind::BOOLEAN: {
+      bool b;
+      ok = parseBool(s, b, out.style);
+      if (ok) out.num = b ? 1 : 0;
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (ok) {
+    out.tag  = _kind;
+    out.text = String();
+  } else {
+    out.tag  = ValueKind::TEXT;
+    out.text = s;
+  }
+}
+
+const char* HAIoTBridge::format(const Value& v, char* buf) const {
+  switch (v.tag) {
+    case ValueKind::INTEGER: return formatScaled(v.num, 0, buf);
+    case ValueKind::FIXED:   return formatScaled(v.num, _decimals, buf);
+    case ValueKind::BOOLEAN: return v.num ? BOOL_TRUE[v.style] : BOOL_FALSE[v.style];
+    default:                 return v.text.c_str();
   }
-  return s;
 }
 
 // -----------------------------------------------------------------------------
@@ -291,43 +458,175 @@ String HAIoTBridge::normalize(uint8_t dec, const String& s) {
 // If the full name exceeds this length, the function keeps the last 14
 // characters and appends a checksum digit to avoid collisions.
 // -----------------------------------------------------------------------------
-String HAIoTBridge::shortenKey(const String& full) {
-  if (full.length() <= 15) return full;
+void HAIoTBridge::shortenKey(const char* full, char out[16]) {
+  size_t len = strlen(full);
+  if (len <= 15) {
+    memcpy(out, full, len + 1);
+    return;
+  }
 
   uint8_t sum = 0;
-  for (size_t i = 0; i < full.length(); ++i) sum += full[i];
+  for (size_t i = 0; i < len; ++i) sum += full[i];
 
-  String suffix = String(sum % 10);
-  return full.substring(full.length() - 14) + suffix;
+  memcpy(out, full + len - 14, 14);
+  out[14] = (char)('0' + sum % 10);
+  out[15] = '\0';
 }
 
 // -----------------------------------------------------------------------------
-// saveAndPublish
+// Publish shaping
 // -----------------------------------------------------------------------------
-// Persists the value to NVS for HA_CONTROL bridges (using the shortened key),
-// then publishes the value to MQTT via HestiaCore.
+// Deadband and rate limiting apply to local writes only: inbound commands and
+// HAInit republishing always go out so that HA reflects the actual state.
 // -----------------------------------------------------------------------------
-void HAIoTBridge::saveAndPublish(const String& val) {
-  if (_nvsKey.length() <= 15 && _type == TypeHA::HA_CONTROL) {
-    preferences.begin("Pref", false);
-    preferences.putString(_nvsKey.c_str(), val);
-    preferences.end();
+void HAIoTBridge::setupDeadband() {
+  const char* db = _cfg->deadband;
+
+  if (db && db[0] != '\0') {
+    size_t len = strlen(db);
+    bool numeric = (_kind == ValueKind::INTEGER || _kind == ValueKind::FIXED);
+    bool ok = false;
+
+    if (db[len - 1] == '%') {
+      char pct[FMT_BUF];
+      size_t n = (len - 1 < FMT_BUF - 1) ? len - 1 : FMT_BUF - 1;
+      memcpy(pct, db, n);
+      pct[n] = '\0';
+      ok = parseScaled(pct, 2, _deadband);   // hundredths of a percent
+      _deadbandPct = ok;
+    } else if (numeric) {
+      ok = parseScaled(db, _decimals, _deadband);
+    } else {
+      Serial.printf("[HAIoTBridge] %s: absolute deadband '%s' on a non-numeric entity ignored\n",
+                    name(), db);
+      return;
+    }
+
+    // "0" (or "0%") is a valid request: no deadband, every write is published
+    if (!ok) {
+      _deadband = 0;
+      Serial.printf("[HAIoTBridge] %s: invalid deadband '%s' ignored\n", name(), db);
+    }
+    if (_deadband < 0) _deadband = -_deadband;
+    return;
+  }
+
+  // Default: one resolution step — identical numeric values are not re-published
+  if (_kind == ValueKind::INTEGER || _kind == ValueKind::FIXED) {
+    _deadband = 1;
+  }
+}
+
+bool HAIoTBridge::withinDeadband() const {
+  if (_deadband == 0 || !_pubNumeric) return false;
+  if (_value.tag != ValueKind::INTEGER && _value.tag != ValueKind::FIXED) return false;
+
+  int64_t diff = (int64_t)_value.num - _pubNum;
+  if (diff < 0) diff = -diff;
+
+  if (_deadbandPct) {
+    int64_t ref = (_pubNum < 0) ? -(int64_t)_pubNum : _pubNum;
+    return diff * 10000 < ref * _deadband;
+  }
+  return diff < _deadband;
+}
+
+HAIoTBridge::PublishGate HAIoTBridge::publishGate(uint32_t now) const {
+  if (!_pubValid) return PublishGate::PUBLISH;
+  if (withinDeadband()) return PublishGate::SUPPRESS;
+
+  if (_cfg->minIntervalMs && (uint32_t)(now - _pubMs) < _cfg->minIntervalMs) {
+    return PublishGate::DEFER;
+  }
+  return PublishGate::PUBLISH;
+}
+
+bool HAIoTBridge::needsService() const {
+  return _cfg->minIntervalMs > 0 || _cfg->maxSilenceMs > 0;
+}
+
+void HAIoTBridge::servicePublish(uint32_t now) {
+  if (!_pubValid) return;
+
+  uint32_t silent = now - _pubMs;
+  char buf[FMT_BUF];
+
+  // 1) Deferred write whose interval has expired
+  if (_pubPending && silent >= _cfg->minIntervalMs) {
+    _pubPending = false;
+    if (!withinDeadband()) {
+      publish(format(_value, buf));
+      return;
+    }
   }
 
+  // 2) Forced refresh after maxSilenceMs without any publish
+  if (_cfg->maxSilenceMs && silent >= _cfg->maxSilenceMs && !_value.empty()) {
+    _forced++;
+    publish(format(_value, buf));
+  }
+}
+
+uint32_t HAIoTBridge::suppressedCount() const { 
+  return _suppressed; 
+}
+
+uint32_t HAIoTBridge::forcedCount() const { 
+  return _forced; 
+}
+
+// -----------------------------------------------------------------------------
+// saveAndPublish
+// -----------------------------------------------------------------------------
+// Queues HA_CONTROL bridges for persistence (write-behind, see HestiaPersist),
+// then publishes the value to MQTT via HestiaCore.
+// -----------------------------------------------------------------------------
+void HAIoTBridge::saveAndPublish(const char* val) {
+  queueSave();
   publish(val);
 }
 
+void HAIoTBridge::queueSave() {
+  if (_type != TypeHA::HA_CONTROL) return;
+
+  bool coalesced = _nvsDirty;
+  _nvsDirty = true;
+  HestiaPersist::requestSave(this, coalesced);
+}
+
+// -----------------------------------------------------------------------------
+// saveToNVS
+// -----------------------------------------------------------------------------
+// Writes the latest value under the shortened key. The session is owned by
+// the caller so that all pending bridges share one begin()/end().
+// -----------------------------------------------------------------------------
+bool HAIoTBridge::saveToNVS(Preferences& prefs) {
+  if (!_nvsDirty) return false;
+  _nvsDirty = false;
+
+  char buf[FMT_BUF];
+  prefs.putString(_nvsKey, format(_value, buf));
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // publish
 // -----------------------------------------------------------------------------
 // Publishes the value to the configured output MQTT topic.
 // Logging is optional and controlled by setLogWrites().
 // -----------------------------------------------------------------------------
-void HAIoTBridge::publish(const String& val) {
+void HAIoTBridge::publish(const char* val) {
+
+  // Shaping state tracks the last value handed to MQTT
+  _pubValid   = true;
+  _pubPending = false;
+  _pubMs      = millis();
+  _pubNumeric = (_value.tag == ValueKind::INTEGER || _value.tag == ValueKind::FIXED);
+  _pubNum     = _value.num;
 
-  if (_topicTo.length() == 0) return;
-    // Serial.printf("[HAIoTBridge::publish] %s -> %s\n", _topicTo.c_str(), val.c_str());
-    HestiaCore::publishToMQTT(_topicTo, val, _logWrites);
+  if (topicTo()[0] == '\0') return;
+    // Serial.printf("[HAIoTBridge::publish] %s -> %s\n", topicTo(), val);
+    HestiaCore::publishToMQTT(topicTo(), val, _logWrites);
   }
 
 
@@ -3,6 +3,7 @@
 #include <Preferences.h>
 #include <ArduinoJson.h>
 #include <Arduino.h>   // Required for uint8_t and String
+#include "HestiaFixed.h"   // Fixed-point text conversions (typed slots)
 
 // ============================================================================
 //  File   : HAIoTBridge.h
@@ -32,8 +33,39 @@ inline const char* typeHA_to_string(TypeHA type) {
   }
 }
 
+// ============================================================================
+// ValueKind — In-memory representation of an entity value
+// ----------------------------------------------------------------------------
+// Chosen once per entity from its BridgeConfig row:
+//   • resolution "1"            → INTEGER
+//   • resolution "0.1", "0.01"  → FIXED (int32 scaled by 10^decimals)
+//   • default ON/OFF, true/false → BOOLEAN
+//   • anything else, buttons    → TEXT (String, legacy behavior)
+// A value that does not parse as the entity kind is kept as TEXT, so no
+// payload is ever lost or altered by the typed path.
+// ============================================================================
+enum class ValueKind : uint8_t {
+  TEXT = 0,
+  INTEGER,
+  FIXED,
+  BOOLEAN
+};
+
 // ============================================================================
 // BridgeConfig — Static configuration describing an entity
+// ----------------------------------------------------------------------------
+// HAIoTBridge keeps a pointer to its BridgeConfig row instead of copying the
+// strings: the table must stay resident (static / constexpr) for the whole run.
+//
+// Publish shaping (optional trailing fields, local writes only):
+//   • deadband      : "0.5" (absolute) or "5%" (of the last published value).
+//                     Default for INTEGER / FIXED entities: one resolution step,
+//                     i.e. unchanged values are not re-published; "0" publishes
+//                     every write. An absolute deadband needs a numeric entity.
+//   • minIntervalMs : at most one publish per interval; the latest value is
+//                     published when the interval expires.
+//   • maxSilenceMs  : re-publish the current value if nothing was sent for
+//                     this long (forced refresh).
 // ============================================================================
 struct BridgeConfig {
   const char* name;         // Stable internal name
@@ -42,13 +74,16 @@ struct BridgeConfig {
   const char* topicFrom;    // MQTT command topic (HA → device)
   const char* resolution;   // Optional numeric resolution
   const char* defaultValue; // Default applied if no NVS entry exists
+  const char* deadband      = nullptr; // Optional publish deadband ("0.5", "5%")
+  uint32_t    minIntervalMs = 0;       // Optional minimum publish interval
+  uint32_t    maxSilenceMs  = 0;       // Optional forced refresh interval
 };
 
 // Forward declaration
 class HAIoTBridge;
 
 namespace HestiaCore {
-  void publishToMQTT(const String& topic, const String& payload);
+  void publishToMQTT(const char* topic, const char* payload, bool logIt);
 }
 
 // ============================================================================
@@ -57,10 +92,17 @@ namespace HestiaCore {
 // Represents a Home Assistant entity (sensor, switch, button, etc.).
 // Each instance corresponds to one entry in bridge_config[].
 //
+// Memory layout:
+//   • Static metadata (name, topics, resolution, default) is read through a
+//     pointer to the flash-resident BridgeConfig row — never copied to heap.
+//   • Only the mutable state lives in the object; HestiaCore places all
+//     instances in one contiguous arena allocated at startup.
+//
 // Responsibilities:
 //   • Local persistence of values through NVS
 //   • MQTT publish/subscribe handling
-//   • Normalization of numeric/string/boolean formats
+//   • Typed value storage (see ValueKind): numeric and boolean entities are
+//     held as integers and formatted only when published or read as String
 //   • Providing a stable unique identifier per entity
 // ============================================================================
 class HAIoTBridge {
@@ -72,7 +114,8 @@ public:
   /**
    * @brief Construct a bridge entity from a BridgeConfig descriptor.
    *
-   * @param cfg Configuration entry describing the entity.
+   * @param cfg Configuration entry describing the entity. Only its address is
+   *            retained: the entry must outlive the bridge.
    */
   HAIoTBridge(const BridgeConfig& cfg);
 
@@ -92,6 +135,19 @@ public:
    */
   void init();
 
+  /**
+   * @brief Same as init(), reading from a caller-owned session on "Pref".
+   *
+   * Used by HestiaCore::InitValueNVS() so that all entities are restored
+   * with a single begin()/end() pair.
+   */
+  void init(Preferences& prefs);
+
+  /**
+   * @brief NVS namespace holding HA_CONTROL values.
+   */
+  static constexpr const char* NVS_NAMESPACE = "Pref";
+
   // -------------------------------------------------------------------------
   // Local write (internal logic or sensor updates)
   // -------------------------------------------------------------------------
@@ -99,14 +155,14 @@ public:
    * @brief Write a new value coming from local logic (not MQTT).
    *
    * Value is normalized and:
-   *   • HA_CONTROL → persisted to NVS and published
+   *   • HA_CONTROL → queued for NVS (write-behind) and published
    *   • Other types → published only
    */
   void write(const String& v);
 
   void write(const char* v);     ///< Convenience overload
-  void write(float v);           ///< Convenience overload
-  void write(int v);             ///< Convenience overload
+  void write(float v);           ///< Stored without String for INTEGER / FIXED
+  void write(int v);             ///< Stored without String for INTEGER / FIXED
 
   /**
    * @brief Boolean overload.
@@ -114,6 +170,16 @@ public:
    */
   void write(bool v);
 
+  /**
+   * @brief Write a fixed-point value: @p raw is the value scaled by 10^@p dec.
+   *
+   * Rescaled with integer math to the entity precision; used by the typed
+   * handles (HestiaCore::FixedHandle) so no float or String parsing is needed.
+   * A value that does not fit int32 at the entity precision is stored as text,
+   * like write(float).
+   */
+  void writeScaled(int32_t raw, uint8_t dec);
+
   // -------------------------------------------------------------------------
   // Change detection
   // -------------------------------------------------------------------------
@@ -156,16 +222,23 @@ String read() const;
 
 /**
  * @brief Retrieve the current value as an integer.
- * @return Value converted using String::toInt().
+ * @return Stored integer (FIXED values are truncated), or String::toInt() for TEXT.
  */
 int readInt() const;
 
 /**
  * @brief Retrieve the current value as a float.
- * @return Value converted using String::toFloat().
+ * @return Stored value, or String::toFloat() for TEXT.
  */
 float readFloat() const;
 
+/**
+ * @brief Retrieve the current value scaled by 10^@p dec (fixed point).
+ * @return Rescaled integer, saturated at the int32 limits; 0 if the value
+ *         is not numeric.
+ */
+int32_t readScaled(uint8_t dec) const;
+
 /**
  * @brief Retrieve the current value as a boolean.
  *
@@ -211,21 +284,21 @@ bool isInitialized() const;
 
 /**
  * @brief Get the logical identifier of the entity.
- * @return Internal name reference.
+ * @return Internal name (points into the BridgeConfig table, never null).
  */
-const String& name() const;
+const char* name() const;
 
 /**
  * @brief Get the MQTT state-publish topic (device → Home Assistant).
- * @return Reference to the outbound topic.
+ * @return Outbound topic, "" if none (never null).
  */
-const String& topicTo() const;
+const char* topicTo() const;
 
 /**
  * @brief Get the MQTT command topic (Home Assistant → device).
- * @return Reference to the inbound topic.
+ * @return Inbound topic, "" if none (never null).
  */
-const String& topicFrom() const;
+const char* topicFrom() const;
 
 /**
  * @brief Get the entity's behavioral type within the HA bridge model.
@@ -239,35 +312,108 @@ TypeHA type() const;
  */
 uint8_t decimals() const;
 
+/**
+ * @brief Get the storage kind selected for this entity.
+ */
+ValueKind kind() const;
+
 /**
  * @brief Enable or disable logging for outgoing publish operations.
  * @param enable True → log writes ; False → silent mode.
  */
 void setLogWrites(bool enable);
 
+/**
+ * @brief Write the current value to an open Preferences session.
+ *
+ * Called by HestiaPersist when committing; no-op unless a save is pending.
+ *
+ * @return true if a key was written.
+ */
+bool saveToNVS(Preferences& prefs);
+
+// -------------------------------------------------------------------------
+// Publish shaping (deadband / rate limit / forced refresh)
+// -------------------------------------------------------------------------
+/**
+ * @brief True if the entity has a minimum interval or a maximum silence,
+ *        and therefore needs servicePublish() to be called periodically.
+ */
+bool needsService() const;
+
+/**
+ * @brief Publish a deferred value or a forced refresh when due.
+ *
+ * Called by HestiaCore::CoreComm() for entities where needsService() is true.
+ *
+ * @param now Current millis().
+ */
+void servicePublish(uint32_t now);
+
+/**
+ * @brief Number of local writes not published (deadband or rate limit).
+ */
+uint32_t suppressedCount() const;
+
+/**
+ * @brief Number of publishes forced by maxSilenceMs.
+ */
+uint32_t forcedCount() const;
+
+/**
+ * @brief Highest FIXED precision (int32 range ±2147.483647 at 6 decimals).
+ * Entities with a finer resolution are stored as TEXT.
+ */
+static constexpr uint8_t MAX_FIXED_DECIMALS = HestiaFixed::MAX_DECIMALS;
+
 
 private:
   // ========================================================================
   // Internal data
   // ========================================================================
-  String   _name;          // Logical entity name
+  const BridgeConfig* _cfg; // Static metadata (flash-resident table row)
   TypeHA   _type;          // Behavior model (CONTROL, INDICATOR, etc.)
-  String   _topicTo;       // MQTT → HA (state)
-  String   _topicFrom;     // MQTT ← HA (commands)
-  String   _resolution;    // Optional numeric resolution
-  String   _defaultValue;  // Default applied when no NVS entry exists
-  String   _deviceId;      // Reserved / not used in R2
-  String   _uniqueId;      // Reserved / not used in R2
-  String   _nvsKey;        // Compact NVS identifier (<=15 chars)
+  char     _nvsKey[16];    // Compact NVS identifier (<=15 chars + NUL)
 
   uint8_t  _decimals;      // Decimal precision derived from resolution
+  ValueKind _kind;         // Storage kind selected from the BridgeConfig row
+
+  // Spelling of a BOOLEAN value, kept so payloads round-trip unchanged
+  enum BoolStyle : uint8_t { BOOL_ON_OFF = 0, BOOL_on_off, BOOL_true_false, BOOL_TRUE_FALSE };
 
-  Preferences preferences; // NVS handler
+  // Tagged value: tag is _kind, or TEXT when the input did not parse
+  struct Value {
+    ValueKind tag   = ValueKind::TEXT;
+    uint8_t   style = BOOL_ON_OFF; // BOOLEAN spelling
+    int32_t   num   = 0;           // INTEGER, FIXED (×10^decimals), BOOLEAN (0/1)
+    String    text;                // TEXT only — "" means no value
 
-  String   _value;         // Current value
-  String   _valueMem;      // Last published / acknowledged value
+    bool empty() const { return tag == ValueKind::TEXT && text.isEmpty(); }
+    bool operator==(const Value& o) const {
+      if (tag != o.tag) return false;
+      return (tag == ValueKind::TEXT) ? (text == o.text) : (num == o.num);
+    }
+  };
+
+  // Formatting buffer: sign + 10 digits + point + NUL
+  static constexpr size_t FMT_BUF = HestiaFixed::FMT_BUF;
+
+  Value    _value;         // Current value
+  Value    _valueMem;      // Last published / acknowledged value
 
   bool     _initialized;   // Set once init() completes
+  bool     _nvsDirty = false; // Save queued in HestiaPersist, not yet committed
+
+  // Publish shaping state
+  int32_t  _deadband    = 0;     // Raw units, or hundredths of a percent
+  bool     _deadbandPct = false; // _deadband is relative to the last published value
+  bool     _pubValid    = false; // Something was published at least once
+  bool     _pubPending  = false; // Write deferred by minIntervalMs
+  bool     _pubNumeric  = false; // _pubNum holds the last published number
+  int32_t  _pubNum      = 0;     // Last published value (INTEGER / FIXED raw)
+  uint32_t _pubMs       = 0;     // millis() of the last publish
+  uint32_t _suppressed  = 0;     // Per-entity counters
+  uint32_t _forced      = 0;
   bool     _logWrites = true; // Enable/disable publish logging
 
 
@@ -282,25 +428,33 @@ private:
    *   "0.1"  → 1
    *   "0.01" → 2
    */
-  static uint8_t computeDecimals(const String& res);
+  static uint8_t computeDecimals(const char* res);
 
   /**
-   * @brief Determine whether a string represents a valid float.
-   *
-   * Rules:
-   *   • optional leading '-'
-   *   • at most one '.'
-   *   • must contain at least one digit
+   * @brief Select the storage kind from type, resolution and default value.
    */
-  static bool isFloatLike(const String& s);
+  static ValueKind selectKind(TypeHA type, const char* res, uint8_t dec, const char* def);
 
   /**
-   * @brief Normalize a value based on decimal precision.
-   *
-   * If the input is float-like, it is rendered using @p dec digits.
-   * Otherwise, the value is returned unchanged.
+   * @brief Recognize ON/OFF, on/off, true/false, TRUE/FALSE.
+   */
+  static bool parseBool(const char* s, bool& out, uint8_t& style);
+
+  /**
+   * @brief Parse @p s as the entity kind into @p out (TEXT on failure).
+   */
+  void parse(const char* s, Value& out) const;
+
+  /**
+   * @brief Render a value as its MQTT / NVS payload.
+   * @return Pointer into @p buf, or into the value's text.
    */
-  static String normalize(uint8_t dec, const String& s);
+  const char* format(const Value& v, char* buf) const;
+
+  /**
+   * @brief Apply a local write: mirror, then persist (CONTROL) and publish.
+   */
+  void commit();
 
   /**
    * @brief Produce a compact NVS-compliant key (≤15 characters).
@@ -310,21 +464,51 @@ private:
    *   • append a checksum digit (sum modulo 10).
    *
    * Guarantees stability while reducing collision probability.
+   *
+   * @param full Full entity name.
+   * @param out  Destination buffer (16 bytes, always NUL-terminated).
+   */
+  static void shortenKey(const char* full, char out[16]);
+
+  /**
+   * @brief Default value from the BridgeConfig row ("" when absent).
+   */
+  const char* defaultValue() const;
+
+  /**
+   * @brief Decision for a local write: publish now, defer (rate limit) or drop (deadband).
+   */
+  enum class PublishGate : uint8_t { PUBLISH, DEFER, SUPPRESS };
+  PublishGate publishGate(uint32_t now) const;
+
+  /**
+   * @brief True if the current value is within the deadband of the last publish.
+   */
+  bool withinDeadband() const;
+
+  /**
+   * @brief Parse the BridgeConfig deadband (or derive it from the resolution).
+   */
+  void setupDeadband();
+
+  /**
+   * @brief Mark the entity dirty in HestiaPersist (HA_CONTROL only).
    */
-  static String shortenKey(const String& full);
+  void queueSave();
 
   /**
-   * @brief Persist the value to NVS (if applicable) and publish it to MQTT.
+   * @brief Queue the value for persistence (if applicable) and publish it to MQTT.
    *
-   * HA_CONTROL entities store the value before publishing.
+   * HA_CONTROL entities are marked dirty in HestiaPersist; the flash write
+   * happens later, coalesced with other pending changes.
    */
-  void saveAndPublish(const String& val);
+  void saveAndPublish(const char* val);
 
   /**
    * @brief Publish the value to MQTT using the configured state topic.
    *
    * No action is taken if the entity has no outbound topic.
    */
-  void publish(const String& val);
+  void publish(const char* val);
 };
 // ============================================================================
\ No newline at end of file
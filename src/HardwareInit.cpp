@@ -107,4 +107,13 @@ namespace HardwareInit {
     esp_task_wdt_reset();
   }
 
+  /*****************************************************************************************
+   *  wdtReady()
+   *  -----------
+   *  True once InitHardwareWatchdog() has configured the task watchdog.
+   *****************************************************************************************/
+  bool wdtReady() {
+    return watchdogInitialized;
+  }
+
 } // namespace HardwareInit
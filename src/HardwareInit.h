@@ -59,8 +59,6 @@ namespace HardwareInit {
    * @brief Query whether the watchdog subsystem is active.
    *
    * @return true if the watchdog was initialized and is ready to be used.
-   *
-   * @note Implemented in HardwareInit.cpp if required.
    */
   bool wdtReady();
 
@@ -3,6 +3,7 @@
 #include <ArduinoJson.h>
 #include <Preferences.h>
 #include "HestiaTempo.h"
+#include "HestiaPersist.h"   // flush pending NVS writes before rebooting
 using Tempo::literals::operator"" _id;
 
 namespace {
@@ -29,6 +30,29 @@ namespace {
   const char* NVS_KEY_LAST_FW_ID = "last_fw_id";
   Preferences prefs;
 
+  // ============================================================================
+  //  Key index — open addressing (linear probing) over _params positions,
+  //  keyed by FNV-1a(key). Rebuilt by loadDeviceParams().
+  // ============================================================================
+  constexpr uint16_t KEY_SLOT_EMPTY = 0xFFFF;
+  std::vector<uint16_t> g_keySlots;
+  std::vector<uint32_t> g_keyHashes;      // FNV-1a of _params[i]->key
+  uint32_t g_keyMask      = 0;
+  uint32_t g_tableVersion = 0;
+  std::vector<uint32_t> g_missReported;   // Hashes of keys already reported missing
+
+  // ============================================================================
+  //  Parameter storage
+  //    • g_paramStore : one HestiaParam per descriptor, contiguous (_params
+  //                     points into it)
+  //    • g_jsonDescs  : descriptors built from a runtime JSON schema, with
+  //                     their strings in g_jsonStrings (generated flash tables
+  //                     need neither)
+  // ============================================================================
+  std::vector<HestiaParam> g_paramStore;
+  std::vector<HestiaConfig::ParamDescriptor> g_jsonDescs;
+  std::vector<char*> g_jsonStrings;
+
   // ============================================================================
   //  Helpers — string → ParamType / PatternType
   // ============================================================================
@@ -39,6 +63,7 @@ namespace {
     if (strcmp(s, "int")    == 0) return HestiaConfig::ParamType::INT;
     if (strcmp(s, "bool")   == 0) return HestiaConfig::ParamType::BOOL;
     if (strcmp(s, "float")  == 0) return HestiaConfig::ParamType::FLOAT;
+    if (strcmp(s, "number") == 0) return HestiaConfig::ParamType::NUMBER;
     return HestiaConfig::ParamType::STRING;
   }
 
@@ -48,6 +73,7 @@ namespace {
     if (strcmp(s, "hostname") == 0) return HestiaConfig::PatternType::HOSTNAME;
     if (strcmp(s, "url")      == 0) return HestiaConfig::PatternType::URL;
     if (strcmp(s, "email")    == 0) return HestiaConfig::PatternType::EMAIL;
+    if (strcmp(s, "bool")     == 0) return HestiaConfig::PatternType::BOOL;
     if (strcmp(s, "anything") == 0) return HestiaConfig::PatternType::ANYTHING;
     return HestiaConfig::PatternType::ANYTHING;
   }
@@ -58,6 +84,7 @@ namespace {
       case HestiaConfig::PatternType::HOSTNAME:  return F("hostname");
       case HestiaConfig::PatternType::URL:       return F("url");
       case HestiaConfig::PatternType::EMAIL:     return F("email");
+      case HestiaConfig::PatternType::BOOL:      return F("bool");
       case HestiaConfig::PatternType::ANYTHING:
       default:                                   return F("anything");
     }
@@ -69,6 +96,7 @@ namespace {
       case HestiaConfig::ParamType::INT:    return F("int");
       case HestiaConfig::ParamType::BOOL:   return F("bool");
       case HestiaConfig::ParamType::FLOAT:  return F("float");
+      case HestiaConfig::ParamType::NUMBER: return F("number");
       default:                              return F("string");
     }
   }
@@ -83,6 +111,82 @@ namespace HestiaConfig {
   std::vector<HestiaParam*> _params;
 
 
+  // ============================================================================
+  //  buildKeyIndex — hash index over _params
+  // ============================================================================
+  //
+  //  Table size is the next power of two ≥ 2× the parameter count (load ≤ 0.5).
+  //  Two keys with the same 32-bit hash would make ParamId lookups ambiguous;
+  //  this is reported at build time (rename one of the keys).
+  // ============================================================================
+  static void buildKeyIndex() {
+      size_t slots = 16;
+      while (slots < _params.size() * 2) slots <<= 1;
+
+      g_keySlots.assign(slots, KEY_SLOT_EMPTY);
+      g_keyHashes.resize(_params.size());
+      g_keyMask = (uint32_t)(slots - 1);
+      g_missReported.clear();
+
+      for (size_t i = 0; i < _params.size(); ++i) {
+          uint32_t h = HestiaHash::fnv1a(_params[i]->key());
+          g_keyHashes[i] = h;
+
+          uint32_t pos = h & g_keyMask;
+          bool skip = false;
+          while (g_keySlots[pos] != KEY_SLOT_EMPTY) {
+              uint16_t other = g_keySlots[pos];
+              if (g_keyHashes[other] == h) {
+                  Serial.printf("[HestiaConfig][ERROR] Key '%s' %s '%s', ignored in index.\n",
+                                _params[i]->key(),
+                                strcmp(_params[other]->key(), _params[i]->key()) == 0
+                                    ? "duplicates" : "hash-collides with",
+                                _params[other]->key());
+                  skip = true;
+                  break;
+              }
+              pos = (pos + 1) & g_keyMask;
+          }
+          if (!skip) g_keySlots[pos] = (uint16_t)i;
+      }
+
+      g_tableVersion++;
+  }
+
+  // Position of the parameter with hash @p h (and key @p key when given), or -1
+  static int findIndex(uint32_t h, const char* key) {
+      if (g_keySlots.empty()) return -1;
+
+      uint32_t pos = h & g_keyMask;
+      while (g_keySlots[pos] != KEY_SLOT_EMPTY) {
+          uint16_t i = g_keySlots[pos];
+          if (g_keyHashes[i] == h && (!key || strcmp(_params[i]->key(), key) == 0)) return i;
+          pos = (pos + 1) & g_keyMask;
+      }
+      return -1;
+  }
+
+  static HestiaParam* findParamByKey(const String& key) {
+      int i = findIndex(HestiaHash::fnv1a(key.c_str()), key.c_str());
+      return i < 0 ? nullptr : _params[i];
+  }
+
+  // Report a missing key once per table (hot paths would otherwise flood Serial)
+  static void reportMiss(uint32_t h, const char* key) {
+      for (uint32_t m : g_missReported) {
+          if (m == h) return;
+      }
+      g_missReported.push_back(h);
+
+      if (key) {
+          Serial.printf("[HestiaConfig][ERROR] Param '%s' not found. Using NULL param.\n", key);
+      } else {
+          Serial.printf("[HestiaConfig][ERROR] Param id 0x%08lx not found. Using NULL param.\n",
+                        (unsigned long)h);
+      }
+  }
+
+
   // ============================================================================
   //  ForceProvisioning — check whether provisioning must be forced
   // ============================================================================
@@ -176,7 +280,7 @@ namespace HestiaConfig {
             Serial.println(F("[HestiaConfig] Button released, restarting..."));
             holdValidated = false;
             delay(100);
-            ESP.restart();
+            HestiaPersist::restart();
         }
         return;
     }
@@ -185,16 +289,112 @@ namespace HestiaConfig {
 
 
   // ============================================================================
+//  releaseParams — Destroy the current parameter table
+// ============================================================================
+//
+//  Parameters first (they point at their descriptors), then the descriptors
+//  and strings owned by a previous JSON load.
+// ============================================================================
+static void releaseParams()
+{
+    _params.clear();
+    g_paramStore.clear();
+
+    g_jsonDescs.clear();
+    for (char* str : g_jsonStrings) free(str);
+    g_jsonStrings.clear();
+}
+
+// Copy a schema string into storage owned by the JSON descriptors
+static const char* keepString(const char* str)
+{
+    char* copy = strdup(str ? str : "");
+    g_jsonStrings.push_back(copy);
+    return copy;
+}
+
+
+
+// ============================================================================
+//  instantiateParams — One HestiaParam per descriptor + bulk NVS restore
+// ============================================================================
+static bool instantiateParams(const ParamDescriptor* descs, size_t count, const char* source)
+{
+    Serial.println(F("[HestiaConfig] Instantiating parameters..."));
+
+    uint32_t t0 = micros();
+
+    // Reserve up front: _params points into g_paramStore
+    g_paramStore.reserve(count);
+    _params.reserve(count);
+
+    // One NVS session for the whole table (bulk restore)
+    Preferences prefs;
+    prefs.begin(HestiaParam::NVS_NAMESPACE, false);
+
+    for (size_t i = 0; i < count; ++i) {
+        g_paramStore.emplace_back(&descs[i]);
+        HestiaParam* p = &g_paramStore.back();
+
+        // Allow provisioning parameters (if any) to load their stored value
+        p->loadFromNVS(prefs, true);   // lazy-init enabled
+
+        _params.push_back(p);
+
+        Serial.printf("  %s → %s : %s\n",
+                      p->provisioning() ? "NVS" : source,
+                      p->key(),
+                      p->c_str());
+    }
+
+    prefs.end();
+
+    // New parameter objects: rebuild the key index, invalidate cached views
+    buildKeyIndex();
+    HestiaParam::bumpGeneration();
+
+    Serial.printf("[HestiaConfig] %u device parameters loaded in %lu us.\n",
+                  (unsigned)_params.size(),
+                  (unsigned long)(micros() - t0));
+    Serial.println(F("[HestiaConfig] === End loadDeviceParams ===\n"));
+
+    return true;
+}
+
+
+
+// ============================================================================
+//  loadDeviceParams — Load device-level parameters from a flash table.
+// ============================================================================
+//
+//  Preferred path: the table is generated from DeviceParams.h at build time
+//  (tools/gen_device_params.py). No JSON document, no metadata copies — the
+//  descriptors stay in flash, only values live in RAM.
+// ============================================================================
+bool loadDeviceParams(const ParamDescriptor* table, size_t count)
+{
+    Serial.println(F("[HestiaConfig] === Start loadDeviceParams (table) ===\n"));
+
+    if (!table || count == 0) {
+        Serial.println(F("[HestiaConfig] ERROR: DeviceParams table is empty."));
+        Serial.println(F("[HestiaConfig] === End loadDeviceParams (ABORT) ==="));
+        return false;
+    }
+
+    releaseParams();
+    return instantiateParams(table, count, "flash");
+}
+
+
+
+// ============================================================================
 //  loadDeviceParams — Load device-level parameters from JSON definition.
-// ---------------------------------------------------------------------------
-//  This function parses the static JSON schema embedded in DeviceParams.h,
-//  instantiates one HestiaParam object per entry, and populates the internal
-//  registry (_params). All previously allocated parameters are destroyed.
+// ============================================================================
 //
-//  Notes:
-//    • This stage handles ONLY firmware-level parameters ("provisioning": false).
-//    • User-facing provisioning parameters are still handled by the legacy
-//      ParamInstance / ParamMeta mechanism until full migration is completed.
+//  Legacy path: parses the JSON schema embedded in DeviceParams.h and converts
+//  each entry into a ParamDescriptor owned by HestiaConfig. The JSON document
+//  is sized from the input (no fixed 8 KB limit) and released before return.
+//  All previously allocated parameters are destroyed.
 // ============================================================================
 bool loadDeviceParams(const char* json)
 {
@@ -212,7 +412,8 @@ bool loadDeviceParams(const char* json)
     // ----------------------------------------------------------------------
     // 2) Parse JSON document
     // ----------------------------------------------------------------------
-    DynamicJsonDocument doc(8192);
+    size_t len = strlen_P(json);
+    DynamicJsonDocument doc((len * 2) + 1024);
     DeserializationError err = deserializeJson(doc, json);
     if (err) {
         Serial.printf("[HestiaConfig] ERROR: JSON parse failure: %s\n", err.c_str());
@@ -230,38 +431,64 @@ bool loadDeviceParams(const char* json)
     // ----------------------------------------------------------------------
     // 3) Clear previous parameters
     // ----------------------------------------------------------------------
-    for (auto* p : _params) {
-        delete p;
-    }
-    _params.clear();
-
-    Serial.println(F("[HestiaConfig] Instantiating parameters..."));
+    releaseParams();
 
     // ----------------------------------------------------------------------
-    // 4) Instantiate each HestiaParam object
+    // 4) JSON entries → descriptors (same semantics as the generator)
     // ----------------------------------------------------------------------
-    for (JsonObject obj : arr) {
-        HestiaParam* p = new HestiaParam(obj);
+    g_jsonDescs.reserve(arr.size());
 
-        // Allow provisioning parameters (if any) to load their stored value
-        p->loadFromNVS(true);   // lazy-init enabled
+    for (JsonObject obj : arr) {
+        ParamDescriptor d = {};
+        const char* key = obj["key"] | "";
+
+        d.key          = keepString(key);
+        d.label        = keepString(obj["label"] | key);
+        d.defaultValue = keepString(obj["default"] | "");
+        d.type         = parseParamType(obj["type"] | "string");
+        d.pattern      = parsePatternType(obj["pattern"] | "anything");
+        d.decimals     = obj["decimals"] | 0;
+        d.minLen       = -1;
+        d.maxLen       = -1;
+
+        if (obj["provisioning"] | false) d.flags |= PF_PROVISIONING;
+        if (obj["required"]     | false) d.flags |= PF_REQUIRED;
+        if (obj["critical"]     | false) d.flags |= PF_CRITICAL;
+
+        // Optional validation rules
+        if (obj.containsKey("validate")) {
+            JsonObject v = obj["validate"];
+
+            if (v.containsKey("minLen")) d.minLen = v["minLen"].as<int16_t>();
+            if (v.containsKey("maxLen")) d.maxLen = v["maxLen"].as<int16_t>();
+
+            if (v.containsKey("min")) {
+                d.min    = v["min"].as<double>();
+                d.flags |= PF_HAS_MIN;
+            }
+            if (v.containsKey("max")) {
+                d.max    = v["max"].as<double>();
+                d.flags |= PF_HAS_MAX;
+            }
+        }
 
-        _params.push_back(p);
+        // Optional value list, stored '|'-separated
+        if (obj.containsKey("options")) {
+            String opts;
+            for (JsonVariant ov : obj["options"].as<JsonArray>()) {
+                if (opts.length()) opts += '|';
+                opts += ov.as<const char*>();
+            }
+            d.options = keepString(opts.c_str());
+        }
 
-        Serial.printf("  %s → %s : %s\n",
-                      p->provisioning ? "NVS" : "json",
-                      p->key.c_str(),
-                      p->read().c_str());
+        g_jsonDescs.push_back(d);
     }
 
     // ----------------------------------------------------------------------
-    // 5) Final summary
+    // 5) Instantiate + NVS restore + summary
     // ----------------------------------------------------------------------
-    Serial.printf("[HestiaConfig] %u device parameters loaded.\n",
-                  (unsigned)_params.size());
-    Serial.println(F("[HestiaConfig] === End loadDeviceParams ===\n"));
-
-    return true;
+    return instantiateParams(g_jsonDescs.data(), g_jsonDescs.size(), "json");
 }
 
 
@@ -271,11 +498,26 @@ bool loadDeviceParams(const char* json)
 // ============================================================================
 String getParam(const String& key)
 {
-    for (auto* p : _params) {
-        if (p->key == key)
-            return p->read();
-    }
-    return "";
+    HestiaParam* p = findParamByKey(key);
+    return p ? p->read() : String();
+}
+
+
+
+// ============================================================================
+//  getParamRef / getParamCStr — Zero-copy value access
+// ============================================================================
+const String& getParamRef(const String& key)
+{
+    static const String empty;
+    HestiaParam* p = findParamByKey(key);
+    return p ? p->value() : empty;
+}
+
+const char* getParamCStr(const String& key)
+{
+    HestiaParam* p = findParamByKey(key);
+    return p ? p->c_str() : "";
 }
 
 
@@ -285,12 +527,8 @@ String getParam(const String& key)
 // ============================================================================
 bool setParam(const String& key, const String& value)
 {
-    for (auto* p : _params) {
-        if (p->key == key) {
-            return p->write(value);
-        }
-    }
-    return false;
+    HestiaParam* p = findParamByKey(key);
+    return p ? p->write(value) : false;
 }
 
 
@@ -300,17 +538,100 @@ bool setParam(const String& key, const String& value)
 // ============================================================================
 HestiaParam* getParamObj(const String& key)
 {
-    for (auto* p : _params) {
-        if (p->key == key)
-            return p;
-    }
+    uint32_t h = HestiaHash::fnv1a(key.c_str());
+    int i = findIndex(h, key.c_str());
+    if (i >= 0) return _params[i];
 
-    Serial.printf("[HestiaConfig][ERROR] Param '%s' not found. Using NULL param.\n",
-                  key.c_str());
+    reportMiss(h, key.c_str());
+    return nullptr;
+}
 
+// ID lookup: a hit is confirmed on the full 32-bit hash (collisions are
+// rejected when the index is built).
+HestiaParam* getParamObj(ParamId id)
+{
+    int i = findIndex(id, nullptr);
+    if (i >= 0) return _params[i];
+
+    reportMiss(id, nullptr);
     return nullptr;
 }
 
+uint32_t tableVersion()
+{
+    return g_tableVersion;
+}
+
+
+
+// ============================================================================
+//  generation — Configuration change counter
+// ============================================================================
+uint32_t generation()
+{
+    return HestiaParam::generation();
+}
+
+
+
+// ============================================================================
+//  Typed snapshots — rebuilt only after a generation change
+// ============================================================================
+namespace {
+    // Silent lookup: optional parameters must not trigger getParamObj() errors
+    HestiaParam* findParam(const char* key) {
+        int i = findIndex(HestiaHash::fnv1a(key), key);
+        return i < 0 ? nullptr : _params[i];
+    }
+
+    String valueOf(const char* key) {
+        HestiaParam* p = findParam(key);
+        return p ? p->read() : String();
+    }
+
+    NetSnapshot  g_netSnap;
+    MqttSnapshot g_mqttSnap;
+    bool         g_netSnapValid  = false;
+    bool         g_mqttSnapValid = false;
+}
+
+const NetSnapshot& netSnapshot()
+{
+    uint32_t gen = generation();
+    if (g_netSnapValid && g_netSnap.generation == gen) return g_netSnap;
+
+    g_netSnap.ssid       = valueOf("wifi_ssid");
+    g_netSnap.pass       = valueOf("wifi_pass");
+    g_netSnap.deviceId   = valueOf("device_id");
+    g_netSnap.generation = gen;
+    g_netSnapValid       = true;
+    return g_netSnap;
+}
+
+const MqttSnapshot& mqttSnapshot()
+{
+    uint32_t gen = generation();
+    if (g_mqttSnapValid && g_mqttSnap.generation == gen) return g_mqttSnap;
+
+    g_mqttSnap.host     = valueOf("mqtt_ip");
+    g_mqttSnap.clientId = valueOf("device_id");
+    g_mqttSnap.user     = valueOf("mqtt_user");
+    g_mqttSnap.pass     = valueOf("mqtt_pass");
+
+    HestiaParam* port = findParam("mqtt_port");
+    g_mqttSnap.port = port ? (uint16_t)port->readInt() : 1883;
+
+    HestiaParam* budget = findParam("mqtt_budget_ms");
+    g_mqttSnap.budgetMs = budget ? (uint32_t)budget->readInt() : 0;
+
+    HestiaParam* rxBuf = findParam("mqtt_rx_buffer");
+    g_mqttSnap.rxBuffer = rxBuf ? (uint32_t)rxBuf->readInt() : 0;
+
+    g_mqttSnap.generation = gen;
+    g_mqttSnapValid       = true;
+    return g_mqttSnap;
+}
+
 
 
 // ============================================================================
@@ -331,9 +652,9 @@ bool validateR2()
     for (HestiaParam* p : _params) {
         if (!p) continue;
 
-        if (p->critical && !p->validateValue()) {
+        if (p->critical() && !p->validateValue()) {
             Serial.printf("[HestiaConfig] R2 validation failed: %s → %s\n",
-                          p->key.c_str(), p->read().c_str());
+                          p->key(), p->c_str());
             return false;
         }
     }
@@ -396,8 +717,8 @@ void applyUpdateInitializationPolicy()
         Serial.println(F("[HestiaConfig] init_on_update=true: resetting provisioning params to defaults."));
 
         for (HestiaParam* p : _params) {
-            if (!p || !p->provisioning) continue;
-            p->write(p->defaultValue);
+            if (!p || !p->provisioning()) continue;
+            p->write(p->defaultValue());
             p->saveToNVS();
         }
 
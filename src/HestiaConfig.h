@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <vector>
 #include "HestiaParam.h"
+#include "HestiaHash.h"
 
 /*****************************************************************************************
  *  File     : HestiaConfig.h
@@ -18,11 +19,14 @@
  *  Section 3 responsibilities:
  *    • Declare the generic NVS load/save API.
  *
+ *  Typed snapshots (NetSnapshot, MqttSnapshot) give hot paths a cached,
+ *  generation-checked view of the parameters they need.
+ *
  *  Future sections (4..6) will introduce:
  *    • config.h fallback rules
  *    • validation logic
  *    • loadBAD() provisioning decision
- *    • typed getters (WiFi, MQTT, Timezone, LED, OTA, etc.)
+ *    • typed getters (Timezone, LED, OTA, etc.)
  *
  *****************************************************************************************/
 
@@ -36,31 +40,112 @@ namespace HestiaConfig {
 
   // Core API
   bool   loadDeviceParams(const char* json);
+
+  /**
+   * @brief Load parameters from a generated flash table (tools/gen_device_params.py).
+   *
+   * No JSON parsing: each HestiaParam points at its descriptor and only the
+   * value is allocated. @p table must stay valid for the whole run.
+   */
+  bool   loadDeviceParams(const ParamDescriptor* table, size_t count);
   String getParam(const String& key);
   bool   setParam(const String& key, const String& value);
   HestiaParam* getParamObj(const String& key);
 
+  // ============================================================================
+  //  Key Index & Parameter IDs
+  // ----------------------------------------------------------------------------
+  //  loadDeviceParams() builds a hash index over _params (FNV-1a of the key), so
+  //  every key lookup is O(1). A ParamId is that hash computed at compile time:
+  //
+  //      using HestiaConfig::literals::operator"" _pid;
+  //      HestiaParam* p = HestiaConfig::param<"iot_alive_ms"_pid>();
+  //
+  //  param<ID>() caches the resolved pointer per call site and re-resolves only
+  //  after the parameter table is reloaded. A missing key is reported once.
+  // ============================================================================
+  using ParamId = uint32_t;
+
+  namespace literals {
+    constexpr ParamId operator"" _pid(const char* s, size_t n) {
+      return HestiaHash::fnv1aSpan(s, n);
+    }
+  }
+
+  constexpr ParamId paramId(const char* key) { return HestiaHash::fnv1a(key); }
+
+  HestiaParam* getParamObj(ParamId id);
+
+  /**
+   * @brief Incremented each time loadDeviceParams() rebuilds the parameter table
+   *        (HestiaParam pointers from an older table are invalid).
+   */
+  uint32_t tableVersion();
+
+  template <ParamId ID>
+  HestiaParam* param() {
+    static HestiaParam* cached  = nullptr;
+    static uint32_t     version = 0;
+    uint32_t v = tableVersion();
+    if (version != v) {
+      cached  = getParamObj(ID);
+      version = v;
+    }
+    return cached;
+  }
+
+  // Zero-copy value access; empty string when the key does not exist
+  const String& getParamRef(const String& key);
+  const char*   getParamCStr(const String& key);
+
+  /**
+   * @brief Configuration change generation.
+   *
+   * Incremented whenever a parameter value changes (setParam(), HestiaParam::write(),
+   * NVS restore) and when the parameter table is reloaded. Hot-path consumers keep
+   * a cached view and rebuild it only when this number differs from the one they
+   * cached.
+   */
+  uint32_t generation();
+
 
 
   // ============================================================================
-  //  Enums — Parameter types and validation patterns
+  //  Typed Snapshots — immutable views for hot-path consumers
+  // ----------------------------------------------------------------------------
+  //  Built from the parameter table on first access and rebuilt only after a
+  //  generation change. Each accessor returns a const reference valid until the
+  //  next rebuild; copy a field if it must outlive a configuration change.
+  //
+  //  Ownership: the network snapshots are read by the Wi-Fi / MQTT guards, i.e.
+  //  from a single task (loop() or the network task).
   // ============================================================================
 
-  enum class ParamType {
-    STRING,
-    INT,
-    BOOL,
-    FLOAT
+  struct NetSnapshot {
+    String   ssid;
+    String   pass;
+    String   deviceId;        ///< Raw device_id (hostname is derived by HestiaNet)
+    uint32_t generation = 0;
   };
 
-  enum class PatternType {
-    ANYTHING,
-    IP,
-    HOSTNAME,
-    URL,
-    EMAIL
+  struct MqttSnapshot {
+    String   host;
+    uint16_t port      = 1883;
+    String   clientId;        ///< device_id
+    String   user;
+    String   pass;
+    uint32_t budgetMs  = 0;   ///< "mqtt_budget_ms", 0 if the device does not define it
+    uint32_t rxBuffer  = 0;   ///< "mqtt_rx_buffer" (bytes), 0 if the device does not define it
+    uint32_t generation = 0;
   };
 
+  const NetSnapshot&  netSnapshot();
+  const MqttSnapshot& mqttSnapshot();
+
+
+
+  // ParamType / PatternType are defined in HestiaParamSchema.h
+
 
 
   // ============================================================================
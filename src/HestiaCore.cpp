@@ -1,6 +1,12 @@
 #include <Arduino.h>
+#include <new>
+#include <atomic>
 #include "HestiaCore.h"
+#include "HestiaQueue.h"
 #include "HestiaProvisioning.h"
+#include "HestiaHash.h"
+#include "HestiaTopicIndex.h"
+#include "HestiaPersist.h"
 #include "HestiaTempo.h"
 using Tempo::literals::operator"" _id;
 
@@ -10,12 +16,31 @@ using Tempo::literals::operator"" _id;
 namespace {
     const BridgeConfig* g_bridgeTable = nullptr;
     size_t g_bridgeCount = 0;
+
+    // Backing storage for every HAIoTBridge: one allocation, entities are
+    // constructed in place and never freed (the registry lives until reboot).
+    HAIoTBridge* g_bridgeArena = nullptr;
+
+    // Bridges with minIntervalMs / maxSilenceMs, serviced by CoreComm()
+    std::vector<HAIoTBridge*> g_shapedBridges;
+
+    // Inbound topic index: open addressing (linear probing) over BridgeRegistry
+    // positions, keyed by topicFrom. Built once by RegisterEntitiesIotBridge(),
+    // unless a generated perfect-hash table (setTopicIndex) checks out.
+    constexpr uint16_t TOPIC_SLOT_EMPTY = HestiaTopicIndex::SLOT_EMPTY;
+    std::vector<uint16_t> g_topicSlots;
+    const uint16_t* g_topicTable = nullptr;   // g_topicSlots.data() or generated table
+    uint32_t g_topicMask = 0;
+    uint32_t g_topicSeed = HestiaHash::FNV_OFFSET;
+    const HestiaCore::TopicIndex* g_generatedIndex = nullptr;
 }
 
 namespace HestiaCore {
 
     static bool timerFlushSet = false;
 
+    static void buildTopicIndex();
+
 
     /*****************************************************************************************
      *  Function : loadBridgeConfig
@@ -43,6 +68,10 @@ namespace HestiaCore {
         Serial.println(F("=== BridgeConfig table loaded ===\n"));
     }
 
+    void setTopicIndex(const TopicIndex* index) {
+        g_generatedIndex = index;
+    }
+
 
     // =====================================================================================
     //  Active Bridge Registry
@@ -66,6 +95,20 @@ namespace HestiaCore {
 
 
 
+    // =====================================================================================
+    //  logHeapUse() — Boot-time heap report for the bridge registry
+    // =====================================================================================
+    static void logHeapUse(const char* stage, uint32_t heapBefore) {
+        uint32_t heapAfter = ESP.getFreeHeap();
+        uint32_t used      = (heapBefore > heapAfter) ? heapBefore - heapAfter : 0;
+        size_t   count     = BridgeRegistry.size();
+        Serial.printf("[HestiaCore] Heap (%s): %u → %u bytes, %u used, %u bytes/entity (object %u)\n",
+                      stage, heapBefore, heapAfter, used,
+                      (unsigned)(count ? used / count : 0),
+                      (unsigned)sizeof(HAIoTBridge));
+    }
+
+
     // =====================================================================================
     //  logSummary() — Diagnostic summary of all registered entities
     // =====================================================================================
@@ -73,12 +116,12 @@ namespace HestiaCore {
         Serial.println(F("\n=== [HestiaCore::logSummary | BridgeRegistry] Entity Summary ==="));
         for (auto* b : BridgeRegistry) {
             Serial.printf(" %-30s | Type: %-11s | TopicTo: %-25s\n",
-                          b->name().c_str(),
+                          b->name(),
                           (b->type() == TypeHA::HA_CONTROL   ? "CONTROL" :
                            b->type() == TypeHA::HA_INDICATOR ? "INDICATOR" :
                            b->type() == TypeHA::HA_BUTTON    ? "BUTTON" :
                            b->type() == TypeHA::HA_ENTITIES  ? "ENTITIES" : "?"),
-                          b->topicTo().c_str());
+                          b->topicTo());
         }
         Serial.println(F("=== [BridgeRegistry] End of Summary ===\n"));
     }
@@ -91,16 +134,27 @@ namespace HestiaCore {
      * @brief Restore all HAIoTBridge-controlled values from NVS.
      *
      * Behavior:
-     *   • Iterates through the registry and invokes each entity's init() method.
+     *   • Opens the "Pref" namespace once, read-only, for the whole registry.
      *   • Each entity decides whether to restore from NVS or use default metadata.
      */
     bool InitValueNVS() {
         Serial.println(F("\n=== [HestiaCore::InitValueNVS] Restoring local NVS values ==="));
+        uint32_t heapBefore = ESP.getFreeHeap();
+        uint32_t t0 = micros();
 
+        // One read-only session for every entity (bulk restore)
+        Preferences prefs;
+        prefs.begin(HAIoTBridge::NVS_NAMESPACE, true);
         for (auto* bridge : BridgeRegistry) {
             if (!bridge) continue;
-            bridge->init();
+            bridge->init(prefs);
         }
+        prefs.end();
+
+        Serial.printf("[HestiaCore] %u entities restored in %lu us\n",
+                      (unsigned)BridgeRegistry.size(),
+                      (unsigned long)(micros() - t0));
+        logHeapUse("values restored", heapBefore);
 
         Serial.println(F("=== [HestiaCore::InitValueNVS] Local initialization complete ===\n"));
         return true;
@@ -151,6 +205,12 @@ namespace HestiaCore {
      *  Constraints:
      *    • Behavior is identical to R1/R0 unless loadBridgeConfig() is used.
      *    • Future architectures will rely on this injection mechanism by default.
+     *
+     *  Memory:
+     *    • Entities are placement-constructed in a single arena (one malloc,
+     *      no per-entity heap blocks) and reference the table for metadata, so
+     *      the injected table must remain resident for the whole run.
+     *    • Heap usage is reported after construction and after NVS restore.
      *****************************************************************************************/
     void RegisterEntitiesIotBridge() {
         Serial.println(F("\n=== [HestiaCore | BridgeRegistry] Creating entities ==="));
@@ -161,29 +221,192 @@ namespace HestiaCore {
             return;
         }
 
-        // Instantiate all configured entities
+        // Registry is built once: entities live for the whole run
+        if (!BridgeRegistry.empty()) {
+            Serial.println(F("[HestiaCore] WARNING: Registry already built, ignoring."));
+            return;
+        }
+
+        uint32_t heapBefore = ESP.getFreeHeap();
+
+        // One contiguous arena for all entities, then construct in place
+        g_bridgeArena = static_cast<HAIoTBridge*>(malloc(sizeof(HAIoTBridge) * g_bridgeCount));
+        if (!g_bridgeArena) {
+            Serial.printf("[HestiaCore] FATAL: Cannot allocate bridge arena (%u bytes).\n",
+                          (unsigned)(sizeof(HAIoTBridge) * g_bridgeCount));
+            return;
+        }
+        BridgeRegistry.reserve(g_bridgeCount);
+
         for (size_t i = 0; i < g_bridgeCount; ++i) {
             const BridgeConfig& cfg = g_bridgeTable[i];
-            HAIoTBridge* bridge = new HAIoTBridge(cfg);
+            HAIoTBridge* bridge = new (&g_bridgeArena[i]) HAIoTBridge(cfg);
             BridgeRegistry.push_back(bridge);
+            if (bridge->needsService()) g_shapedBridges.push_back(bridge);
         }
 
+        logHeapUse("registry built", heapBefore);
+
+        buildTopicIndex();
+
         HestiaCore::logSummary();
 
         Serial.println(F("=== [BridgeRegistry] Initialization completed ==="));
     }
 
+
+    /*****************************************************************************************
+     *  buildTopicIndex()
+     *  ---------------------------------------------------------------
+     *  Build the topicFrom → bridge hash index used by onMessageReceived().
+     *
+     *  Notes:
+     *    • Table size is the next power of two ≥ 2× the number of inbound topics,
+     *      so the load factor stays ≤ 0.5 and probe chains remain short.
+     *    • Indicators and bridges without topicFrom never consume messages and
+     *      are not indexed.
+     *    • When two bridges share a topicFrom, the first one in the table wins
+     *      (same result as the former linear scan) and a warning is printed.
+     *    • A generated index (setTopicIndex) is used as-is if every inbound
+     *      bridge sits in its slot and no slot points elsewhere.
+     *****************************************************************************************/
+    static bool isInbound(const HAIoTBridge* b) {
+        return b->topicFrom()[0] != '\0' && b->type() != TypeHA::HA_INDICATOR;
+    }
+
+    static bool useGeneratedIndex(size_t inbound) {
+        const TopicIndex* idx = g_generatedIndex;
+        if (!idx) return false;
+
+        size_t n = idx->slotCount;
+        bool ok = idx->slots && n && (n & (n - 1)) == 0;
+        size_t used = 0;
+
+        for (size_t s = 0; ok && s < n; ++s) {
+            uint16_t row = idx->slots[s];
+            if (row == TOPIC_SLOT_EMPTY) continue;
+            used++;
+            ok = row < BridgeRegistry.size()
+                 && isInbound(BridgeRegistry[row])
+                 && (HestiaHash::fnv1a(BridgeRegistry[row]->topicFrom(), idx->seed) & (n - 1)) == s;
+        }
+
+        if (!ok || used != inbound || used == n) {   // A full table would never end a miss
+            Serial.println(F("[HestiaCore] WARNING: generated topic index does not match bridge_config[], rebuilding"));
+            return false;
+        }
+
+        g_topicTable = idx->slots;
+        g_topicMask  = (uint32_t)(n - 1);
+        g_topicSeed  = idx->seed;
+        Serial.printf("[HestiaCore] Topic index: %u inbound topics, %u slots, perfect hash (generated)\n",
+                      (unsigned)inbound, (unsigned)n);
+        return true;
+    }
+
+    static const char* topicOfRow(uint16_t row) {
+        return BridgeRegistry[row]->topicFrom();
+    }
+
+    static void buildTopicIndex() {
+        size_t inbound = 0;
+        for (auto* b : BridgeRegistry) {
+            if (isInbound(b)) inbound++;
+        }
+
+        if (useGeneratedIndex(inbound)) return;
+
+        size_t slots = HestiaTopicIndex::slotsFor(inbound);
+
+        g_topicSlots.assign(slots, TOPIC_SLOT_EMPTY);
+        g_topicTable = g_topicSlots.data();
+        g_topicMask = (uint32_t)(slots - 1);
+        g_topicSeed = HestiaHash::FNV_OFFSET;
+
+        int maxProbe = 0;
+        for (size_t i = 0; i < BridgeRegistry.size(); ++i) {
+            HAIoTBridge* b = BridgeRegistry[i];
+            if (!isInbound(b)) continue;
+
+            uint16_t existing = TOPIC_SLOT_EMPTY;
+            int probe = HestiaTopicIndex::insert(g_topicSlots.data(), g_topicMask, g_topicSeed,
+                                                 (uint16_t)i, topicOfRow, existing);
+            if (probe < 0) {
+                Serial.printf("[HestiaCore] WARNING: topic '%s' already handled by %s, ignored for %s\n",
+                              b->topicFrom(),
+                              BridgeRegistry[existing]->name(),
+                              b->name());
+                continue;
+            }
+            if (probe > maxProbe) maxProbe = probe;
+        }
+
+        Serial.printf("[HestiaCore] Topic index: %u inbound topics, %u slots, max probe %u\n",
+                      (unsigned)inbound, (unsigned)slots, (unsigned)maxProbe);
+    }
+
     // =====================================================================================
     //  initCore() — Complete communication state machine
     // -------------------------------------------------------------------------------------
     static bool _coreInitialized = false;
 
+    static bool initCoreImpl(
+        const char* deviceParamsJson,
+        const HestiaConfig::ParamDescriptor* paramTable,
+        size_t paramCount,
+        const BridgeConfig* bridgeConfig,
+        size_t bridgeCount,
+        const char* discoveryJson,
+        const HestiaNet::DiscoveryEntry* discoveryTable,
+        size_t discoveryCount
+    );
+
     bool initCore(
         const char* deviceParamsJson,
         const BridgeConfig* bridgeConfig,
         size_t bridgeCount,
         const char* discoveryJson
     )
+    {
+        return initCoreImpl(deviceParamsJson, nullptr, 0,
+                            bridgeConfig, bridgeCount, discoveryJson, nullptr, 0);
+    }
+
+    bool initCore(
+        const HestiaConfig::ParamDescriptor* paramTable,
+        size_t paramCount,
+        const BridgeConfig* bridgeConfig,
+        size_t bridgeCount,
+        const char* discoveryJson
+    )
+    {
+        return initCoreImpl(nullptr, paramTable, paramCount,
+                            bridgeConfig, bridgeCount, discoveryJson, nullptr, 0);
+    }
+
+    bool initCore(
+        const HestiaConfig::ParamDescriptor* paramTable,
+        size_t paramCount,
+        const BridgeConfig* bridgeConfig,
+        size_t bridgeCount,
+        const HestiaNet::DiscoveryEntry* discoveryTable,
+        size_t discoveryCount
+    )
+    {
+        return initCoreImpl(nullptr, paramTable, paramCount,
+                            bridgeConfig, bridgeCount, nullptr, discoveryTable, discoveryCount);
+    }
+
+    static bool initCoreImpl(
+        const char* deviceParamsJson,
+        const HestiaConfig::ParamDescriptor* paramTable,
+        size_t paramCount,
+        const BridgeConfig* bridgeConfig,
+        size_t bridgeCount,
+        const char* discoveryJson,
+        const HestiaNet::DiscoveryEntry* discoveryTable,
+        size_t discoveryCount
+    )
     {
         // ---------------------------------------------------------------------
         // Guard: prevent double initialization
@@ -200,8 +423,11 @@ namespace HestiaCore {
         HardwareInit::InitHardwareMinimal();
         Serial.println(F("[HestiaCore] Minimal hardware initialized"));
 
-        // 1) Load device parameters (R2 JSON → HestiaParam objects)
-        if (!HestiaConfig::loadDeviceParams(deviceParamsJson)) {
+        // 1) Load device parameters (flash table or R2 JSON → HestiaParam objects)
+        bool paramsOk = paramTable
+                        ? HestiaConfig::loadDeviceParams(paramTable, paramCount)
+                        : HestiaConfig::loadDeviceParams(deviceParamsJson);
+        if (!paramsOk) {
             Serial.println(F("[HestiaCore] ERROR: DeviceParams loading failed"));
             return false;
         }
@@ -213,7 +439,7 @@ namespace HestiaCore {
         // 2) Validate configuration and provisioning decision
         if (!HestiaConfig::validateR2() || HestiaConfig::ForceProvisioning()) {
             Serial.println(F("[HestiaCore] Provisioning mode triggered"));
-            Provisioning::StartProvisioning(deviceParamsJson);
+            Provisioning::StartProvisioning();
             // NEVER RETURNS
         }
         Serial.println(F("[HestiaCore] Configuration validated"));
@@ -226,9 +452,16 @@ namespace HestiaCore {
             Serial.println(F("[HestiaCore] Watchdog disabled (no parameter)"));
         }
 
-        // 4) Inject bridge configuration and discovery JSON
+        // 3.5) Write-behind persistence for HA_CONTROL entities
+        HestiaParam* commitParam = HestiaConfig::getParamObj("nvs_commit_ms");
+        HestiaPersist::begin(commitParam ? (uint32_t)commitParam->readInt()
+                                         : HestiaPersist::DEFAULT_COMMIT_DELAY_MS);
+
+        // 4) Inject bridge configuration and discovery (generated table or JSON)
         loadBridgeConfig(bridgeConfig, bridgeCount);
-        HestiaNet::loadDiscoveryJson(discoveryJson);
+        if (discoveryTable) HestiaNet::loadDiscoveryTable(discoveryTable, discoveryCount);
+        else                HestiaNet::loadDiscoveryJson(discoveryJson);
+        HestiaNet::loadConfig();
 
         Serial.printf(
             "[HestiaCore] Bridge configuration loaded (%u entries)\n",
@@ -244,18 +477,19 @@ namespace HestiaCore {
         Serial.println(F("[HestiaCore] NVS values restored"));
 
         // 7) Silent mode for diagnostics-only entities
-        if (HestiaCore::get("IotBridge_ip")) {
-            HestiaCore::get("IotBridge_ip")->setLogWrites(false);
+        if (HAIoTBridge* ip = at(handleOf("IotBridge_ip"))) {
+            ip->setLogWrites(false);
             Serial.println(F("[HestiaCore] Silent mode for diagnostics-only entities IotBridge_ip "));
         }
 
         // 8) Initial system heartbeat
-        if (HestiaCore::get("IotBridge_iotHeartbeat")) {
-            HestiaCore::get("IotBridge_iotHeartbeat")->write("TICK");
-            HestiaCore::get("IotBridge_iotHeartbeat")->setLogWrites(false); // Silent mode
+        if (HAIoTBridge* heartbeat = at(handleOf("IotBridge_iotHeartbeat"))) {
+            heartbeat->write("TICK");
+            heartbeat->setLogWrites(false); // Silent mode
             Serial.println(F("[HestiaCore] Initial heartbeat sent"));
         }
 
+        Serial.printf("[HestiaCore] Free heap after init: %u bytes\n", (unsigned)ESP.getFreeHeap());
         Serial.println(F("=== [HestiaCore] Core initialization complete ==="));
         return true;
     }
@@ -302,6 +536,7 @@ namespace HestiaCore {
         HA_ONLINE_WAIT,
         HA_ONLINE_CONFIRM,
         DISCOVERY,
+        DISCOVERY_STEP,
         START_FLUSH,
         SUBSCRIPTION,
         START_TIMER_FLUSH,
@@ -312,19 +547,334 @@ namespace HestiaCore {
         HA_INIT_DONE,
         SYSTEM_RUNNING
     };
-    CommState coreState = CommState::WIFI_NOT_READY;
+    // Written by the network side, read (and advanced at two hand-over points:
+    // newSeqComm / setHAInitDone) by the application — hence atomic.
+    std::atomic<CommState> coreState{CommState::WIFI_NOT_READY};
     bool FlushState   = false;
     bool ha_ok       = false;
 
-    void CoreComm() { 
+    // =====================================================================================
+    //  Network Task (opt-in) — state
+    // -------------------------------------------------------------------------------------
+    //  When started, the network task owns Wi-Fi, the MQTT client, the outbox and the
+    //  ENTITIES bridges. The application task owns every other bridge, persistence and
+    //  publish shaping. Messages cross through two SPSC rings:
+    //    • TX (app → net): publications and log lines
+    //    • RX (net → app): inbound commands for CONTROL / BUTTON bridges
+    //  Messages larger than a slot travel out of line: one heap copy owned by the
+    //  message, freed by the consuming task.
+    // =====================================================================================
+    namespace {
+        enum class TxKind : uint8_t { PUBLISH, LOG };
+
+        struct TxMsg {
+            TxKind kind;
+            char*  ext;                // Heap "topic\0payload" when either exceeds its slot
+            char   topic[HESTIA_TXQ_TOPIC_MAX];
+            char   payload[HESTIA_TXQ_PAYLOAD_MAX];
+        };
+
+        struct RxMsg {
+            HAIoTBridge* bridge;       // Arena-backed, stable for the whole run
+            char*        ext;          // Heap payload when it exceeds the slot
+            char         payload[HESTIA_RXQ_PAYLOAD_MAX];
+        };
+
+        SpscRing<TxMsg, HESTIA_TXQ_DEPTH> g_txQueue;
+        SpscRing<RxMsg, HESTIA_RXQ_DEPTH> g_rxQueue;
+
+        std::atomic<TaskHandle_t> g_netTask{nullptr};   // Read from both tasks
+        std::atomic<bool> g_netRun{false};
+        std::atomic<bool> g_netExited{false};
+
+        NetTaskStats g_netStats = {};
+        LoopStats    g_loopStats = {};
+
+        // True when called from the application side while the network task runs
+        inline bool crossTask() {
+            TaskHandle_t t = g_netTask.load();
+            return t && xTaskGetCurrentTaskHandle() != t;
+        }
+
+        // Bounded copy; false if @p src does not fit
+        bool copyFits(char* dst, size_t cap, const char* src) {
+            size_t len = strlen(src);
+            if (len >= cap) return false;
+            memcpy(dst, src, len + 1);
+            return true;
+        }
+
+        // Heap copy of @p a and @p b as "a\0b\0" (b may be null); nullptr if out of memory
+        char* dupPair(const char* a, const char* b) {
+            size_t la = strlen(a) + 1;
+            size_t lb = b ? strlen(b) + 1 : 0;
+            char* p = (char*)malloc(la + lb);
+            if (!p) return nullptr;
+            memcpy(p, a, la);
+            if (b) memcpy(p + la, b, lb);
+            return p;
+        }
+    }
+
+    static void outboxPush(const char* topic, const char* payload);
+
+    // Ring slots kept free for publications: log lines never take the last ones
+    constexpr size_t TXQ_LOG_RESERVE = HESTIA_TXQ_DEPTH / 4;
+
+    // false only when the ring is full (an oversize message without heap for its
+    // out-of-line copy is counted and discarded)
+    static bool txPush(TxKind kind, const char* topic, const char* payload) {
+        TxMsg* m = g_txQueue.reserve();
+        if (!m) return false;
+
+        m->kind = kind;
+        m->ext  = nullptr;
+        if (!copyFits(m->topic, sizeof(m->topic), topic) ||
+            !copyFits(m->payload, sizeof(m->payload), payload)) {
+            m->ext = dupPair(topic, payload);
+            if (!m->ext) {
+                g_netStats.txOversize++;
+                Serial.printf("[HestiaCore] WARNING: no memory for oversize TX message (topic %s)\n", topic);
+                return true;
+            }
+        }
+        g_txQueue.commit();
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------
+    //  TX backlog (application task only)
+    //  Publications that find the ring full (HAInit burst: one state per entity plus
+    //  log lines) wait here, one per topic with the newest payload — the same rule as
+    //  the outbox — and enter the ring as it drains. State is never dropped; order per
+    //  topic is kept because nothing bypasses a non-empty backlog.
+    // ---------------------------------------------------------------------------------
+    struct TxPending {
+        String topic;
+        String payload;
+    };
+    static std::vector<TxPending> g_txBacklog;
+
+    static void flushTxBacklog() {
+        size_t n = 0;
+        while (n < g_txBacklog.size() &&
+               txPush(TxKind::PUBLISH, g_txBacklog[n].topic.c_str(), g_txBacklog[n].payload.c_str())) {
+            n++;
+        }
+        if (n) g_txBacklog.erase(g_txBacklog.begin(), g_txBacklog.begin() + n);
+    }
+
+    static void txPublish(const char* topic, const char* payload) {
+        flushTxBacklog();
+        if (g_txBacklog.empty() && txPush(TxKind::PUBLISH, topic, payload)) return;
+
+        g_netStats.txDeferred++;
+        for (auto& p : g_txBacklog) {
+            if (p.topic == topic) {
+                p.payload = payload;
+                return;
+            }
+        }
+        g_txBacklog.push_back({ topic, payload });
+    }
+
+    static void txLog(const char* topic, const char* line) {
+        if (g_txQueue.size() + TXQ_LOG_RESERVE >= HESTIA_TXQ_DEPTH ||
+            !txPush(TxKind::LOG, topic, line)) {
+            g_netStats.txDropped++;
+        }
+    }
+
+    // Network side: move application messages into the outbox / log stream
+    static void drainTxQueue() {
+        static TxMsg m;   // network task only; keeps ~300 bytes off its stack
+        while (g_txQueue.pop(m)) {
+            const char* topic   = m.ext ? m.ext : m.topic;
+            const char* payload = m.ext ? m.ext + strlen(m.ext) + 1 : m.payload;
+            if (m.kind == TxKind::PUBLISH) {
+                outboxPush(topic, payload);
+            } else {
+                HestiaNet::publish(topic, payload);
+            }
+            free(m.ext);   // Both paths copy what they keep
+        }
+    }
+
+    // Application side: apply inbound commands forwarded by the network task
+    static void pumpRxQueue() {
+        flushTxBacklog();
+
+        static RxMsg m;   // application task only
+        while (g_rxQueue.pop(m)) {
+            String topic   = m.bridge->topicFrom();
+            String payload = m.ext ? m.ext : m.payload;
+            free(m.ext);
+            m.bridge->readMQTT(topic, payload, false);
+        }
+    }
+
+    // Application side: entity services that touch bridge state
+    static void appServices() {
+        // Loop jitter: interval between two CoreComm() calls
+        uint32_t nowUs = micros();
+        if (g_loopStats.calls++ > 0) {
+            uint32_t gap = nowUs - g_loopStats.lastCallUs;
+            if (gap > g_loopStats.maxGapUs) g_loopStats.maxGapUs = gap;
+        }
+        g_loopStats.lastCallUs = nowUs;
+
+        // Deferred / forced entity publications (rate-limited bridges only)
+        if (!g_shapedBridges.empty()) {
+            uint32_t now = millis();
+            for (auto* b : g_shapedBridges) b->servicePublish(now);
+        }
+
+        // Deferred NVS commits (independent of connectivity)
+        HestiaPersist::service();
+
+        HardwareInit::watchdogKick();
+    }
+
+    static void runCommStateMachine();
+
+    // =====================================================================================
+    //  CoreComm() — entry point called from loop()
+    // -------------------------------------------------------------------------------------
+    //  Default mode : runs the communication state machine, then application services.
+    //  Task mode    : the state machine runs in the network task; loop() only applies
+    //                 inbound commands and runs application services — it never blocks
+    //                 on the network.
+    // =====================================================================================
+    void CoreComm() {
+        if (g_netTask) {
+            pumpRxQueue();
+        } else {
+            runCommStateMachine();
+        }
+        appServices();
+    }
+
+    // =====================================================================================
+    //  Network task body
+    // =====================================================================================
+    static void netTaskMain(void*) {
+        // Keep the task watchdog guarding network stalls in this task as well
+        bool wdt = HardwareInit::wdtReady() && (esp_task_wdt_add(nullptr) == ESP_OK);
+
+        while (g_netRun.load()) {
+            drainTxQueue();
+            runCommStateMachine();
+            if (wdt) esp_task_wdt_reset();
+            vTaskDelay(1);
+        }
+
+        if (wdt) esp_task_wdt_delete(nullptr);
+        g_netExited.store(true);
+        vTaskDelete(nullptr);
+    }
+
+    bool startNetworkTask(int core, uint32_t stackSize, UBaseType_t priority) {
+        if (g_netTask) return true;
+
+#if defined(CONFIG_FREERTOS_UNICORE) || (portNUM_PROCESSORS == 1)
+        core = 0;
+#endif
+        g_netRun.store(true);
+        g_netExited.store(false);
+
+        TaskHandle_t handle = nullptr;
+        BaseType_t ok = xTaskCreatePinnedToCore(netTaskMain, "HestiaNet", stackSize,
+                                                nullptr, priority, &handle, core);
+        if (ok != pdPASS) {
+            g_netRun.store(false);
+            Serial.println(F("[HestiaCore] ERROR: Cannot create network task."));
+            return false;
+        }
+
+        g_netTask.store(handle);
+        Serial.printf("[HestiaCore] Network task started on core %d (stack %lu, prio %u)\n",
+                      core, (unsigned long)stackSize, (unsigned)priority);
+        return true;
+    }
+
+    void stopNetworkTask() {
+        if (!g_netTask) return;
+
+        g_netRun.store(false);
+
+        // The task may be inside a bounded network call (CONNACK wait, streamed
+        // publish): single-loop mode resumes only once it has left its loop, so
+        // two tasks never drive the client at once. A task that truly hangs is
+        // caught by its own task-watchdog subscription.
+        uint32_t t0 = millis();
+        bool warned = false;
+        while (!g_netExited.load()) {
+            HardwareInit::watchdogKick();
+            if (!warned && (millis() - t0) >= 2000) {
+                Serial.println(F("[HestiaCore] Waiting for the network task to finish its current call..."));
+                warned = true;
+            }
+            vTaskDelay(1);
+        }
+        g_netTask.store(nullptr);
+
+        // Commands already received are applied; application messages still queued
+        // go to the outbox, now owned by the caller
+        pumpRxQueue();
+        drainTxQueue();
+        for (auto& p : g_txBacklog) outboxPush(p.topic.c_str(), p.payload.c_str());
+        g_txBacklog.clear();
+        Serial.println(F("[HestiaCore] Network task stopped."));
+    }
+
+    bool networkTaskRunning() {
+        return g_netTask != nullptr;
+    }
+
+    const NetTaskStats& netTaskStats() {
+        return g_netStats;
+    }
+
+    const LoopStats& loopStats() {
+        return g_loopStats;
+    }
+
+    void logLoopStats(bool reset) {
+        Serial.printf("[HestiaCore] Loop (%s): %lu calls, max gap %lu us | TX dropped %lu, "
+                      "deferred %lu, oversize %lu | RX dropped %lu\n",
+                      g_netTask ? "task mode" : "single loop",
+                      (unsigned long)g_loopStats.calls,
+                      (unsigned long)g_loopStats.maxGapUs,
+                      (unsigned long)g_netStats.txDropped,
+                      (unsigned long)g_netStats.txDeferred,
+                      (unsigned long)g_netStats.txOversize,
+                      (unsigned long)g_netStats.rxDropped);
+        const HestiaNet::MqttStats& mq = HestiaNet::mqttStats();
+        Serial.printf("[HestiaCore] MQTT: streamed %lu (cut %lu) | RX oversize %lu\n",
+                      (unsigned long)mq.streamed,
+                      (unsigned long)mq.streamFailed,
+                      (unsigned long)mq.rxOversize);
+        if (reset) {
+            g_loopStats.calls    = 0;
+            g_loopStats.maxGapUs = 0;
+        }
+    }
+
+    // =====================================================================================
+    //  runCommStateMachine() — Wi-Fi / MQTT / HA pipeline (network side)
+    // =====================================================================================
+    static void runCommStateMachine() { 
 
         // Cache du bridge HA_online
         static HAIoTBridge* haOnlineBridge = nullptr;
         static HAIoTBridge* haHeartbeatBridge = nullptr;
+        static bool bridgesResolved = false;
         // Cache heartbeat timeout value
         static uint32_t haHbTimeout =
                  HestiaConfig::getParamObj("ha_heartbeat_timeout_ms")->readInt();
         static const char* HA_HB_TIMER = "HA_HB_TIMER";
+        // Next bridge to subscribe (SUBSCRIPTION resumes there after a streamed publish)
+        static size_t subNext = 0;
 
         // -------------------------------------------------------------------------
         // 1) Wi-Fi Guard: non-blocking reconnection attempts
@@ -358,14 +908,13 @@ namespace HestiaCore {
         }
 
         // -------------------------------------------------------------------------
-        // Load HA_online bridge once
+        // Resolve HA_online / HA_heartbeat bridges once
         // -------------------------------------------------------------------------
-        if (!haOnlineBridge) {
-            haOnlineBridge = HestiaCore::get("IotBridge_HA_online");
+        if (!bridgesResolved) {
+            haOnlineBridge    = at(handleOf("IotBridge_HA_online"));
+            haHeartbeatBridge = at(handleOf("IotBridge_HA_heartbeat"));
+            bridgesResolved   = true;
         }
-        if (!haHeartbeatBridge) {
-            haHeartbeatBridge = HestiaCore::get("IotBridge_HA_heartbeat");
-        }   
 
         switch (coreState) {
 
@@ -379,11 +928,9 @@ namespace HestiaCore {
             case CommState::HA_ONLINE_WAIT:
             {
                 HestiaNet::startMessageReceived(); // Start MQTT message received
-                String topic = "";
-                if (haOnlineBridge)
-                    topic = haOnlineBridge->topicFrom();
-                if (topic.length() > 0){
-                    client.subscribe(topic.c_str());
+                const char* topic = haOnlineBridge ? haOnlineBridge->topicFrom() : "";
+                if (topic[0] != '\0'){
+                    HestiaNet::subscribe(topic);   // Deferred while a publish is streamed: retried next tick
                 } else {
                     Serial.println(F("[CoreComm] WARNING: HA_online bridge not found or has no topic."));
                 }
@@ -406,8 +953,15 @@ namespace HestiaCore {
             case CommState::DISCOVERY:
                 Serial.println("=== [HestiaCore::CoreComm | Discovery] Starting Home Assistant discovery ===");
                 Serial.flush();
-                HestiaNet::MQTTDiscovery();
-                coreState = CommState::START_FLUSH;
+                coreState = HestiaNet::beginDiscovery() ? CommState::DISCOVERY_STEP
+                                                        : CommState::START_FLUSH;
+                break;
+
+            case CommState::DISCOVERY_STEP:
+                // One component per tick (HESTIA_DISCOVERY_STEP_MS): the loop keeps running
+                if (HestiaNet::discoveryStep(HESTIA_DISCOVERY_STEP_MS) != HestiaNet::DiscoveryStatus::IN_PROGRESS) {
+                    coreState = CommState::START_FLUSH;
+                }
                 break;
 
             // ==============  PIPELINE HA : FLUSH + SUBSCRIBE  ==============
@@ -417,19 +971,21 @@ namespace HestiaCore {
                 Serial.flush();
                 FlushState   = true;
                 HestiaNet::startMessageReceived();   // Start MQTT message received
+                subNext   = 0;
                 coreState = CommState::SUBSCRIPTION;
                 break;
 
             case CommState::SUBSCRIPTION:
-                // 2) Topics subscription
-                Serial.println(F("=== [HestiaCore::CoreComm | MQTT Subscribe] Subscribing topics ==="));
-                Serial.flush();
-                for (auto &bridge : BridgeRegistry) {
-                    String topic = bridge->topicFrom();
-                    if (topic.length() > 0) {
-                        client.subscribe(topic.c_str());
-                    }
+                // 2) Topics subscription — resumed next tick while a publish is streamed
+                if (subNext == 0) {
+                    Serial.println(F("=== [HestiaCore::CoreComm | MQTT Subscribe] Subscribing topics ==="));
+                    Serial.flush();
                 }
+                for (; subNext < BridgeRegistry.size(); ++subNext) {
+                    const char* topic = BridgeRegistry[subNext]->topicFrom();
+                    if (topic[0] != '\0' && !HestiaNet::subscribe(topic)) break;
+                }
+                if (subNext < BridgeRegistry.size()) break;
                 Serial.println(F("=== [HestiaCore::CoreComm | MQTT Subscribe] Completed ===\n"));
                 Serial.flush();
                 coreState = CommState::START_TIMER_FLUSH;
@@ -471,6 +1027,8 @@ namespace HestiaCore {
 
             // =====================  HAInit  =====================
             case CommState::HA_NEWSEQCOM:
+                // Task mode: leave the hand-over to newSeqComm() in the application
+                if (g_netTask) break;
                 Serial.println(F("[HestiaCore::CoreComm | HAInit ] ✅ New sequence communication started."));
                 Serial.flush();
                 coreState = CommState::HA_INIT_WAIT;
@@ -522,12 +1080,11 @@ namespace HestiaCore {
                 break;
         }
 
-        // MQTT loop + watchdog, tant que MQTT reste connecté
+        // MQTT loop + outbox, tant que MQTT reste connecté
         if (coreState >= CommState::MQTT_READY) {
-            client.loop();
+            HestiaNet::loop();
+            drainOutbox();
         }
-
-        HardwareInit::watchdogKick();
     }
 
 
@@ -548,22 +1105,16 @@ namespace HestiaCore {
      * Returns true once per full communication session (epoch).
      */
     bool newSeqComm() {
-        if (coreState == CommState::HA_NEWSEQCOM) {
-            coreState = CommState::HA_INIT_WAIT;
-            return true;
-        }
-        return false;
+        CommState expected = CommState::HA_NEWSEQCOM;
+        return coreState.compare_exchange_strong(expected, CommState::HA_INIT_WAIT);
     }
 
     // =====================================================================================
     //  HAInitDone setter — called from main after HAInit()
     // =====================================================================================
     void setHAInitDone() {
-        if (coreState == CommState::HA_INIT_WAIT) {
-            coreState = CommState::HA_INIT_DONE;
-            return;
-        }
-        return;
+        CommState expected = CommState::HA_INIT_WAIT;
+        coreState.compare_exchange_strong(expected, CommState::HA_INIT_DONE);
     }
 
     /**
@@ -586,14 +1137,32 @@ namespace HestiaCore {
     // =====================================================================================
     HAIoTBridge* get(const String& name) {
         for (auto* b : BridgeRegistry)
-            if (b->name() == name)
+            if (name == b->name())
                 return b;
         return nullptr;
     }
 
+    BridgeHandle handleOf(const String& name) {
+        for (size_t i = 0; i < BridgeRegistry.size(); ++i)
+            if (name == BridgeRegistry[i]->name())
+                return (BridgeHandle)i;
+        return INVALID_HANDLE;
+    }
+
+    HAIoTBridge* findByTopic(const String& topic) {
+        if (!g_topicTable) return nullptr;
+
+        uint16_t row = HestiaTopicIndex::find(g_topicTable, g_topicMask, g_topicSeed,
+                                              topic.c_str(), topicOfRow);
+        return row == TOPIC_SLOT_EMPTY ? nullptr : BridgeRegistry[row];
+    }
+
     void initAll() {
+        Preferences prefs;
+        prefs.begin(HAIoTBridge::NVS_NAMESPACE, true);
         for (auto* b : BridgeRegistry)
-            b->init();
+            b->init(prefs);
+        prefs.end();
     }
 
     void resetAll() {
@@ -604,30 +1173,184 @@ namespace HestiaCore {
 
     // =====================================================================================
     //  onMessageReceived — MQTT dispatching to entities
+    // -------------------------------------------------------------------------------------
+    //  Constant-time dispatch through the topic index: one hash, one probe chain,
+    //  one String compare, whatever the registry size. Unknown topics are dropped.
     // =====================================================================================
     void onMessageReceived(String &topic, String &payload) {
 
-        for (auto &bridge : BridgeRegistry) {
-            if (bridge->readMQTT(topic, payload, FlushState)) {
-                return; // Message handled, stop scanning
+        HAIoTBridge* bridge = findByTopic(topic);
+        if (!bridge) return;
+
+        // Task mode: application-owned bridges are updated in the application task
+        if (g_netTask && bridge->type() != TypeHA::HA_ENTITIES) {
+            if (FlushState) {
+                bridge->readMQTT(topic, payload, true);   // logs and ignores
+                return;
+            }
+            RxMsg* m = g_rxQueue.reserve();
+            if (!m) {
+                g_netStats.rxDropped++;
+                return;
             }
+            m->bridge = bridge;
+            m->ext    = nullptr;
+            if (!copyFits(m->payload, sizeof(m->payload), payload.c_str())) {
+                m->ext = dupPair(payload.c_str(), nullptr);   // Bounded by mqtt_rx_buffer
+                if (!m->ext) {
+                    g_netStats.rxDropped++;
+                    return;
+                }
+            }
+            g_rxQueue.commit();
+            return;
         }
+
+        bridge->readMQTT(topic, payload, FlushState);
     }
 
 
 
     // =====================================================================================
-    //  publishToMQTT — Centralized publication with optional logging
+    //  Outbound MQTT Outbox
+    // -------------------------------------------------------------------------------------
+    //  Fixed-capacity FIFO ring of pending publications, drained by CoreComm().
+    //    • One slot per topic: a newer payload replaces the queued one in place
+    //      (the topic keeps its position, so ordering across topics is preserved)
+    //    • Slots keep their String buffers, so steady-state queuing does not allocate
+    //    • Full ring: the oldest entry is published inline if the link is up,
+    //      otherwise it is dropped and counted
     // =====================================================================================
-    void publishToMQTT(const String &topic, const String &payload, bool logIt) {
-        if (commOK()) {
-            MQTTrefreshWithDelay(1);
-            client.publish(topic.c_str(), payload.c_str());
+    namespace {
+        struct OutboxEntry {
+            String topic;
+            String payload;
+        };
+
+        OutboxEntry g_outbox[HESTIA_OUTBOX_CAPACITY];
+        size_t      g_outHead  = 0;     // Oldest entry
+        size_t      g_outCount = 0;
+        OutboxStats g_outStats = {};
+
+        inline OutboxEntry& outboxAt(size_t i) {
+            return g_outbox[(g_outHead + i) % HESTIA_OUTBOX_CAPACITY];
+        }
+
+        bool linkUp() {
+            return commOK() && HestiaNet::mqttClient().connected();
+        }
+
+        void outboxPop() {
+            g_outHead = (g_outHead + 1) % HESTIA_OUTBOX_CAPACITY;
+            g_outCount--;
+        }
+    }
+
+    static void outboxPush(const char* topic, const char* payload) {
+        g_outStats.enqueued++;
+
+        // 1) Coalesce with a pending value for the same topic
+        for (size_t i = 0; i < g_outCount; ++i) {
+            OutboxEntry& e = outboxAt(i);
+            if (e.topic == topic) {
+                e.payload = payload;
+                g_outStats.coalesced++;
+                return;
+            }
+        }
+
+        // 2) Make room: publish the oldest inline, or drop it when offline
+        if (g_outCount == HESTIA_OUTBOX_CAPACITY) {
+            OutboxEntry& oldest = outboxAt(0);
+            if (linkUp() && HestiaNet::publish(oldest.topic.c_str(), oldest.payload.c_str())) {
+                g_outStats.published++;
+                g_outStats.overflowInline++;
+            } else {
+                g_outStats.dropped++;
+            }
+            outboxPop();
+        }
+
+        // 3) Append
+        OutboxEntry& e = outboxAt(g_outCount);
+        e.topic   = topic;
+        e.payload = payload;
+        g_outCount++;
+        if (g_outCount > g_outStats.highWater) g_outStats.highWater = g_outCount;
+    }
 
-            if (logIt) {
-                logBook("HestiaCore | Publish topic: " + topic +
-                        " | payload: " + payload);
+    void drainOutbox() {
+        if (g_outCount == 0 || !linkUp()) return;
+
+        uint32_t t0 = micros();
+        size_t   sent = 0;
+
+        while (g_outCount > 0 && sent < HESTIA_OUTBOX_BUDGET_MSGS) {
+            OutboxEntry& e = outboxAt(0);
+            if (!HestiaNet::publish(e.topic.c_str(), e.payload.c_str())) {
+                break;   // link trouble: keep the entry, retry next tick
             }
+            outboxPop();
+            sent++;
+            g_outStats.published++;
+
+            if ((uint32_t)(micros() - t0) >= HESTIA_OUTBOX_BUDGET_US) break;
+        }
+    }
+
+    const OutboxStats& outboxStats() {
+        return g_outStats;
+    }
+
+    size_t outboxPending() {
+        return g_outCount;
+    }
+
+    void logOutboxStats() {
+        Serial.printf("[HestiaCore] Outbox: queued %lu | coalesced %lu | published %lu | "
+                      "inline %lu | dropped %lu | high-water %lu/%u\n",
+                      (unsigned long)g_outStats.enqueued,
+                      (unsigned long)g_outStats.coalesced,
+                      (unsigned long)g_outStats.published,
+                      (unsigned long)g_outStats.overflowInline,
+                      (unsigned long)g_outStats.dropped,
+                      (unsigned long)g_outStats.highWater,
+                      (unsigned)HESTIA_OUTBOX_CAPACITY);
+    }
+
+
+    // =====================================================================================
+    //  logPublishStats() — Per-entity publish shaping counters
+    // =====================================================================================
+    void logPublishStats() {
+        Serial.println(F("[HestiaCore] Publish shaping (suppressed / forced):"));
+        for (auto* b : BridgeRegistry) {
+            if (b->suppressedCount() == 0 && b->forcedCount() == 0) continue;
+            Serial.printf("  %-30s | %8lu | %8lu\n",
+                          b->name(),
+                          (unsigned long)b->suppressedCount(),
+                          (unsigned long)b->forcedCount());
+        }
+    }
+
+
+    // =====================================================================================
+    //  publishToMQTT — Centralized publication with optional logging
+    // -------------------------------------------------------------------------------------
+    //  Queues into the outbox; never spins on client.loop() nor publishes inline
+    //  (except on ring overflow). Values written while offline are kept, one per
+    //  topic, and go out once the link is back.
+    // =====================================================================================
+    void publishToMQTT(const char* topic, const char* payload, bool logIt) {
+        if (crossTask()) {
+            txPublish(topic, payload);
+        } else {
+            outboxPush(topic, payload);
+        }
+
+        if (logIt && commOK()) {
+            logBook("HestiaCore | Publish topic: " + String(topic) +
+                    " | payload: " + String(payload));
         }
     }
 
@@ -642,7 +1365,12 @@ namespace HestiaCore {
         Serial.println(formatted);
 
         // MQTT log stream (only if connected)
-        client.publish(HestiaConfig::getParam("ha_log_topic").c_str(), formatted);
+        String topic = HestiaConfig::getParam("ha_log_topic");
+        if (crossTask()) {
+            txLog(topic.c_str(), formatted.c_str());
+        } else {
+            HestiaNet::publish(topic.c_str(), formatted.c_str());
+        }
     }
 
 
@@ -695,8 +1423,12 @@ namespace HestiaCore {
         // ---------------------------------------------------------------------
         // HA internal values
         // ---------------------------------------------------------------------
-        HestiaCore::get("IotBridge_SW_version")->write(devID + " " + version);
-        HestiaCore::get("IotBridge_ip")->write(ssid + " @ " + String(rssi) + " dB");
+        if (HAIoTBridge* swVersion = at(handleOf("IotBridge_SW_version"))) {
+            swVersion->write(devID + " " + version);
+        }
+        if (HAIoTBridge* ip = at(handleOf("IotBridge_ip"))) {
+            ip->write(ssid + " @ " + String(rssi) + " dB");
+        }
 
 
 
@@ -32,6 +32,43 @@
  *
  *****************************************************************************************/
 
+// ========================================================================================
+//  Build-time tuning (override with -D in build_flags)
+// ========================================================================================
+#ifndef HESTIA_OUTBOX_CAPACITY
+#define HESTIA_OUTBOX_CAPACITY    32     // Pending publications (one per topic)
+#endif
+#ifndef HESTIA_OUTBOX_BUDGET_MSGS
+#define HESTIA_OUTBOX_BUDGET_MSGS 8      // Max messages published per CoreComm() tick
+#endif
+#ifndef HESTIA_OUTBOX_BUDGET_US
+#define HESTIA_OUTBOX_BUDGET_US   2000   // Max time spent draining per tick (µs)
+#endif
+#ifndef HESTIA_NET_TASK_CORE
+#define HESTIA_NET_TASK_CORE      0      // Core of the optional network task (PRO_CPU)
+#endif
+#ifndef HESTIA_NET_TASK_STACK
+#define HESTIA_NET_TASK_STACK     8192   // Network task stack (bytes)
+#endif
+#ifndef HESTIA_NET_TASK_PRIO
+#define HESTIA_NET_TASK_PRIO      2      // Above loopTask (1), below the lwIP task
+#endif
+#ifndef HESTIA_TXQ_DEPTH
+#define HESTIA_TXQ_DEPTH          16     // App → network messages (power of two)
+#endif
+#ifndef HESTIA_TXQ_TOPIC_MAX
+#define HESTIA_TXQ_TOPIC_MAX      96     // Topic carried in the TX slot (longer: heap copy)
+#endif
+#ifndef HESTIA_TXQ_PAYLOAD_MAX
+#define HESTIA_TXQ_PAYLOAD_MAX    192    // Payload carried in the TX slot (longer: heap copy)
+#endif
+#ifndef HESTIA_RXQ_DEPTH
+#define HESTIA_RXQ_DEPTH          16     // Network → app commands (power of two)
+#endif
+#ifndef HESTIA_RXQ_PAYLOAD_MAX
+#define HESTIA_RXQ_PAYLOAD_MAX    64     // Inbound payload carried in the RX slot (longer: heap copy)
+#endif
+
 namespace HestiaCore {
 
   // =====================================================================================
@@ -39,6 +76,136 @@ namespace HestiaCore {
   // =====================================================================================
   extern std::vector<HAIoTBridge*> BridgeRegistry;
 
+  // =====================================================================================
+  //  Entity Handles
+  // -------------------------------------------------------------------------------------
+  //  A handle is the row index of an entity in the injected BridgeConfig table.
+  //  RegisterEntitiesIotBridge() instantiates rows in table order, so the handle is
+  //  also the bridge position in BridgeRegistry and stays valid for the whole run.
+  // =====================================================================================
+  using BridgeHandle = uint16_t;
+  static constexpr BridgeHandle INVALID_HANDLE = 0xFFFF;
+
+  namespace detail {
+    constexpr bool sameName(const char* a, const char* b) {
+      while (*a && *a == *b) { ++a; ++b; }
+      return *a == *b;
+    }
+
+    constexpr int32_t pow10(uint8_t n) {
+      return n == 0 ? 1 : 10 * pow10(n - 1);
+    }
+
+    template <BridgeHandle H>
+    struct CheckedHandle {
+      static_assert(H != INVALID_HANDLE, "HA(): entity name not found in bridge_config[]");
+      static constexpr BridgeHandle value = H;
+    };
+  }
+
+  /**
+   * @brief Resolve an entity name to its handle at compile time.
+   *
+   * Requires the BridgeConfig table to be declared constexpr.
+   *
+   * @return Row index of @p name in @p table, or INVALID_HANDLE.
+   */
+  template <size_t N>
+  constexpr BridgeHandle handleOf(const BridgeConfig (&table)[N], const char* name) {
+    for (size_t i = 0; i < N; ++i) {
+      if (detail::sameName(table[i].name, name)) return (BridgeHandle)i;
+    }
+    return INVALID_HANDLE;
+  }
+
+  /**
+   * @brief Resolve an entity name to its handle at runtime (linear scan).
+   *
+   * Intended for one-time resolution during setup; cache the result.
+   */
+  BridgeHandle handleOf(const String& name);
+
+  /**
+   * @brief Access a bridge by handle — a bounds-checked array index.
+   *
+   * @return The bridge instance, or nullptr if the handle is out of range.
+   */
+  inline HAIoTBridge* at(BridgeHandle h) {
+    return (h < BridgeRegistry.size()) ? BridgeRegistry[h] : nullptr;
+  }
+
+  // =====================================================================================
+  //  Typed Handles
+  // -------------------------------------------------------------------------------------
+  //  Thin wrappers over a BridgeHandle for numeric and boolean entities. The scale
+  //  factor is a compile-time constant, so sensor updates and command reads go
+  //  straight to the bridge's typed slot: no String, no parsing, no float formatting.
+  //  They hold a handle, not a pointer, and can therefore be declared before the
+  //  registry exists (e.g. at file scope). Unresolved handles read as 0 / false.
+  //
+  //    static constexpr HestiaCore::FixedHandle<1> temperature{HA_ID("temperature")};
+  //    temperature.write(21.46f);                // stored as 215, published "21.5"
+  // =====================================================================================
+
+  /**
+   * @brief Fixed-point entity (resolution 10^-DEC), e.g. FixedHandle<1> for "0.1".
+   */
+  template <uint8_t DEC>
+  class FixedHandle {
+    static_assert(DEC <= HAIoTBridge::MAX_FIXED_DECIMALS, "FixedHandle: too many decimals");
+
+  public:
+    static constexpr int32_t SCALE = detail::pow10(DEC);
+
+    constexpr explicit FixedHandle(BridgeHandle h) : _h(h) {}
+
+    void write(float v) const { writeRaw((int32_t)lroundf(v * SCALE)); }
+    void writeRaw(int32_t raw) const { if (HAIoTBridge* b = at(_h)) b->writeScaled(raw, DEC); }
+
+    float   read() const    { return (float)readRaw() / SCALE; }
+    int32_t readRaw() const { HAIoTBridge* b = at(_h); return b ? b->readScaled(DEC) : 0; }
+
+    bool onChange() const { HAIoTBridge* b = at(_h); return b && b->onChange(); }
+    HAIoTBridge* bridge() const { return at(_h); }
+
+  private:
+    BridgeHandle _h;
+  };
+
+  /**
+   * @brief Integer entity (resolution "1").
+   */
+  class IntHandle {
+  public:
+    constexpr explicit IntHandle(BridgeHandle h) : _h(h) {}
+
+    void    write(int32_t v) const { if (HAIoTBridge* b = at(_h)) b->writeScaled(v, 0); }
+    int32_t read() const           { HAIoTBridge* b = at(_h); return b ? b->readScaled(0) : 0; }
+
+    bool onChange() const { HAIoTBridge* b = at(_h); return b && b->onChange(); }
+    HAIoTBridge* bridge() const { return at(_h); }
+
+  private:
+    BridgeHandle _h;
+  };
+
+  /**
+   * @brief Boolean entity (default spelled ON/OFF or true/false).
+   */
+  class BoolHandle {
+  public:
+    constexpr explicit BoolHandle(BridgeHandle h) : _h(h) {}
+
+    void write(bool v) const { if (HAIoTBridge* b = at(_h)) b->write(v); }
+    bool read() const        { HAIoTBridge* b = at(_h); return b && b->readBool(); }
+
+    bool onChange() const { HAIoTBridge* b = at(_h); return b && b->onChange(); }
+    HAIoTBridge* bridge() const { return at(_h); }
+
+  private:
+    BridgeHandle _h;
+  };
+
   // =====================================================================================
   //  Core API — High-Level Operations
   // =====================================================================================
@@ -75,6 +242,9 @@ namespace HestiaCore {
   /**
    * @brief Instantiate all entities from the active BridgeConfig table and
    *        register them in BridgeRegistry.
+   *
+   * Also builds the inbound topic index (topicFrom → bridge) used by
+   * onMessageReceived() for constant-time dispatch.
    */
   void RegisterEntitiesIotBridge();
 
@@ -115,6 +285,39 @@ namespace HestiaCore {
     const char* discoveryJson
   );
 
+  /**
+   * @brief Same as above, with parameters from a generated flash table.
+   *
+   * No JSON parsing at boot (see tools/gen_device_params.py).
+   *
+   * @param paramTable  HESTIA_PARAM_TABLE from DeviceParamsTable.h.
+   * @param paramCount  HESTIA_PARAM_COUNT.
+   */
+  bool initCore(
+    const HestiaConfig::ParamDescriptor* paramTable,
+    size_t paramCount,
+    const BridgeConfig* bridgeConfig,
+    size_t bridgeCount,
+    const char* discoveryJson
+  );
+
+  /**
+   * @brief Same as above, with discovery from a generated flash table.
+   *
+   * No JSON work at runtime for discovery (see tools/gen_discovery.py).
+   *
+   * @param discoveryTable  HESTIA_DISCOVERY_TABLE from DiscoveryTable.h.
+   * @param discoveryCount  HESTIA_DISCOVERY_COUNT.
+   */
+  bool initCore(
+    const HestiaConfig::ParamDescriptor* paramTable,
+    size_t paramCount,
+    const BridgeConfig* bridgeConfig,
+    size_t bridgeCount,
+    const HestiaNet::DiscoveryEntry* discoveryTable,
+    size_t discoveryCount
+  );
+
   /**
    * @brief Execute the full Communication State Machine.
    *
@@ -127,9 +330,85 @@ namespace HestiaCore {
    *   • Retained-message flush window
    *
    * Must be called continuously in loop().
+   *
+   * When the network task is running (startNetworkTask()), the state machine runs
+   * there instead and CoreComm() only applies inbound commands, deferred
+   * publications and NVS commits — it never blocks on Wi-Fi or the broker.
    */
   void CoreComm();
 
+  // =====================================================================================
+  //  Network Task (opt-in)
+  // -------------------------------------------------------------------------------------
+  //  Moves Wi-Fi / MQTT handling into a dedicated FreeRTOS task so that slow connects,
+  //  DNS lookups and broker outages no longer stall loop().
+  //
+  //  Ownership in task mode:
+  //    • Network task     : Wi-Fi, MQTT client, outbox, ENTITIES bridges
+  //    • Application task : CONTROL / INDICATOR / BUTTON bridges, persistence
+  //
+  //  The two sides exchange fixed-size messages through lock-free SPSC rings
+  //  (HestiaQueue.h). The rings have ONE producer: every call to publishToMQTT(),
+  //  logBook() or a bridge write() must come from the task running loop().
+  // =====================================================================================
+
+  /**
+   * @brief Start the network task. Call once, after initCore().
+   *
+   * Message sizes in task mode:
+   *   • Publications and log lines up to HESTIA_TXQ_TOPIC_MAX / HESTIA_TXQ_PAYLOAD_MAX
+   *     travel inside the ring slot; larger ones take one heap copy, so the
+   *     streamed path of HestiaNet::publish() is reached as in single-loop mode
+   *   • Inbound commands up to HESTIA_RXQ_PAYLOAD_MAX likewise; larger ones are
+   *     copied to the heap, the real limit being "mqtt_rx_buffer"
+   *   • Only a failed heap copy loses a message (txOversize / rxDropped)
+   *
+   * @return false if the task could not be created (single-loop mode remains active).
+   */
+  bool startNetworkTask(int core = HESTIA_NET_TASK_CORE,
+                        uint32_t stackSize = HESTIA_NET_TASK_STACK,
+                        UBaseType_t priority = HESTIA_NET_TASK_PRIO);
+
+  /**
+   * @brief Stop the network task and return to single-loop mode (e.g. before OTA).
+   *
+   * Blocks until the task has left its loop (its network calls are bounded),
+   * so the client is never driven by two tasks.
+   */
+  void stopNetworkTask();
+
+  /**
+   * @brief True while the network task is running.
+   */
+  bool networkTaskRunning();
+
+  /**
+   * @brief Cross-task queue counters (since boot).
+   */
+  struct NetTaskStats {
+    uint32_t txDropped;    // App → network: log lines dropped, ring (nearly) full
+    uint32_t txDeferred;   // App → network: publications parked in the app-side backlog
+    uint32_t txOversize;   // App → network: larger than the slot and no heap for its copy
+    uint32_t rxDropped;    // Network → app: ring full, or larger than the slot and no heap
+  };
+
+  /**
+   * @brief loop() jitter, measured between successive CoreComm() calls.
+   */
+  struct LoopStats {
+    uint32_t calls;
+    uint32_t maxGapUs;     // Longest interval between two CoreComm() calls
+    uint32_t lastCallUs;
+  };
+
+  const NetTaskStats& netTaskStats();
+  const LoopStats&    loopStats();
+
+  /**
+   * @brief Print loop jitter and queue counters; optionally restart the jitter window.
+   */
+  void logLoopStats(bool reset = true);
+
   // =====================================================================================
   //  Communication State Indicators
   // =====================================================================================
@@ -194,9 +473,21 @@ namespace HestiaCore {
 
   /**
    * @brief Retrieve a bridge instance by its internal name.
+   *
+   * Linear scan over the registry. Prefer handles (handleOf / at) in loop().
    */
   HAIoTBridge* get(const String& name);
 
+  /**
+   * @brief Retrieve the bridge consuming an inbound topic (topicFrom).
+   *
+   * Constant-time lookup through the topic index built by
+   * RegisterEntitiesIotBridge(). Indicators are never returned.
+   *
+   * @return The matching bridge, or nullptr if no entity listens on @p topic.
+   */
+  HAIoTBridge* findByTopic(const String& topic);
+
   /**
    * @brief Initialize all registered entities (NVS restore + initial publish).
    */
@@ -230,7 +521,55 @@ namespace HestiaCore {
    *   • Using commOK() avoids deadlocks during HAInit() publishing.
    *   • This function MUST NOT wait for comm_state_ok.
    */
-  void publishToMQTT(const String &topic, const String &payload, bool logIt);
+  void publishToMQTT(const char* topic, const char* payload, bool logIt);
+
+  // =====================================================================================
+  //  Outbound MQTT Outbox
+  // -------------------------------------------------------------------------------------
+  //  publishToMQTT() only queues; CoreComm() drains the outbox after HestiaNet::loop(),
+  //  at most HESTIA_OUTBOX_BUDGET_MSGS messages or HESTIA_OUTBOX_BUDGET_US per tick.
+  //  A newer payload for a queued topic replaces the pending one.
+  // =====================================================================================
+
+  /**
+   * @brief Outbox counters (since boot).
+   */
+  struct OutboxStats {
+    uint32_t enqueued;        // publishToMQTT() calls
+    uint32_t coalesced;       // Replaced a pending payload for the same topic
+    uint32_t published;       // Handed to the MQTT client
+    uint32_t overflowInline;  // Published synchronously because the ring was full
+    uint32_t dropped;         // Lost because the ring was full while offline
+    uint32_t highWater;       // Highest number of pending entries observed
+  };
+
+  /**
+   * @brief Publish pending outbox entries within the per-tick budget.
+   *
+   * Called by CoreComm(); no-op unless commOK() and MQTT is connected.
+   */
+  void drainOutbox();
+
+  /**
+   * @brief Number of entries waiting in the outbox.
+   */
+  size_t outboxPending();
+
+  /**
+   * @brief Access the outbox counters.
+   */
+  const OutboxStats& outboxStats();
+
+  /**
+   * @brief Print the outbox counters to Serial.
+   */
+  void logOutboxStats();
+
+  /**
+   * @brief Print per-entity suppressed / forced publish counters
+   *        (deadband, minIntervalMs, maxSilenceMs — see BridgeConfig).
+   */
+  void logPublishStats();
 
   // =====================================================================================
   //  logBook — Centralized logger
@@ -274,6 +613,27 @@ namespace HestiaCore {
    */
   void loadBridgeConfig(const BridgeConfig* table, size_t count);
 
+  /**
+   * @brief Inbound topic index precomputed at build time (tools/gen_mapping.py).
+   *
+   * slots[fnv1a(topicFrom, seed) & (slotCount - 1)] holds the bridge_config[]
+   * row of every inbound topic, collision-free: one probe per message.
+   */
+  struct TopicIndex {
+    const uint16_t* slots;       ///< slotCount entries (power of two), 0xFFFF = empty
+    size_t          slotCount;
+    uint32_t        seed;        ///< FNV-1a seed giving the perfect hash
+  };
+
+  /**
+   * @brief Use a generated topic index instead of building one at boot.
+   *
+   * Call before initCore(). The table is checked against the registry when
+   * entities are registered; a stale one is logged and replaced by the
+   * runtime-built index.
+   */
+  void setTopicIndex(const TopicIndex* index);
+
   void HAInit();
 
 } // namespace HestiaCore
@@ -0,0 +1,145 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*****************************************************************************************
+ *  File     : HestiaFixed.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Decimal text ↔ fixed-point integer conversions behind HAIoTBridge's typed
+ *  slots (an entity with resolution 0.1 holds 21.5 as 215):
+ *    • parseScaled()  "21.46" → 215 at 1 decimal, no float on the way
+ *    • formatScaled() 215 → "21.5", digits written right to left
+ *    • rescale()      change precision, rounding half away from zero,
+ *                     reporting int32 overflow
+ *
+ *  Design Principles
+ *  -----------------
+ *    • Integer math only, no heap, no String — safe from any task
+ *    • Dependency-free so the same code is host-compiled by test/host
+ *
+ *****************************************************************************************/
+
+namespace HestiaFixed {
+
+  /**
+   * @brief Highest precision (int32 range ±2147.483647 at 6 decimals).
+   */
+  static constexpr uint8_t MAX_DECIMALS = 6;
+
+  /**
+   * @brief formatScaled() buffer size: sign + 10 digits + point + NUL.
+   */
+  static constexpr size_t FMT_BUF = 16;
+
+  static constexpr int32_t POW10[MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+  };
+
+  /**
+   * @brief Parse a decimal string into an integer scaled by 10^@p dec.
+   *
+   * Rules:
+   *   • optional leading '-'
+   *   • at most one '.'
+   *   • must contain at least one digit
+   *   • extra decimals are rounded half away from zero
+   *
+   * Examples (dec = 1): "21.46" → 215, "-0.04" → 0, "7" → 70
+   *
+   * @return false if the string is not a decimal or overflows int32.
+   */
+  inline bool parseScaled(const char* s, uint8_t dec, int32_t& out) {
+    if (!s || dec > MAX_DECIMALS) return false;
+
+    bool neg = false;
+    if (*s == '-') { neg = true; ++s; }
+
+    int64_t acc = 0;
+    uint8_t frac = 0;
+    int     roundDigit = -1;
+    bool    pointSeen = false, digitSeen = false;
+
+    for (; *s; ++s) {
+      char c = *s;
+      if (c == '.') {
+        if (pointSeen) return false;
+        pointSeen = true;
+        continue;
+      }
+      if (c < '0' || c > '9') return false;
+      digitSeen = true;
+
+      if (!pointSeen || frac < dec) {
+        acc = acc * 10 + (c - '0');
+        if (pointSeen) frac++;
+        if (acc > INT32_MAX) return false;
+      } else if (roundDigit < 0) {
+        roundDigit = c - '0';
+      }
+    }
+    if (!digitSeen) return false;
+
+    acc *= POW10[dec - frac];
+    if (roundDigit >= 5) acc++;
+    if (acc > INT32_MAX) return false;
+
+    out = (int32_t)(neg ? -acc : acc);
+    return true;
+  }
+
+  /**
+   * @brief Format a scaled integer with @p dec decimals.
+   *
+   * @param buf  FMT_BUF bytes; filled from the end.
+   * @return Pointer into @p buf.
+   */
+  inline const char* formatScaled(int32_t num, uint8_t dec, char* buf) {
+    char* p = buf + FMT_BUF - 1;
+    *p = '\0';
+
+    uint32_t a = (num < 0) ? (uint32_t)(-(int64_t)num) : (uint32_t)num;
+    for (uint8_t i = 0; i < dec; ++i) {
+      *--p = (char)('0' + a % 10);
+      a /= 10;
+    }
+    if (dec) *--p = '.';
+    do {
+      *--p = (char)('0' + a % 10);
+      a /= 10;
+    } while (a);
+    if (num < 0) *--p = '-';
+    return p;
+  }
+
+  /**
+   * @brief Rescale a fixed-point integer from @p from to @p to decimals.
+   *
+   * Computed in int64, rounding half away from zero.
+   *
+   * @param out  Result; saturated at INT32_MIN / INT32_MAX when it does not fit.
+   * @return false if the result overflows int32 (e.g. 300000 at 0 → 4 decimals).
+   */
+  inline bool rescale(int32_t num, uint8_t from, uint8_t to, int32_t& out) {
+    if (from > MAX_DECIMALS) from = MAX_DECIMALS;
+    if (to   > MAX_DECIMALS) to   = MAX_DECIMALS;
+
+    int64_t v = num;
+    if (to > from) {
+      v *= POW10[to - from];
+    } else if (from > to) {
+      int64_t div  = POW10[from - to];
+      int64_t half = div / 2;
+      v = (v >= 0) ? (v + half) / div : (v - half) / div;
+    }
+
+    if (v > INT32_MAX) { out = INT32_MAX; return false; }
+    if (v < INT32_MIN) { out = INT32_MIN; return false; }
+    out = (int32_t)v;
+    return true;
+  }
+
+} // namespace HestiaFixed
+// ============================================================================
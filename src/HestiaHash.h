@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*****************************************************************************************
+ *  File     : HestiaHash.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Small, dependency-free string hashing shared by the SDK lookup tables:
+ *    • 32-bit FNV-1a over C strings or (pointer, length) spans
+ *    • constexpr evaluation, so keys known at build time hash to constants
+ *
+ *  Design Principles
+ *  -----------------
+ *    • Hashes are used as table indices only — every hit is confirmed by a
+ *      full key comparison, collisions are never treated as matches
+ *    • No heap, no String, safe to call from any task
+ *
+ *****************************************************************************************/
+
+namespace HestiaHash {
+
+  static constexpr uint32_t FNV_OFFSET = 2166136261u;
+  static constexpr uint32_t FNV_PRIME  = 16777619u;
+
+  /**
+   * @brief FNV-1a hash of a null-terminated string.
+   *
+   * @param s     String to hash (nullptr hashes like "").
+   * @param seed  Initial value; change it to derive an independent hash family.
+   */
+  constexpr uint32_t fnv1a(const char* s, uint32_t seed = FNV_OFFSET) {
+    uint32_t h = seed;
+    while (s && *s) {
+      h ^= (uint8_t)*s++;
+      h *= FNV_PRIME;
+    }
+    return h;
+  }
+
+  /**
+   * @brief FNV-1a hash of a byte span (not required to be null-terminated).
+   */
+  constexpr uint32_t fnv1aSpan(const char* s, size_t len, uint32_t seed = FNV_OFFSET) {
+    uint32_t h = seed;
+    for (size_t i = 0; i < len; ++i) {
+      h ^= (uint8_t)s[i];
+      h *= FNV_PRIME;
+    }
+    return h;
+  }
+
+} // namespace HestiaHash
+// ============================================================================
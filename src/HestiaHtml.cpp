@@ -0,0 +1,148 @@
+#include "HestiaHtml.h"
+#include "HestiaWebAssets.h"
+
+namespace HestiaHtml {
+
+    // =====================================================================================
+    //  Constructor — status line and headers, body follows in chunks
+    // =====================================================================================
+    ChunkedPage::ChunkedPage(WebServer& server, const char* tag,
+                             const char* contentType, int code)
+        : _server(server),
+          _tag(tag),
+          _heapStart(ESP.getFreeHeap()),
+          _heapMin(_heapStart)
+    {
+        _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server.send(code, contentType, "");
+        sampleHeap();
+    }
+
+    // =====================================================================================
+    //  add() — append to the chunk buffer, sending full chunks as they fill
+    // =====================================================================================
+    ChunkedPage& ChunkedPage::add(const char* s) {
+        return s ? add(s, strlen(s)) : *this;
+    }
+
+    ChunkedPage& ChunkedPage::add(const char* s, size_t len) {
+        while (len) {
+            size_t room = sizeof(_buf) - _len;
+            size_t n = (len < room) ? len : room;
+            memcpy(_buf + _len, s, n);
+            _len += n;
+            s    += n;
+            len  -= n;
+            if (_len == sizeof(_buf)) flush();
+        }
+        return *this;
+    }
+
+    ChunkedPage& ChunkedPage::add(long v) {
+        char num[12];
+        int n = snprintf(num, sizeof(num), "%ld", v);
+        return add(num, (size_t)n);
+    }
+
+    ChunkedPage& ChunkedPage::add(double v) {
+        char num[24];
+        int n = snprintf(num, sizeof(num), "%.9g", v);
+        return add(num, (size_t)n);
+    }
+
+    ChunkedPage& ChunkedPage::addJson(const char* s) {
+        add('"');
+        for (; s && *s; ++s) {
+            char c = *s;
+            if (c == '"' || c == '\\') {
+                add('\\');
+                add(c);
+            } else if ((uint8_t)c < 0x20) {
+                char esc[7];
+                snprintf(esc, sizeof(esc), "\\u%04x", (unsigned)(uint8_t)c);
+                add(esc, 6);
+            } else {
+                add(c);
+            }
+        }
+        return add('"');
+    }
+
+    // =====================================================================================
+    //  addStatic() — flash block sent as its own chunk, never copied to RAM
+    // =====================================================================================
+    ChunkedPage& ChunkedPage::addStatic(PGM_P block) {
+        flush();
+        size_t len = strlen_P(block);
+        if (len) {
+            _server.sendContent_P(block, len);
+            _total += len;
+            _chunks++;
+            sampleHeap();
+        }
+        return *this;
+    }
+
+    // =====================================================================================
+    //  end() — terminating zero-length chunk + serving report
+    // =====================================================================================
+    void ChunkedPage::end() {
+        if (_ended) return;
+        _ended = true;
+
+        flush();
+        _server.sendContent("");   // 0-length chunk closes the response
+
+        Serial.printf("%s Page streamed: %u bytes in %u chunk(s), heap dip %u bytes\n",
+                      _tag,
+                      (unsigned)_total,
+                      (unsigned)_chunks,
+                      (unsigned)(_heapStart > _heapMin ? _heapStart - _heapMin : 0));
+    }
+
+    void ChunkedPage::flush() {
+        if (!_len) return;
+        _server.sendContent(_buf, _len);
+        _total += _len;
+        _chunks++;
+        _len = 0;
+        sampleHeap();
+    }
+
+    void ChunkedPage::sampleHeap() {
+        uint32_t h = ESP.getFreeHeap();
+        if (h < _heapMin) _heapMin = h;
+    }
+
+    // =====================================================================================
+    //  Static assets — gzip body straight from flash, revalidation by ETag
+    // =====================================================================================
+    static void serveAsset(WebServer& server, const Asset& a) {
+        server.sendHeader("ETag", a.etag);
+        server.sendHeader("Cache-Control", "public, max-age=" + String(HESTIA_ASSET_MAX_AGE) + ", immutable");
+
+        if (server.header("If-None-Match") == a.etag) {
+            server.send(304);
+            return;
+        }
+
+        server.sendHeader("Content-Encoding", "gzip");
+        server.send_P(200, a.mime, (PGM_P)a.gz, a.len);
+    }
+
+    void registerAssets(WebServer& server, const Asset* table, size_t count) {
+        static const char* headerKeys[] = { "If-None-Match" };
+        server.collectHeaders(headerKeys, 1);
+
+        for (size_t i = 0; i < count; ++i) {
+            const Asset* a = &table[i];
+            server.on(a->path, HTTP_GET, [&server, a]() { serveAsset(server, *a); });
+        }
+    }
+
+    void registerBuiltinAssets(WebServer& server) {
+        registerAssets(server, HESTIA_WEB_ASSETS, HESTIA_WEB_ASSET_COUNT);
+    }
+
+} // namespace HestiaHtml
+// ============================================================================
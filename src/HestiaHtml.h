@@ -0,0 +1,115 @@
+#pragma once
+#include <Arduino.h>
+#include <WebServer.h>
+
+/*****************************************************************************************
+ *  File     : HestiaHtml.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Chunked HTML page writer for the SDK web UIs (provisioning portal, OTA):
+ *    • Response sent with Transfer-Encoding: chunked (CONTENT_LENGTH_UNKNOWN)
+ *    • Dynamic fragments are packed into one small fixed buffer
+ *    • Static blocks (PROGMEM / string literals) go out directly from flash
+ *    • Precompressed assets (CSS/JS from web/, tools/embed_assets.py) served
+ *      with Content-Encoding: gzip, ETag / 304 and immutable caching
+ *
+ *  Design Principles
+ *  -----------------
+ *    • No String page accumulation: peak heap no longer grows with the page size
+ *    • One buffer per page, on the handler's stack — no heap allocation
+ *    • Heap dip observed while serving is logged, to keep the claim checked
+ *
+ *****************************************************************************************/
+
+#ifndef HESTIA_HTML_CHUNK
+#define HESTIA_HTML_CHUNK 512   // Bytes buffered before a chunk is sent
+#endif
+
+#ifndef HESTIA_ASSET_MAX_AGE
+#define HESTIA_ASSET_MAX_AGE 31536000   // Seconds; asset URLs carry a content hash
+#endif
+
+namespace HestiaHtml {
+
+  // ============================================================================
+  //  Asset — one gzip-compressed static file in flash (generated table)
+  // ============================================================================
+  struct Asset {
+    const char*    path;   ///< URL, content hash included (e.g. "/hs/prov.1a2b3c4d.css")
+    const char*    mime;   ///< Content-Type
+    const uint8_t* gz;     ///< gzip data (PROGMEM)
+    size_t         len;    ///< gzip length in bytes
+    const char*    etag;   ///< Quoted ETag
+  };
+
+  /**
+   * @brief Register one GET route per asset on @p server.
+   *
+   * Must be called before server.begin() (it also asks the server to keep
+   * the If-None-Match request header).
+   */
+  void registerAssets(WebServer& server, const Asset* table, size_t count);
+
+  /**
+   * @brief Register the SDK's built-in web assets (HestiaWebAssets.cpp).
+   */
+  void registerBuiltinAssets(WebServer& server);
+
+
+  class ChunkedPage {
+  public:
+    /**
+     * @brief Start a chunked response (status line + headers sent here).
+     *
+     * @param server       Server handling the current request.
+     * @param tag          Log prefix, e.g. "[Provisioning]".
+     * @param contentType  MIME type (defaults to UTF-8 HTML).
+     */
+    ChunkedPage(WebServer& server, const char* tag,
+                const char* contentType = "text/html; charset=utf-8", int code = 200);
+
+    ~ChunkedPage() { end(); }
+
+    ChunkedPage(const ChunkedPage&) = delete;
+    ChunkedPage& operator=(const ChunkedPage&) = delete;
+
+    // ---- Dynamic content (buffered) ----
+    ChunkedPage& add(const char* s);
+    ChunkedPage& add(const char* s, size_t len);
+    ChunkedPage& add(const String& s) { return add(s.c_str(), s.length()); }
+    ChunkedPage& add(char c)          { return add(&c, 1); }
+    ChunkedPage& add(long v);
+    ChunkedPage& add(int v)           { return add((long)v); }
+    ChunkedPage& add(double v);
+
+    // ---- JSON string literal: quoted, with control chars / quotes escaped ----
+    ChunkedPage& addJson(const char* s);
+
+    // ---- Static block from flash: flushes the buffer, then sends in place ----
+    ChunkedPage& addStatic(PGM_P block);
+
+    /**
+     * @brief Flush, send the terminating chunk and log size / heap dip.
+     * Called by the destructor if not done explicitly.
+     */
+    void end();
+
+  private:
+    void flush();
+    void sampleHeap();
+
+    WebServer&  _server;
+    const char* _tag;
+    char        _buf[HESTIA_HTML_CHUNK];
+    size_t      _len      = 0;
+    size_t      _total    = 0;
+    uint16_t    _chunks   = 0;
+    uint32_t    _heapStart;
+    uint32_t    _heapMin;
+    bool        _ended    = false;
+  };
+
+} // namespace HestiaHtml
+// ============================================================================
@@ -1,6 +1,13 @@
 #include <Arduino.h>
+#include <Preferences.h>
+#include <atomic>
+#include <vector>
+#include "lwip/sockets.h"
+#include "lwip/dns.h"
+#include "lwip/tcpip.h"
 #include "HestiaNetSDK.h"
 #include "HestiaCore.h"     // Required for forwarding incoming messages
+#include "HestiaHash.h"     // Discovery change detection
 
 
 
@@ -10,7 +17,6 @@
 // Global network objects owned by the HestiaNetSDK module
 // -------------------------------------------------------------
 WiFiClient net;
-MQTTClient client(256);
 
 
 namespace HestiaNet {
@@ -34,11 +40,68 @@ namespace HestiaNet {
     return out;
   }
 
+  // Sanitized hostname, recomputed only when the configuration changes
+  static const String& hostnameFor(const HestiaConfig::NetSnapshot& cfg) {
+    static String   host;
+    static uint32_t gen = 0;
+    static bool     valid = false;
+    if (!valid || gen != cfg.generation) {
+      host  = sanitizeHostname(cfg.deviceId);
+      gen   = cfg.generation;
+      valid = true;
+    }
+    return host;
+  }
+
+  // =============================================================
+  //  MQTT client — built on first use, with its final buffer sizes
+  // =============================================================
+
+  // The read buffer is fixed at construction and comes from "mqtt_rx_buffer":
+  // the first call (tryMQTTConnectNonBlocking(), after the configuration is
+  // loaded) decides it once.
+  static int rxBufferSize() {
+    uint32_t rx = HestiaConfig::mqttSnapshot().rxBuffer;
+    return (int)(rx ? rx : HESTIA_MQTT_RX_BUFFER);
+  }
+
+  MQTTClient& mqttClient() {
+    static MQTTClient c(rxBufferSize(), HESTIA_MQTT_TX_BUFFER);
+    return c;
+  }
+
+  // =============================================================
+  //  MQTT size counters (see MQTT Publishing)
+  // =============================================================
+  static MqttStats g_mqttStats = {};
+  static uint32_t  g_rxTooShort = 0;   // Sessions closed by lwmqtt on LWMQTT_BUFFER_TOO_SHORT
+
+  // Streamed PUBLISH in flight: header, topic, payload, each sent as the socket allows
+  struct StreamSeg {
+    const uint8_t* p = nullptr;
+    size_t         n = 0;
+  };
+
+  struct StreamState {
+    bool      active = false;
+    uint8_t   hdr[7];
+    StreamSeg seg[3];                 // header, topic, payload (remaining bytes)
+    String    topic;
+    String    payload;                // Copied only when the packet spans ticks
+    uint32_t  lastProgress = 0;
+  };
+
+  static StreamState g_stream;
+
+  static void abandonStream();
+
   // =============================================================
   //  Runtime configuration (loaded from HestiaConfig)
   // =============================================================
 
   static const char* g_discoveryJson = nullptr;
+  static const DiscoveryEntry* g_discoveryTable = nullptr;
+  static size_t g_discoveryCount = 0;
 
   /**
    * @brief Register the Home Assistant Discovery JSON block.
@@ -52,12 +115,132 @@ namespace HestiaNet {
     Serial.println(F("=== [HestiaNet] Discovery JSON loaded. ==="));
   }
 
+  /**
+   * @brief Register a pre-serialized discovery table (tools/gen_discovery.py).
+   *
+   * Only the pointer is stored; entries and strings stay in flash.
+   */
+  void loadDiscoveryTable(const DiscoveryEntry* table, size_t count) {
+    g_discoveryTable = table;
+    g_discoveryCount = table ? count : 0;
+    Serial.printf("=== [HestiaNet] Discovery table loaded (%u entries). ===\n", (unsigned)g_discoveryCount);
+  }
+
+  /**
+   * @brief Build the network configuration snapshots once at boot.
+   *
+   * The guards read HestiaConfig::netSnapshot() / mqttSnapshot() on every tick;
+   * those are rebuilt lazily after a configuration change, so this call only
+   * moves the first build out of the communication loop.
+   */
+  void loadConfig() {
+    const HestiaConfig::NetSnapshot&  wifi = HestiaConfig::netSnapshot();
+    const HestiaConfig::MqttSnapshot& mqtt = HestiaConfig::mqttSnapshot();
+    Serial.printf("=== [HestiaNet] Config loaded: SSID '%s', broker %s:%u (gen %lu) ===\n",
+                  wifi.ssid.c_str(), mqtt.host.c_str(), (unsigned)mqtt.port,
+                  (unsigned long)mqtt.generation);
+  }
+
 
   // ------------------------------------------------------------------------------------
   // Module-level State
   // ------------------------------------------------------------------------------------
   bool mqttFlush = false;
 
+  // ------------------------------------------------------------------------------------
+  // Wi-Fi diagnostic scan — asynchronous, polled by the Wi-Fi Guard
+  // ------------------------------------------------------------------------------------
+  static constexpr unsigned long WIFI_SCAN_PERIOD_MS  = 30000;  // Min interval between scans
+  static constexpr unsigned long WIFI_SCAN_TIMEOUT_MS = 10000;  // Abandon a stuck scan
+  static constexpr uint8_t       WIFI_HINT_TRIES      = 3;      // Attempts using channel/BSSID
+
+  enum class ScanState : uint8_t { IDLE, RUNNING };
+
+  static struct {
+    ScanState     state      = ScanState::IDLE;
+    unsigned long startedAt  = 0;
+    unsigned long lastScan   = 0;
+    bool          ssidVisible = true;
+
+    // Connect hint from the last scan (strongest AP advertising the SSID)
+    bool          hintValid  = false;
+    uint8_t       hintTries  = 0;
+    int32_t       channel    = 0;
+    uint8_t       bssid[6]   = {};
+  } g_scan;
+
+  /**
+   * @brief Start the diagnostic scan without waiting for its result.
+   */
+  static void startWiFiScan() {
+    WiFi.scanDelete();
+    int16_t rc = WiFi.scanNetworks(true /*async*/, false /*show_hidden*/);
+    g_scan.lastScan = millis();
+
+    if (rc == WIFI_SCAN_FAILED) {
+      Serial.println(F("[HestiaNet | WiFi] ⚠ Scan could not be started"));
+      return;
+    }
+
+    Serial.println(F("[HestiaNet | WiFi] 🔍 Scanning networks after repeated failures..."));
+    g_scan.state     = ScanState::RUNNING;
+    g_scan.startedAt = millis();
+  }
+
+  /**
+   * @brief Poll a running scan once; record SSID visibility and the connect hint.
+   *
+   * @return true while the scan is still in progress.
+   */
+  static bool pollWiFiScan(const String& ssid) {
+    int16_t n = WiFi.scanComplete();
+
+    if (n == WIFI_SCAN_RUNNING) {
+      if (millis() - g_scan.startedAt < WIFI_SCAN_TIMEOUT_MS) return true;
+      Serial.println(F("[HestiaNet | WiFi] ⚠ Scan timeout — abandoned"));
+      n = WIFI_SCAN_FAILED;
+    }
+
+    g_scan.state    = ScanState::IDLE;
+    g_scan.lastScan = millis();
+
+    if (n < 0) {
+      // No verdict: keep trying to connect rather than waiting 30 s blind
+      g_scan.ssidVisible = true;
+      WiFi.scanDelete();
+      return false;
+    }
+
+    int best = -1;
+    for (int i = 0; i < n; i++) {
+      if (WiFi.SSID(i).equals(ssid) && (best < 0 || WiFi.RSSI(i) > WiFi.RSSI(best))) {
+        best = i;
+      }
+    }
+
+    g_scan.ssidVisible = (best >= 0);
+    g_scan.hintValid   = false;
+
+    if (best >= 0) {
+      const uint8_t* bssid = WiFi.BSSID(best);
+      if (bssid) {
+        memcpy(g_scan.bssid, bssid, sizeof(g_scan.bssid));
+        g_scan.channel   = WiFi.channel(best);
+        g_scan.hintValid = true;
+        g_scan.hintTries = 0;
+      }
+      Serial.printf("[HestiaNet | WiFi] ✓ SSID '%s' found (RSSI=%d dBm, channel=%d, BSSID=%s)\n",
+                    ssid.c_str(), WiFi.RSSI(best), WiFi.channel(best),
+                    WiFi.BSSIDstr(best).c_str());
+    } else {
+      Serial.printf("[HestiaNet | WiFi] ⚠ SSID '%s' not found — retry in 30 s\n",
+                    ssid.c_str());
+    }
+
+    WiFi.scanDelete();
+    return false;
+  }
+
 
   /*****************************************************************************************
    *  WiFi Guard — tryWiFiConnectNonBlocking_V2()
@@ -65,7 +248,7 @@ namespace HestiaNet {
    *  Purpose:
    *    Non-blocking Wi-Fi connection routine with:
    *      • exponential backoff,
-   *      • SSID presence validation (scan-on-failure),
+   *      • SSID presence validation (asynchronous scan-on-failure),
    *      • stateful retry counters,
    *      • driver resets every 5 seconds,
    *      • hostname assignment from device_id.
@@ -87,12 +270,8 @@ namespace HestiaNet {
     static bool connecting           = false;
     static bool stationPrepared      = false;
 
-    static bool ssidVisible          = true;
-    static unsigned long lastScan    = 0;
-
-    String cfgwifi_ssid = HestiaConfig::getParam("wifi_ssid");
-    String cfgwifi_pass = HestiaConfig::getParam("wifi_pass");
-    if (cfgwifi_ssid.length() == 0 || cfgwifi_pass.length() == 0) {
+    const HestiaConfig::NetSnapshot& cfg = HestiaConfig::netSnapshot();
+    if (cfg.ssid.length() == 0 || cfg.pass.length() == 0) {
       Serial.println(F("[HestiaNet | WiFi] ✖ Missing wifi_ssid or wifi_pass in config"));
       return false;
     }
@@ -106,17 +285,17 @@ namespace HestiaNet {
       tryCount  = 0;
       delayNext = 100;
       connecting = false;
+      g_scan.hintTries = 0;
       return true;
     }
 
     if (!stationPrepared) {
 
 
-      String cfgdevice_id = HestiaConfig::getParam("device_id");
-      String host = sanitizeHostname(cfgdevice_id);
+      const String& host = hostnameFor(cfg);
       bool hostOk = WiFi.setHostname(host.c_str());
       Serial.printf("[HestiaNet | WiFi] Hostname cfg='%s' effective='%s' (%s)\n",
-                    cfgdevice_id.c_str(), host.c_str(), hostOk ? "ok" : "failed");
+                    cfg.deviceId.c_str(), host.c_str(), hostOk ? "ok" : "failed");
 
       WiFi.mode(WIFI_STA);
       WiFi.setSleep(false);
@@ -124,60 +303,48 @@ namespace HestiaNet {
     }
 
     // ---------------------------------------------------------------------
-    // 2️⃣ Avoid scanning too often if the SSID was previously missing
+    // 2️⃣ Diagnostic scan in progress → poll it, never wait for it
     // ---------------------------------------------------------------------
-    if (!ssidVisible && millis() - lastScan < 30000) {
-      return false;
+    if (g_scan.state == ScanState::RUNNING) {
+      if (pollWiFiScan(cfg.ssid)) return false;
+      if (!g_scan.ssidVisible) return false;
+      tryCount = 0;
     }
 
     // ---------------------------------------------------------------------
-    // 3️⃣ After repeated failures, perform a diagnostic network scan
+    // 3️⃣ Avoid scanning too often if the SSID was previously missing
     // ---------------------------------------------------------------------
-    if (tryCount >= 5 && millis() - lastScan > 30000) {
-
-      Serial.println(F("[HestiaNet | WiFi] 🔍 Scanning networks after repeated failures..."));
-
-      int n = WiFi.scanNetworks();
-      lastScan = millis();
-      ssidVisible = false;
-
-      for (int i = 0; i < n; i++) {
-        if (WiFi.SSID(i).equals(cfgwifi_ssid)) {
-          ssidVisible = true;
-          Serial.printf("[HestiaNet | WiFi] ✓ SSID '%s' found (RSSI=%d dBm, channel=%d)\n",
-                        cfgwifi_ssid.c_str(), WiFi.RSSI(i), WiFi.channel(i));
-          break;
-        }
-      }
-
-      if (!ssidVisible) {
-        Serial.printf("[HestiaNet | WiFi] ⚠ SSID '%s' not found — retry in 30 s\n",
-                      cfgwifi_ssid.c_str());
-        return false;
-      }
+    if (!g_scan.ssidVisible && millis() - g_scan.lastScan < WIFI_SCAN_PERIOD_MS) {
+      return false;
+    }
 
-      tryCount = 0;
+    // ---------------------------------------------------------------------
+    // 4️⃣ After repeated failures, start an asynchronous diagnostic scan
+    // ---------------------------------------------------------------------
+    if ((tryCount >= 5 || !g_scan.ssidVisible) &&
+        millis() - g_scan.lastScan > WIFI_SCAN_PERIOD_MS) {
+      startWiFiScan();
+      if (g_scan.state == ScanState::RUNNING) return false;
     }
 
     // ---------------------------------------------------------------------
-    // 4️⃣ Anti-spam protection
+    // 5️⃣ Anti-spam protection
     // ---------------------------------------------------------------------
     if (connecting && (millis() - lastAttempt < 8000)) return false;
     if (millis() - lastAttempt < delayNext) return false;
 
     // ---------------------------------------------------------------------
-    // 5️⃣ Low-level Wi-Fi driver reset
+    // 6️⃣ Low-level Wi-Fi driver reset
     // ---------------------------------------------------------------------
     if (millis() - lastReset > 5000) {
       Serial.printf("[HestiaNet | WiFi] Attempt %u...\n", tryCount + 1);
 
       WiFi.disconnect(false, false);
       delay(50);
-      String cfgdevice_id = HestiaConfig::getParam("device_id");
-      String host = sanitizeHostname(cfgdevice_id);
+      const String& host = hostnameFor(cfg);
       bool hostOk = WiFi.setHostname(host.c_str());
       Serial.printf("[HestiaNet | WiFi] Hostname cfg='%s' effective='%s' (%s)\n",
-                    cfgdevice_id.c_str(), host.c_str(), hostOk ? "ok" : "failed");
+                    cfg.deviceId.c_str(), host.c_str(), hostOk ? "ok" : "failed");
 
       WiFi.mode(WIFI_STA);
       WiFi.setSleep(false);
@@ -186,14 +353,24 @@ namespace HestiaNet {
     }
 
     // ---------------------------------------------------------------------
-    // 6️⃣ Start a new connection attempt
+    // 7️⃣ Start a new connection attempt
+    //    With a fresh scan hint, skip the driver's own channel sweep by
+    //    targeting the strongest AP directly; fall back to a plain begin()
+    //    if the hinted AP keeps failing.
     // ---------------------------------------------------------------------
-    Serial.println(cfgwifi_ssid);
-    WiFi.begin(cfgwifi_ssid.c_str(), cfgwifi_pass.c_str());
+    Serial.println(cfg.ssid);
+    if (g_scan.hintValid && g_scan.hintTries < WIFI_HINT_TRIES) {
+      g_scan.hintTries++;
+      Serial.printf("[HestiaNet | WiFi] Using scan hint: channel %d\n", (int)g_scan.channel);
+      WiFi.begin(cfg.ssid.c_str(), cfg.pass.c_str(), g_scan.channel, g_scan.bssid);
+    } else {
+      g_scan.hintValid = false;
+      WiFi.begin(cfg.ssid.c_str(), cfg.pass.c_str());
+    }
     connecting = true;
 
     // ---------------------------------------------------------------------
-    // 7️⃣ Exponential backoff + jitter
+    // 8️⃣ Exponential backoff + jitter
     // ---------------------------------------------------------------------
     tryCount++;
     delayNext = (tryCount <= 5)
@@ -203,7 +380,7 @@ namespace HestiaNet {
     lastAttempt = millis();
 
     // ---------------------------------------------------------------------
-    // 8️⃣ Diagnostics
+    // 9️⃣ Diagnostics
     // ---------------------------------------------------------------------
     switch (st) {
       case WL_NO_SSID_AVAIL:
@@ -266,6 +443,234 @@ namespace HestiaNet {
   }
 
 
+  /*****************************************************************************************
+   *  MQTT Transport — asynchronous DNS + non-blocking TCP connect
+   *
+   *  Purpose:
+   *    Bring the broker socket up without ever waiting on the network:
+   *      RESOLVING  → lwIP dns_gethostbyname() issued on the tcpip thread,
+   *                   completion reported through a callback (IP literals skip it)
+   *      CONNECTING → non-blocking lwIP connect(), polled with a zero-timeout select()
+   *      READY      → socket handed to WiFiClient `net`; the MQTT client then sends
+   *                   CONNECT on it with client.connect(..., skip = true)
+   *
+   *  The resolved address is cached per host for MQTT_DNS_TTL_MS and dropped as soon
+   *  as a TCP connect to it fails.
+   *****************************************************************************************/
+  static constexpr unsigned long MQTT_DNS_TIMEOUT_MS = 5000;
+  static constexpr unsigned long MQTT_TCP_TIMEOUT_MS = 5000;
+  static constexpr unsigned long MQTT_DNS_TTL_MS     = 600000;
+
+  enum class LinkState : uint8_t { IDLE, RESOLVING, CONNECTING };
+  enum class LinkResult : uint8_t { PENDING, READY, FAILED };
+
+  static struct {
+    LinkState     state     = LinkState::IDLE;
+    String        host;
+    uint16_t      port      = 0;
+    unsigned long startedAt = 0;
+    int           fd        = -1;
+
+    // DNS cache
+    String        cachedHost;
+    IPAddress     cachedIp;
+    unsigned long resolvedAt = 0;
+    bool          cacheValid = false;
+  } g_link;
+
+  // DNS completion, written from the tcpip thread. The generation number lets
+  // a late callback from an abandoned lookup be ignored.
+  enum : uint8_t { DNS_IDLE, DNS_PENDING, DNS_DONE, DNS_FAILED };
+  static std::atomic<uint8_t>  g_dnsState{DNS_IDLE};
+  static std::atomic<uint32_t> g_dnsGen{0};
+  static uint32_t              g_dnsAddr = 0;
+  static char                  g_dnsHost[64];
+
+  static void dnsFound(const char*, const ip_addr_t* addr, void* arg) {
+    if ((uint32_t)(uintptr_t)arg != g_dnsGen.load()) return;
+    if (addr && IP_IS_V4(addr)) {
+      g_dnsAddr = ip_2_ip4(addr)->addr;
+      g_dnsState.store(DNS_DONE);
+    } else {
+      g_dnsState.store(DNS_FAILED);
+    }
+  }
+
+  // Runs on the tcpip thread (lwIP DNS API is not thread-safe)
+  static void dnsStart(void* arg) {
+    ip_addr_t addr;
+    err_t err = dns_gethostbyname(g_dnsHost, &addr, dnsFound, arg);
+    if (err == ERR_OK) {
+      dnsFound(g_dnsHost, &addr, arg);
+    } else if (err != ERR_INPROGRESS) {
+      g_dnsState.store(DNS_FAILED);
+    }
+  }
+
+  static void closeLinkSocket() {
+    if (g_link.fd >= 0) {
+      lwip_close(g_link.fd);
+      g_link.fd = -1;
+    }
+  }
+
+  static void abortLink() {
+    closeLinkSocket();
+    g_dnsGen.fetch_add(1);            // Orphan any lookup in flight
+    g_dnsState.store(DNS_IDLE);
+    g_link.state = LinkState::IDLE;
+  }
+
+  static bool startTcp(const IPAddress& ip) {
+    int fd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) return false;
+
+    lwip_fcntl(fd, F_SETFL, lwip_fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_port        = htons(g_link.port);
+    sa.sin_addr.s_addr = (uint32_t)ip;
+
+    int rc = lwip_connect(fd, (struct sockaddr*)&sa, sizeof(sa));
+    if (rc < 0 && errno != EINPROGRESS) {
+      lwip_close(fd);
+      return false;
+    }
+
+    g_link.fd        = fd;
+    g_link.state     = LinkState::CONNECTING;
+    g_link.startedAt = millis();
+    return true;
+  }
+
+  /**
+   * @brief Begin a transport attempt towards host:port (never blocks).
+   */
+  static void startLink(const String& host, uint16_t port) {
+    abortLink();
+    g_link.host = host;
+    g_link.port = port;
+
+    IPAddress ip;
+    if (ip.fromString(host)) {
+      if (!startTcp(ip)) g_link.state = LinkState::IDLE;
+      return;
+    }
+
+    bool cacheHit = g_link.cacheValid && g_link.cachedHost == host &&
+                    (millis() - g_link.resolvedAt) < MQTT_DNS_TTL_MS;
+    if (cacheHit) {
+      if (!startTcp(g_link.cachedIp)) g_link.state = LinkState::IDLE;
+      return;
+    }
+
+    if (host.length() >= sizeof(g_dnsHost)) {
+      Serial.println(F("[HestiaNet | MQTT] ✖ Broker hostname too long"));
+      return;
+    }
+    strcpy(g_dnsHost, host.c_str());
+
+    uint32_t gen = g_dnsGen.fetch_add(1) + 1;
+    g_dnsState.store(DNS_PENDING);
+    if (tcpip_callback(dnsStart, (void*)(uintptr_t)gen) != ERR_OK) {
+      g_dnsState.store(DNS_IDLE);
+      return;
+    }
+
+    g_link.state     = LinkState::RESOLVING;
+    g_link.startedAt = millis();
+  }
+
+  /**
+   * @brief Advance the transport attempt by one non-blocking step.
+   *
+   * @return READY once the socket is connected and owned by `net`.
+   */
+  static LinkResult serviceLink(uint32_t sendTimeoutMs) {
+
+    if (g_link.state == LinkState::IDLE) return LinkResult::FAILED;
+
+    // -----------------------------------------------------------------
+    // RESOLVING
+    // -----------------------------------------------------------------
+    if (g_link.state == LinkState::RESOLVING) {
+      uint8_t dns = g_dnsState.load();
+
+      if (dns == DNS_PENDING) {
+        if (millis() - g_link.startedAt < MQTT_DNS_TIMEOUT_MS) return LinkResult::PENDING;
+        Serial.printf("[HestiaNet | MQTT] ✖ DNS timeout for '%s'\n", g_link.host.c_str());
+        abortLink();
+        return LinkResult::FAILED;
+      }
+
+      if (dns != DNS_DONE) {
+        Serial.printf("[HestiaNet | MQTT] ✖ DNS lookup failed for '%s'\n", g_link.host.c_str());
+        abortLink();
+        return LinkResult::FAILED;
+      }
+
+      g_link.cachedHost = g_link.host;
+      g_link.cachedIp   = IPAddress(g_dnsAddr);
+      g_link.resolvedAt = millis();
+      g_link.cacheValid = true;
+      g_dnsState.store(DNS_IDLE);
+
+      Serial.printf("[HestiaNet | MQTT] DNS '%s' → %s\n",
+                    g_link.host.c_str(), g_link.cachedIp.toString().c_str());
+
+      if (!startTcp(g_link.cachedIp)) {
+        abortLink();
+        return LinkResult::FAILED;
+      }
+      return LinkResult::PENDING;
+    }
+
+    // -----------------------------------------------------------------
+    // CONNECTING
+    // -----------------------------------------------------------------
+    fd_set wset;
+    FD_ZERO(&wset);
+    FD_SET(g_link.fd, &wset);
+    struct timeval tv = {0, 0};
+
+    int rc = lwip_select(g_link.fd + 1, nullptr, &wset, nullptr, &tv);
+    if (rc == 0) {
+      if (millis() - g_link.startedAt < MQTT_TCP_TIMEOUT_MS) return LinkResult::PENDING;
+      Serial.println(F("[HestiaNet | MQTT] ✖ TCP connect timeout"));
+    }
+
+    int soErr = 0;
+    if (rc > 0) {
+      socklen_t len = sizeof(soErr);
+      lwip_getsockopt(g_link.fd, SOL_SOCKET, SO_ERROR, &soErr, &len);
+      if (soErr == 0) {
+        // Back to blocking mode with a bounded send timeout, as WiFiClient expects
+        int fd = g_link.fd;
+        lwip_fcntl(fd, F_SETFL, lwip_fcntl(fd, F_GETFL, 0) & ~O_NONBLOCK);
+
+        struct timeval sndTo = { (time_t)(sendTimeoutMs / 1000),
+                                 (suseconds_t)((sendTimeoutMs % 1000) * 1000) };
+        lwip_setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sndTo, sizeof(sndTo));
+        int one = 1;
+        lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        net = WiFiClient(fd);          // net now owns the descriptor
+        g_link.fd    = -1;
+        g_link.state = LinkState::IDLE;
+        return LinkResult::READY;
+      }
+      Serial.printf("[HestiaNet | MQTT] ✖ TCP connect failed (errno=%d)\n", soErr);
+    }
+
+    // Failure: the cached address may be stale
+    if (g_link.cachedHost == g_link.host) g_link.cacheValid = false;
+    abortLink();
+    return LinkResult::FAILED;
+  }
+
+
   /*****************************************************************************************
    *  MQTT Guard — Non-blocking MQTT connection manager
    *
@@ -274,10 +679,12 @@ namespace HestiaNet {
    *      • exponential backoff,
    *      • single-shot initialization,
    *      • credential retrieval from HestiaConfig,
-   *      • non-blocking reconnect attempts,
+   *      • non-blocking reconnect attempts (async DNS + TCP, see MQTT Transport),
    *      • connection state tracking.
    *
    *  Must be called repeatedly from the communication loop.
+   *  The only wait left is the CONNECT/CONNACK exchange on an already open socket,
+   *  bounded by the "mqtt_budget_ms" parameter (HESTIA_MQTT_CONNECT_BUDGET_MS).
    *
    *  Returns:
    *    true  → MQTT session is active
@@ -292,11 +699,12 @@ namespace HestiaNet {
     static unsigned long lastAttempt = 0;
     static uint8_t tryCount = 0;
     static unsigned long nextDelay = 100;
+    static uint32_t budgetMs = HESTIA_MQTT_CONNECT_BUDGET_MS;
+    static uint32_t cfgGeneration = 0;
+    static bool budgetApplied = false;
 
-    String cfgmqtt_ip    = HestiaConfig::getParam("mqtt_ip");
-    String cfgdevice_id  = HestiaConfig::getParam("device_id");
-    String cfgmqtt_user  = HestiaConfig::getParam("mqtt_user");
-    String cfgmqtt_pass  = HestiaConfig::getParam("mqtt_pass");
+    const HestiaConfig::MqttSnapshot& cfg = HestiaConfig::mqttSnapshot();
+    MQTTClient& client = mqttClient();
 
     // ---------------------------------------------------------------------
     // 1️⃣ Initialize MQTT client only once
@@ -304,25 +712,34 @@ namespace HestiaNet {
     if (!initialized) {
       Serial.println(F("[HestiaNet | MQTT] Initializing client..."));
 
+      client.dropOverflow(true);   // Oversize inbound: drop and count, keep the session
+      Serial.printf("[HestiaNet | MQTT] Buffers: RX %u, TX %u bytes\n",
+                    (unsigned)rxBufferSize(), (unsigned)HESTIA_MQTT_TX_BUFFER);
+
       client.setKeepAlive(20);
       client.setCleanSession(true);
 
-      client.begin(cfgmqtt_ip.c_str(),
-                  HestiaConfig::getParamObj("mqtt_port")->readInt(),
-                  net);
+      client.begin(cfg.host.c_str(), cfg.port, net);
 
       initialized = true;
       delay(10);
     }
 
+    // Connect budget follows the configuration (re-applied after a change only)
+    if (!budgetApplied || cfgGeneration != cfg.generation) {
+      budgetMs = cfg.budgetMs ? cfg.budgetMs : HESTIA_MQTT_CONNECT_BUDGET_MS;
+      client.setTimeout((int)budgetMs);
+      cfgGeneration = cfg.generation;
+      budgetApplied = true;
+    }
+
     // ---------------------------------------------------------------------
     // 2️⃣ Already connected → success
     // ---------------------------------------------------------------------
     if (client.connected()) {
       if (!wasConnected) {
         Serial.printf("[HestiaNet | MQTT] ✓ Connected to %s:%u\n",
-                      cfgmqtt_ip.c_str(),
-                      HestiaConfig::getParamObj("mqtt_port")->readInt());
+                      cfg.host.c_str(), (unsigned)cfg.port);
         wasConnected = true;
         tryCount = 0;
         nextDelay = 100;
@@ -330,35 +747,53 @@ namespace HestiaNet {
       return true;
     }
 
+    abandonStream();   // The socket it was written to is gone
+
+    if (wasConnected && client.lastError() == LWMQTT_BUFFER_TOO_SHORT) {
+      g_rxTooShort++;
+      Serial.println(F("[HestiaNet | MQTT] ✖ Session closed on a packet larger than the RX buffer"));
+    }
     wasConnected = false;
 
     // ---------------------------------------------------------------------
-    // 3️⃣ Exponential backoff timing
+    // 3️⃣ Exponential backoff timing (only before a new transport attempt)
     // ---------------------------------------------------------------------
-    if (millis() - lastAttempt < nextDelay) return false;
-    lastAttempt = millis();
+    if (g_link.state == LinkState::IDLE) {
+      if (millis() - lastAttempt < nextDelay) return false;
+      lastAttempt = millis();
+
+      Serial.printf("[HestiaNet | MQTT] Reconnect attempt %u...\n", tryCount + 1);
+      startLink(cfg.host, cfg.port);
+    }
 
-    Serial.printf("[HestiaNet | MQTT] Reconnect attempt %u...\n", tryCount + 1);
+    // ---------------------------------------------------------------------
+    // 4️⃣ Advance DNS / TCP without waiting
+    // ---------------------------------------------------------------------
+    LinkResult link = serviceLink(budgetMs);
+    if (link == LinkResult::PENDING) return false;
 
     // ---------------------------------------------------------------------
-    // 4️⃣ Attempt reconnection
+    // 5️⃣ MQTT CONNECT on the open socket (CONNACK wait ≤ budgetMs)
     // ---------------------------------------------------------------------
-    bool ok = client.connect(cfgdevice_id.c_str(),
-                            cfgmqtt_user.c_str(),
-                            cfgmqtt_pass.c_str());
+    if (link == LinkResult::READY) {
+      bool ok = client.connect(cfg.clientId.c_str(),
+                              cfg.user.c_str(),
+                              cfg.pass.c_str(),
+                              true /*skip TCP connect*/);
+
+      if (ok) {
+        Serial.println(F("[HestiaNet | MQTT] ✓ Session established"));
+        wasConnected = true;
+        tryCount = 0;
+        nextDelay = 100;
+        return false; // false because caller may need to resubscribe
+      }
 
-    if (ok) {
-      Serial.println(F("[HestiaNet | MQTT] ✓ Session established"));
-      wasConnected = true;
-      tryCount = 0;
-      nextDelay = 100;
-      return false; // false because caller may need to resubscribe
+      Serial.printf("[HestiaNet | MQTT] ✖ Connection failed (lastError=%d, returnCode=%d)\n", (int)client.lastError(), (int)client.returnCode());
     }
 
-    Serial.printf("[HestiaNet | MQTT] ✖ Connection failed (lastError=%d, returnCode=%d)\n", (int)client.lastError(), (int)client.returnCode());
-
     // ---------------------------------------------------------------------
-    // 5️⃣ Update backoff state
+    // 6️⃣ Update backoff state
     // ---------------------------------------------------------------------
     tryCount++;
     nextDelay = (tryCount <= 5)
@@ -383,8 +818,13 @@ namespace HestiaNet {
    *   - Otherwise: do nothing.
    **************************************************************************************/
   void disconnectMQTT() {
-      if (client.connected()) {
-          client.disconnect();   // Cleanly close the MQTT session
+      abortLink();               // Drop any DNS / TCP attempt in progress
+      if (g_stream.active) {
+          net.stop();            // Half-sent packet: DISCONNECT cannot follow it
+          abandonStream();
+      }
+      if (mqttClient().connected()) {
+          mqttClient().disconnect();   // Cleanly close the MQTT session
       }
       // IMPORTANT:
       // - Do NOT call WiFi.disconnect()
@@ -393,156 +833,740 @@ namespace HestiaNet {
 
 
 /*****************************************************************************************
- *  MQTT Discovery — Publish HA discovery JSON
+ *  MQTT Publishing — buffered or streamed
  *
  *  Purpose:
- *    Publishes the Home Assistant discovery payload for this device.
- *    The payload is expected to reside in PROGMEM and is injected earlier
- *    via loadDiscoveryJson().
+ *    MQTTClient encodes every PUBLISH into its fixed write buffer and fails
+ *    anything larger. Oversize packets (full-device discovery, JSON states)
+ *    are instead written to the socket by hand, without a payload-sized
+ *    buffer:
+ *        0x30 | retain, remaining length (varint), topic length, topic, payload
  *
- *  Behavior:
- *    • Skips if MQTT is offline
- *    • Skips if no JSON has been injected
- *    • Converts PROGMEM → RAM string manually
- *    • Publishes to:
- *        homeassistant/device/<device_id>/config
+ *  Notes:
+ *    • Non-blocking: each call sends what the socket accepts (MSG_DONTWAIT)
+ *      and loop() resumes the rest on later ticks; no progress for
+ *      HESTIA_MQTT_STREAM_TIMEOUT_MS closes the connection
+ *    • One packet on the wire at a time: publish(), subscribe() and
+ *      unsubscribe() return false and loop() holds client.loop() back
+ *      until it completes
+ *    • QoS 0 only: lwmqtt owns packet ids and PUBACK handling
+ *    • Inbound packets larger than the read buffer are dropped by the client
+ *      (dropOverflow) and counted; "mqtt_rx_buffer" sizes that buffer
+ *****************************************************************************************/
+
+  static void abandonStream() {
+    if (!g_stream.active) return;
+    g_mqttStats.streamFailed++;
+    g_stream = StreamState();
+  }
+
+  // Cut mid-packet: the session cannot be resynchronized, close it.
+  static void failStream(const char* why) {
+    Serial.printf("[HestiaNet | MQTT] ✖ Streamed publish to %s %s, connection closed\n",
+                  g_stream.topic.c_str(), why);
+    net.stop();
+    abandonStream();
+  }
+
+  // Send what the socket accepts right now, never waiting for room.
+  static void pumpStream() {
+    while (g_stream.active) {
+      StreamSeg* s = g_stream.seg;
+      while (s < g_stream.seg + 3 && s->n == 0) ++s;
+      if (s == g_stream.seg + 3) {
+        g_mqttStats.streamed++;
+        g_stream = StreamState();
+        return;
+      }
+
+      int w = lwip_send(net.fd(), s->p, s->n, MSG_DONTWAIT);
+      if (w > 0) {
+        s->p += w;
+        s->n -= (size_t)w;
+        g_stream.lastProgress = millis();
+        continue;
+      }
+      if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        if ((uint32_t)(millis() - g_stream.lastProgress) > HESTIA_MQTT_STREAM_TIMEOUT_MS) {
+          failStream("stalled");
+        }
+        return;   // Socket full: resume next tick
+      }
+      failStream("cut");
+      return;
+    }
+  }
+
+  // Put a QoS 0 PUBLISH on the socket and push what fits now. If the packet
+  // spans ticks, the rest of the payload is copied (unless `stable`, e.g. a
+  // flash table) so the caller's buffer may go away before it completes.
+  static void streamPublish(const char* topic, size_t topicLen,
+                            const char* payload, size_t len, bool retained, bool stable) {
+    StreamState& st = g_stream;
+    size_t h = 0;
+    size_t remaining = 2 + topicLen + len;
+
+    st.hdr[h++] = 0x30 | (retained ? 0x01 : 0x00);
+    do {
+      uint8_t b = remaining & 0x7F;
+      remaining >>= 7;
+      st.hdr[h++] = remaining ? (b | 0x80) : b;
+    } while (remaining);
+    st.hdr[h++] = (uint8_t)(topicLen >> 8);
+    st.hdr[h++] = (uint8_t)(topicLen & 0xFF);
+
+    st.topic  = topic;
+    st.seg[0] = { st.hdr, h };
+    st.seg[1] = { (const uint8_t*)st.topic.c_str(), topicLen };
+    st.seg[2] = { (const uint8_t*)payload, len };
+    st.active       = true;
+    st.lastProgress = millis();
+
+    pumpStream();
+    if (!st.active) return;
+
+    if (st.seg[2].n && !stable) {
+      st.payload.concat((const char*)st.seg[2].p, st.seg[2].n);
+      st.seg[2].p = (const uint8_t*)st.payload.c_str();
+    }
+  }
+
+  static bool publishImpl(const char* topic, const char* payload, bool retained, int qos, bool stable) {
+    if (!mqttClient().connected()) return false;
+    pumpStream();
+    if (g_stream.active) return false;   // One packet at a time on the wire
+
+    size_t topicLen = strlen(topic);
+    size_t len      = strlen(payload);
+    size_t packet   = 5 + 2 + topicLen + (qos ? 2 : 0) + len;   // Fixed header ≤ 5 bytes
+
+    if (packet <= HESTIA_MQTT_TX_BUFFER) {
+      return mqttClient().publish(topic, payload, (int)len, retained, qos);
+    }
+
+    if (qos) {
+      Serial.printf("[HestiaNet | MQTT] %s: %u bytes > TX buffer, streamed at QoS 0\n",
+                    topic, (unsigned)len);
+    }
+    streamPublish(topic, topicLen, payload, len, retained, stable);
+    return mqttClient().connected();
+  }
+
+  bool publish(const char* topic, const char* payload, bool retained, int qos) {
+    return publishImpl(topic, payload, retained, qos, false);
+  }
+
+  bool subscribe(const char* topic, int qos) {
+    if (!mqttClient().connected()) return false;
+    pumpStream();
+    if (g_stream.active) return false;   // Would split the streamed PUBLISH
+    return mqttClient().subscribe(topic, qos);
+  }
+
+  bool unsubscribe(const char* topic) {
+    if (!mqttClient().connected()) return false;
+    pumpStream();
+    if (g_stream.active) return false;
+    return mqttClient().unsubscribe(topic);
+  }
+
+  bool streaming() {
+    pumpStream();
+    return g_stream.active;
+  }
+
+  void loop() {
+    if (streaming()) return;   // A PINGREQ now would land inside the streamed packet
+    mqttClient().loop();
+  }
+
+  const MqttStats& mqttStats() {
+    g_mqttStats.rxOversize = mqttClient().droppedMessages() + g_rxTooShort;
+    return g_mqttStats;
+  }
+
+
+/*****************************************************************************************
+ *  MQTT Discovery — Incremental HA discovery publisher
+ *
+ *  Purpose:
+ *    Publishes one Home Assistant discovery config per component of the
+ *    injected discovery JSON (loadDiscoveryJson), spread over CoreComm ticks.
  *
+ *  Memory model:
+ *    • The JSON is never copied: ESP32 flash is memory-mapped, a small scanner
+ *      walks it in place and returns (pointer, length) spans
+ *    • Only the current component is parsed, into a document sized from its
+ *      own span — peak heap is bounded by the largest component, not the file
+ *    • The device block is serialized once at beginDiscovery() and spliced
+ *      into each payload as text
+ *
+ *  Change detection (NVS namespace "HDisc"):
+ *    • Each component is fingerprinted by FNV-1a of its source span and of the
+ *      device fragment it receives — the payload is a pure function of both
+ *    • The fingerprints of published components are kept with the broker
+ *      identity (host:port); unchanged components are skipped without parsing
+ *    • Another broker, or forceFullDiscovery(), republishes everything
+ *    • Broker instance: a complete run leaves a retained sentinel at
+ *      hestia/<device_id>/discovery. A run with fingerprints first subscribes
+ *      to it; if the broker does not deliver it within HESTIA_DISCOVERY_PROBE_MS
+ *      it lost its retained store (restart without persistence) and
+ *      everything is republished
+ *
+ *  Generated table (loadDiscoveryTable, tools/gen_discovery.py):
+ *    • Topics and payloads are final strings in flash, already split,
+ *      device-merged and abbreviated — one client.publish() per entry
+ *    • The fingerprint is precomputed by the generator (entry.hash)
+ *
+ *  Output (unchanged):
+ *    homeassistant/<p>/<unique_id|key>/config, retained, QoS 1
+ *    • First component: full device object (identifiers normalized to array)
+ *    • Next components : device.identifiers only
  *****************************************************************************************/
-void MQTTDiscovery()
+
+namespace {
+
+  // =============================================================
+  //  JSON span scanner (read-only, no allocation)
+  // =============================================================
+  struct Span {
+    const char* p = nullptr;
+    size_t      n = 0;
+  };
+
+  const char* skipWs(const char* s, const char* e) {
+    while (s < e && (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t')) ++s;
+    return s;
+  }
+
+  // s at the opening quote → past the closing quote (nullptr if unterminated)
+  const char* scanString(const char* s, const char* e) {
+    for (++s; s < e; ++s) {
+      if (*s == '\\') { ++s; continue; }
+      if (*s == '"') return s + 1;
+    }
+    return nullptr;
+  }
+
+  // s at the first char of a value → past its last char (nullptr if malformed)
+  const char* scanValue(const char* s, const char* e) {
+    if (s >= e) return nullptr;
+    if (*s == '"') return scanString(s, e);
+
+    if (*s == '{' || *s == '[') {
+      int depth = 0;
+      while (s < e) {
+        char c = *s;
+        if (c == '"') {
+          s = scanString(s, e);
+          if (!s) return nullptr;
+          continue;
+        }
+        if (c == '{' || c == '[') depth++;
+        else if (c == '}' || c == ']') {
+          if (--depth == 0) return s + 1;
+        }
+        ++s;
+      }
+      return nullptr;
+    }
+
+    // number / true / false / null
+    while (s < e && *s != ',' && *s != '}' && *s != ']' &&
+           *s != ' ' && *s != '\n' && *s != '\r' && *s != '\t') ++s;
+    return s;
+  }
+
+  // Object member iterator. cur starts just after '{'.
+  // Returns false at the closing brace; sets bad on malformed input.
+  bool nextMember(const char*& cur, const char* e, Span& key, Span& val, bool& bad) {
+    cur = skipWs(cur, e);
+    if (cur < e && *cur == ',') cur = skipWs(cur + 1, e);
+    if (cur >= e || *cur == '}') return false;
+
+    if (*cur != '"') { bad = true; return false; }
+    const char* kEnd = scanString(cur, e);
+    if (!kEnd) { bad = true; return false; }
+    key.p = cur + 1;
+    key.n = (size_t)(kEnd - cur - 2);
+
+    cur = skipWs(kEnd, e);
+    if (cur >= e || *cur != ':') { bad = true; return false; }
+    cur = skipWs(cur + 1, e);
+
+    const char* vEnd = scanValue(cur, e);
+    if (!vEnd) { bad = true; return false; }
+    val.p = cur;
+    val.n = (size_t)(vEnd - cur);
+    cur = vEnd;
+    return true;
+  }
+
+  // Top-level member of an object span, by name.
+  bool findMember(Span obj, const char* name, Span& val) {
+    const char* e = obj.p + obj.n;
+    const char* cur = skipWs(obj.p, e);
+    if (cur >= e || *cur != '{') return false;
+    ++cur;
+
+    size_t nameLen = strlen(name);
+    Span key;
+    bool bad = false;
+    while (nextMember(cur, e, key, val, bad)) {
+      if (key.n == nameLen && memcmp(key.p, name, nameLen) == 0) return true;
+    }
+    return false;
+  }
+
+  // =============================================================
+  //  Published-config fingerprints (persisted in "HDisc")
+  // =============================================================
+  constexpr const char* DISC_NAMESPACE = "HDisc";
+  constexpr const char* DISC_KEY_BROKER = "broker";   // u32: FNV-1a of "host:port"
+  constexpr const char* DISC_KEY_TABLE  = "table";    // blob: DiscEntry[]
+
+  struct DiscEntry {
+    uint32_t key;    // FNV-1a of the component key in "cmps"
+    uint32_t hash;   // Fingerprint of what was published for it
+  };
+
+  bool g_forceFull = false;
+
+  constexpr const char* SENTINEL_PREFIX = "hestia/";
+  constexpr const char* SENTINEL_SUFFIX = "/discovery";
+
+  // =============================================================
+  //  Discovery cursor (lives only while discovery is running)
+  // =============================================================
+  struct DiscoveryRun {
+    bool        active = false;
+    const char* cur    = nullptr;   // Inside the "cmps" object
+    const char* end    = nullptr;
+    const DiscoveryEntry* table = nullptr;   // Generated table mode (cur/end unused)
+    String      fullDevice;         // ,"device":{…}              (first component)
+    String      idsDevice;          // ,"device":{"identifiers":[…]} (others)
+    uint32_t    fullSeed  = 0;      // Fingerprint seeds: hash of each device fragment
+    uint32_t    idsSeed   = 0;
+    size_t      index     = 0;      // Position in "cmps" (0 gets the full device)
+    size_t      okCount   = 0;
+    size_t      failCount = 0;
+    size_t      skipCount = 0;
+    size_t      peakDoc   = 0;      // Largest per-component document capacity
+    uint32_t    startMs   = 0;
+
+    uint32_t               broker = 0;
+    std::vector<DiscEntry> known;   // Loaded from NVS, updated as components publish
+    std::vector<bool>      seen;    // known[i] met during this run (pruning)
+    bool                   dirty  = false;
+
+    bool     pending     = false;   // Streamed config still on the wire: fingerprint on completion
+    int      pendingSlot = -1;
+    uint32_t pendingKey  = 0;
+    uint32_t pendingHash = 0;
+
+    String   sentinel;              // hestia/<device_id>/discovery
+    bool     probing      = false;  // Waiting for the retained sentinel
+    bool     subscribed   = false;  // Sentinel SUBSCRIBE sent, probeStart running
+    bool     sentinelSeen = false;
+    uint32_t probeStart   = 0;
+  };
+
+  DiscoveryRun g_disc;
+
+  uint32_t brokerIdentity() {
+    const HestiaConfig::MqttSnapshot& m = HestiaConfig::mqttSnapshot();
+    char port[8];
+    snprintf(port, sizeof(port), ":%u", (unsigned)m.port);
+    return HestiaHash::fnv1a(port, HestiaHash::fnv1a(m.host.c_str()));
+  }
+
+  void loadFingerprints() {
+    g_disc.broker = brokerIdentity();
+
+    Preferences prefs;
+    prefs.begin(DISC_NAMESPACE, true);
+    bool sameBroker = prefs.getUInt(DISC_KEY_BROKER, 0) == g_disc.broker;
+    size_t bytes = prefs.getBytesLength(DISC_KEY_TABLE);
+
+    if (sameBroker && !g_forceFull && bytes && bytes % sizeof(DiscEntry) == 0) {
+      g_disc.known.resize(bytes / sizeof(DiscEntry));
+      prefs.getBytes(DISC_KEY_TABLE, g_disc.known.data(), bytes);
+    } else {
+      g_disc.dirty = true;   // Rewrite broker + table at the end of the run
+      Serial.println(g_forceFull ? F("[HestiaNet | MQTT Discovery] Full republish requested")
+                                 : F("[HestiaNet | MQTT Discovery] New broker or no history → full republish"));
+    }
+    prefs.end();
+
+    g_disc.seen.assign(g_disc.known.size(), false);
+    g_forceFull = false;
+  }
+
+  // Fingerprints only hold while the broker kept its retained messages:
+  // ask for the sentinel a previous complete run left there.
+  void startProbe() {
+    g_disc.sentinel  = SENTINEL_PREFIX;
+    g_disc.sentinel += HestiaConfig::mqttSnapshot().clientId;
+    g_disc.sentinel += SENTINEL_SUFFIX;
+    if (g_disc.known.empty()) return;   // Full run anyway
+
+    g_disc.probing = true;   // SUBSCRIBE sent by the first probeBroker()
+  }
+
+  // true while still waiting; on timeout the broker lost its retained store.
+  // SUBSCRIBE / UNSUBSCRIBE are retried each tick while a publish is streamed.
+  bool probeBroker() {
+    if (!g_disc.probing) return false;
+    if (!g_disc.subscribed) {
+      if (!subscribe(g_disc.sentinel.c_str())) return true;
+      g_disc.subscribed = true;
+      g_disc.probeStart = millis();
+      return true;
+    }
+    if (!g_disc.sentinelSeen &&
+        (uint32_t)(millis() - g_disc.probeStart) < HESTIA_DISCOVERY_PROBE_MS) {
+      return true;
+    }
+
+    if (!unsubscribe(g_disc.sentinel.c_str())) return true;
+    g_disc.probing = false;
+    if (g_disc.sentinelSeen) return false;
+
+    Serial.println(F("[HestiaNet | MQTT Discovery] Broker lost its retained configs → full republish"));
+    g_disc.known.clear();
+    g_disc.seen.clear();
+    g_disc.dirty = true;
+    return false;
+  }
+
+  // After a complete run: the broker now holds every config, mark it.
+  void publishSentinel() {
+    char payload[12];
+    snprintf(payload, sizeof(payload), "%u", (unsigned)g_disc.known.size());
+    publish(g_disc.sentinel.c_str(), payload, true, 1);
+  }
+
+  // Prune entries not met in a complete run, then persist if anything changed.
+  void saveFingerprints(bool complete) {
+    if (complete) {
+      size_t w = 0;
+      for (size_t i = 0; i < g_disc.known.size(); ++i) {
+        if (g_disc.seen[i]) g_disc.known[w++] = g_disc.known[i];
+      }
+      if (w != g_disc.known.size()) {
+        g_disc.known.resize(w);
+        g_disc.dirty = true;
+      }
+    }
+    if (!g_disc.dirty) return;
+
+    Preferences prefs;
+    prefs.begin(DISC_NAMESPACE, false);
+    prefs.putUInt(DISC_KEY_BROKER, g_disc.broker);
+    if (g_disc.known.empty()) prefs.remove(DISC_KEY_TABLE);
+    else prefs.putBytes(DISC_KEY_TABLE, g_disc.known.data(), g_disc.known.size() * sizeof(DiscEntry));
+    prefs.end();
+  }
+
+  // Index of keyHash in known[], or -1.
+  int findFingerprint(uint32_t keyHash) {
+    for (size_t i = 0; i < g_disc.known.size(); ++i) {
+      if (g_disc.known[i].key == keyHash) return (int)i;
+    }
+    return -1;
+  }
+
+  void recordFingerprint(int slot, uint32_t keyHash, uint32_t hash) {
+    if (slot < 0) {
+      g_disc.known.push_back({ keyHash, hash });
+      g_disc.seen.push_back(true);
+    } else {
+      g_disc.known[slot].hash = hash;
+    }
+    g_disc.dirty = true;
+  }
+
+  // Build the two device fragments once per discovery run.
+  bool prepareDevice(Span device) {
+    DynamicJsonDocument doc(device.n * 2 + 256);
+    if (deserializeJson(doc, device.p, device.n)) return false;
+
+    JsonObject dev = doc.as<JsonObject>();
+    DynamicJsonDocument ids(256 + device.n);
+    JsonArray idArr = ids.createNestedArray("identifiers");
+
+    if (dev["identifiers"].is<JsonArray>()) {
+      for (JsonVariant v : dev["identifiers"].as<JsonArray>()) idArr.add(v);
+    } else if (dev["identifiers"].is<const char*>()) {
+      const char* id = dev["identifiers"].as<const char*>();
+      idArr.add(id);
+      // Normalize identifiers to array when source uses a scalar.
+      dev.remove("identifiers");
+      dev.createNestedArray("identifiers").add(id);
+    } else {
+      idArr.add(HestiaConfig::getParamCStr("device_id"));
+    }
+
+    g_disc.fullDevice = F(",\"device\":");
+    serializeJson(dev, g_disc.fullDevice);
+    g_disc.idsDevice = F(",\"device\":");
+    serializeJson(ids, g_disc.idsDevice);
+
+    g_disc.fullSeed = HestiaHash::fnv1a(g_disc.fullDevice.c_str());
+    g_disc.idsSeed  = HestiaHash::fnv1a(g_disc.idsDevice.c_str());
+    return true;
+  }
+
+  // Parse and publish one component (key/value spans inside "cmps").
+  bool publishComponent(Span key, Span val, bool fullDevice) {
+    String cmpKey;
+    cmpKey.concat(key.p, key.n);
+
+    size_t capacity = val.n * 2 + 256;
+    if (capacity > g_disc.peakDoc) g_disc.peakDoc = capacity;
+
+    DynamicJsonDocument doc(capacity);
+    DeserializationError err = deserializeJson(doc, val.p, val.n);
+    if (err || !doc.is<JsonObject>()) {
+      Serial.printf("[HestiaNet | MQTT Discovery] ⚠ Skip '%s': %s\n",
+                    cmpKey.c_str(), err ? err.c_str() : "not an object");
+      return false;
+    }
+
+    doc.remove("device");
+
+    const char* platform = doc["p"] | "";
+    if (platform[0] == '\0') {
+      Serial.printf("[HestiaNet | MQTT Discovery] ⚠ Skip '%s': missing 'p'\n", cmpKey.c_str());
+      return false;
+    }
+
+    const char* uid = doc["unique_id"] | "";
+
+    String topic = "homeassistant/";
+    topic += platform;
+    topic += "/";
+    topic += (uid[0] != '\0') ? uid : cmpKey.c_str();
+    topic += "/config";
+
+    // Component body, then the device fragment spliced before the closing brace
+    const String& device = fullDevice ? g_disc.fullDevice : g_disc.idsDevice;
+    String payload;
+    payload.reserve(measureJson(doc) + device.length());
+    serializeJson(doc, payload);
+    payload.remove(payload.length() - 1);
+    if (payload.length() == 1) payload += device.c_str() + 1;   // "{" + "device":…
+    else                       payload += device;
+    payload += '}';
+
+    bool ok = publish(topic.c_str(), payload.c_str(), true, 1);
+    if (ok) {
+      Serial.printf("[HestiaNet | MQTT Discovery] ✓ %s -> %s\n", cmpKey.c_str(), topic.c_str());
+    } else {
+      Serial.printf("[HestiaNet | MQTT Discovery] ✖ %s -> %s\n", cmpKey.c_str(), topic.c_str());
+    }
+    return ok;
+  }
+
+  // Publish one generated entry: no parsing, the payload is final.
+  bool publishEntry(const DiscoveryEntry& e) {
+    bool ok = publishImpl(e.topic, e.payload, true, 1, true);   // Table lives in flash
+    Serial.printf("[HestiaNet | MQTT Discovery] %s %s\n", ok ? "✓" : "✖", e.topic);
+    return ok;
+  }
+
+  // True if this broker already holds the config fingerprinted by (keyHash, hash).
+  // On false, returns the slot to update once published (-1 = new entry).
+  bool alreadyPublished(uint32_t keyHash, uint32_t hash, int& slot) {
+    slot = findFingerprint(keyHash);
+    if (slot < 0) return false;
+    g_disc.seen[slot] = true;
+    if (g_disc.known[slot].hash != hash) return false;
+    g_disc.skipCount++;
+    return true;
+  }
+
+  void countResult(bool ok, int slot, uint32_t keyHash, uint32_t hash) {
+    if (!ok) {
+      g_disc.failCount++;
+      return;
+    }
+    if (g_stream.active) {   // Only a complete packet earns a fingerprint
+      g_disc.pending     = true;
+      g_disc.pendingSlot = slot;
+      g_disc.pendingKey  = keyHash;
+      g_disc.pendingHash = hash;
+      return;
+    }
+    g_disc.okCount++;
+    recordFingerprint(slot, keyHash, hash);
+  }
+
+  // Skip the component if its fingerprint matches what this broker already holds.
+  void processComponent(Span key, Span val) {
+    bool     full    = (g_disc.index++ == 0);
+    uint32_t keyHash = HestiaHash::fnv1aSpan(key.p, key.n);
+    uint32_t hash    = HestiaHash::fnv1aSpan(val.p, val.n, full ? g_disc.fullSeed : g_disc.idsSeed);
+
+    int slot;
+    if (alreadyPublished(keyHash, hash, slot)) return;
+    countResult(publishComponent(key, val, full), slot, keyHash, hash);
+  }
+
+  void processEntry(const DiscoveryEntry& e) {
+    g_disc.index++;
+    uint32_t keyHash = HestiaHash::fnv1a(e.topic);
+
+    int slot;
+    if (alreadyPublished(keyHash, e.hash, slot)) return;
+    countResult(publishEntry(e), slot, keyHash, e.hash);
+  }
+
+  void endDiscovery(const __FlashStringHelper* how, bool complete) {
+    saveFingerprints(complete);
+    if (complete) publishSentinel();
+    Serial.printf("[HestiaNet | MQTT Discovery] Summary: %u published / %u unchanged / %u failed in %lu ms, peak doc %u bytes\n",
+                  (unsigned)g_disc.okCount, (unsigned)g_disc.skipCount, (unsigned)g_disc.failCount,
+                  (unsigned long)(millis() - g_disc.startMs), (unsigned)g_disc.peakDoc);
+    Serial.println(how);
+    g_disc = DiscoveryRun();   // release the device fragments
+  }
+
+} // anonymous namespace
+
+
+bool beginDiscovery()
 {
     Serial.println(F("\n=== [HestiaNet | MQTT Discovery] Publishing HA single-component discovery ==="));
+    g_disc = DiscoveryRun();
 
     // ---------------------------------------------------------------------
     // 0) Guards
     // ---------------------------------------------------------------------
-    if (!client.connected()) {
+    if (!mqttClient().connected()) {
         Serial.println(F("[HestiaNet | MQTT Discovery] ✖ MQTT offline, aborting"));
-        return;
+        return false;
+    }
+
+    if (g_discoveryTable) {
+        loadFingerprints();
+        startProbe();
+        g_disc.table   = g_discoveryTable;
+        g_disc.startMs = millis();
+        g_disc.active  = true;
+        return true;
     }
 
     if (!g_discoveryJson) {
         Serial.println(F("[HestiaNet | MQTT Discovery] ✖ No injected discovery JSON"));
-        return;
+        return false;
     }
 
     // ---------------------------------------------------------------------
-    // 1) Convert PROGMEM -> RAM
+    // 1) Locate "device" and "cmps" in place (no copy, no full parse)
     // ---------------------------------------------------------------------
-    String payload;
-    size_t len = strlen_P(g_discoveryJson);
-    payload.reserve(len);
+    Span root{ g_discoveryJson, strlen_P(g_discoveryJson) };
+    Span device, cmps;
 
-    for (size_t i = 0; i < len; i++) {
-        payload += (char)pgm_read_byte_near(g_discoveryJson + i);
+    if (!findMember(root, "device", device) || device.p[0] != '{') {
+        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Missing or invalid 'device' object"));
+        return false;
     }
 
-    // ---------------------------------------------------------------------
-    // 2) Parse + structural checks
-    // ---------------------------------------------------------------------
-    DynamicJsonDocument doc((len * 2) + 4096);
-    DeserializationError err = deserializeJson(doc, payload.c_str());
-
-    if (err) {
-        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Invalid JSON syntax"));
-        Serial.print  (F("[HestiaNet | MQTT Discovery] Error: "));
-        Serial.println(err.c_str());
-        return;
+    if (!findMember(root, "cmps", cmps) || cmps.p[0] != '{') {
+        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Missing or invalid 'cmps' object"));
+        return false;
     }
 
-    if (!doc.containsKey("device") || !doc["device"].is<JsonObject>()) {
-        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Missing or invalid 'device' object"));
-        return;
+    if (!prepareDevice(device)) {
+        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Invalid 'device' object"));
+        return false;
     }
 
-    if (!doc.containsKey("cmps") || !doc["cmps"].is<JsonObject>()) {
-        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ Missing or invalid 'cmps' object"));
-        return;
-    }
+    loadFingerprints();
+    startProbe();
 
-    JsonObject deviceRoot = doc["device"].as<JsonObject>();
-    JsonObject cmps = doc["cmps"].as<JsonObject>();
+    g_disc.cur     = cmps.p + 1;
+    g_disc.end     = cmps.p + cmps.n;
+    g_disc.startMs = millis();
+    g_disc.active  = true;
+    return true;
+}
 
-    if (cmps.size() == 0) {
-        Serial.println(F("[HestiaNet | MQTT Discovery] ✖ No components defined (cmps empty)"));
-        return;
-    }
 
-    // ---------------------------------------------------------------------
-    // 3) Publish one discovery config per component
-    //    - First component: full device object
-    //    - Next components : device.identifiers only
-    // ---------------------------------------------------------------------
-    bool includeFullDevice = true;
-    size_t okCount = 0;
-    size_t failCount = 0;
+DiscoveryStatus discoveryStep(uint32_t budgetMs)
+{
+    if (!g_disc.active) return DiscoveryStatus::FAILED;
 
-    for (JsonPair kv : cmps) {
-        const String cmpKey = kv.key().c_str();
-        JsonObject cmpObj = kv.value().as<JsonObject>();
+    if (!mqttClient().connected()) {
+        endDiscovery(F("=== [HestiaNet | MQTT Discovery] ✖ MQTT lost, aborted ===\n"), false);
+        return DiscoveryStatus::FAILED;
+    }
 
-        DynamicJsonDocument outDoc(8192);
-        outDoc.set(cmpObj);
+    if (probeBroker()) return DiscoveryStatus::IN_PROGRESS;
 
-        outDoc.remove("device");
-        JsonObject outDevice = outDoc.createNestedObject("device");
+    // A streamed config still on the wire holds the run; it only completes on a live session
+    if (g_disc.pending) {
+        if (streaming()) return DiscoveryStatus::IN_PROGRESS;
+        g_disc.pending = false;
+        if (!mqttClient().connected()) {
+            endDiscovery(F("=== [HestiaNet | MQTT Discovery] ✖ MQTT lost, aborted ===\n"), false);
+            return DiscoveryStatus::FAILED;
+        }
+        countResult(true, g_disc.pendingSlot, g_disc.pendingKey, g_disc.pendingHash);
+    }
 
-        if (includeFullDevice) {
-            outDevice.set(deviceRoot);
+    uint32_t t0 = millis();
 
-            // Normalize identifiers to array when source uses a scalar.
-            if (outDevice["identifiers"].is<const char*>()) {
-                const char* id = outDevice["identifiers"].as<const char*>();
-                outDevice.remove("identifiers");
-                JsonArray ids = outDevice.createNestedArray("identifiers");
-                ids.add(id);
+    if (g_disc.table) {
+        do {
+            if (g_disc.pending) return DiscoveryStatus::IN_PROGRESS;
+            if (g_disc.index >= g_discoveryCount) {
+                endDiscovery(F("=== [HestiaNet | MQTT Discovery] Done ===\n"), true);
+                return DiscoveryStatus::DONE;
             }
-            includeFullDevice = false;
-        } else {
-            JsonArray ids = outDevice.createNestedArray("identifiers");
-
-            if (deviceRoot["identifiers"].is<JsonArray>()) {
-                for (JsonVariant v : deviceRoot["identifiers"].as<JsonArray>()) {
-                    ids.add(v);
-                }
-            } else if (deviceRoot["identifiers"].is<const char*>()) {
-                ids.add(deviceRoot["identifiers"].as<const char*>());
-            } else {
-                ids.add(HestiaConfig::getParam("device_id"));
+            processEntry(g_disc.table[g_disc.index]);
+        } while ((uint32_t)(millis() - t0) < budgetMs);
+        return DiscoveryStatus::IN_PROGRESS;
+    }
+
+    do {
+        if (g_disc.pending) return DiscoveryStatus::IN_PROGRESS;
+        Span key, val;
+        bool bad = false;
+        if (!nextMember(g_disc.cur, g_disc.end, key, val, bad)) {
+            if (bad) {
+                endDiscovery(F("=== [HestiaNet | MQTT Discovery] ✖ Invalid JSON in 'cmps' ===\n"), false);
+                return DiscoveryStatus::FAILED;
             }
+            if (g_disc.index == 0) {
+                Serial.println(F("[HestiaNet | MQTT Discovery] ✖ No components defined (cmps empty)"));
+            }
+            endDiscovery(F("=== [HestiaNet | MQTT Discovery] Done ===\n"), true);
+            return DiscoveryStatus::DONE;
         }
 
-        const char* platform = outDoc["p"] | "";
-        if (strlen(platform) == 0) {
-            Serial.printf("[HestiaNet | MQTT Discovery] ⚠ Skip '%s': missing 'p'\n", cmpKey.c_str());
-            failCount++;
-            continue;
-        }
+        processComponent(key, val);
 
-        const char* uid = outDoc["unique_id"] | "";
-        String objectId = (strlen(uid) > 0) ? String(uid) : cmpKey;
-
-        String topic = "homeassistant/";
-        topic += platform;
-        topic += "/";
-        topic += objectId;
-        topic += "/config";
-
-        String cmpPayload;
-        serializeJson(outDoc, cmpPayload);
-
-        bool ok = client.publish(topic.c_str(), cmpPayload.c_str(), true, 1);
-        if (ok) {
-            okCount++;
-            Serial.printf("[HestiaNet | MQTT Discovery] ✓ %s -> %s\n", cmpKey.c_str(), topic.c_str());
-        } else {
-            failCount++;
-            Serial.printf("[HestiaNet | MQTT Discovery] ✖ %s -> %s\n", cmpKey.c_str(), topic.c_str());
-        }
-    }
+    } while ((uint32_t)(millis() - t0) < budgetMs);
 
-    Serial.printf("[HestiaNet | MQTT Discovery] Summary: %u ok / %u failed\n",
-                  (unsigned)okCount, (unsigned)failCount);
-    Serial.println(F("=== [HestiaNet | MQTT Discovery] Done ===\n"));
+    return DiscoveryStatus::IN_PROGRESS;
+}
+
+
+void forceFullDiscovery()
+{
+    g_forceFull = true;
+}
+
+
+void MQTTDiscovery()
+{
+    if (!beginDiscovery()) return;
+    while (discoveryStep(UINT32_MAX) == DiscoveryStatus::IN_PROGRESS) {
+        loop();     // Sentinel delivery, streamed config
+        delay(1);
+    }
 }
 
 
@@ -567,7 +1591,7 @@ void MQTTDiscovery()
 
  *****************************************************************************************/
 void startMessageReceived() {
-    client.onMessage(messageReceived);
+    mqttClient().onMessage(messageReceived);
 }
 
 
@@ -576,11 +1600,16 @@ void startMessageReceived() {
  *  MQTT Incoming Message Callback
  *
  *  Behavior:
+ *    • The discovery sentinel is consumed while a run probes the broker
  *    • Messages are forwarded to HestiaCore’s dispatch layer.
  *****************************************************************************************/
 void messageReceived(String &topic, String &payload) {
   Serial.printf("[MQTT HestiaNet] %s <- %s\n", topic.c_str(), payload.c_str());
   Serial.flush();
+  if (g_disc.probing && topic == g_disc.sentinel) {   // Discovery's own sentinel
+    g_disc.sentinelSeen = payload.length() > 0;
+    return;
+  }
   HestiaCore::onMessageReceived(topic, payload);
   // Serial.println("HAIotBridge::messageReceived [flush] " + topic + " - " + payload);
 }
@@ -606,12 +1635,12 @@ void messageReceived(String &topic, String &payload) {
 void MQTTrefreshWithDelay(unsigned long ms) {
 
   if (WiFi.status() != WL_CONNECTED) return;
-  if (!client.connected()) return;
+  if (!HestiaNet::mqttClient().connected()) return;
 
   unsigned long until = millis() + ms;
 
   while ((long)(until - millis()) > 0) {
-    client.loop();
+    HestiaNet::loop();
     delay(0);  // yield to FreeRTOS / lwIP
   }
 }
@@ -24,11 +24,37 @@
 #include <WiFi.h>
 #include <MQTT.h>
 
+// ========================================================================================
+//  Build-time tuning (override with -D in build_flags)
+// ========================================================================================
+#ifndef HESTIA_MQTT_CONNECT_BUDGET_MS
+#define HESTIA_MQTT_CONNECT_BUDGET_MS 1000   // Max CONNACK wait when "mqtt_budget_ms" is absent
+#endif
+
+#ifndef HESTIA_MQTT_TX_BUFFER
+#define HESTIA_MQTT_TX_BUFFER 256            // MQTTClient write buffer; larger packets are streamed
+#endif
+
+#ifndef HESTIA_MQTT_RX_BUFFER
+#define HESTIA_MQTT_RX_BUFFER 1024           // MQTTClient read buffer when "mqtt_rx_buffer" is absent
+#endif
+
+#ifndef HESTIA_MQTT_STREAM_TIMEOUT_MS
+#define HESTIA_MQTT_STREAM_TIMEOUT_MS 2000   // Streamed PUBLISH stalled this long (socket full) → connection closed
+#endif
+
+#ifndef HESTIA_DISCOVERY_STEP_MS
+#define HESTIA_DISCOVERY_STEP_MS 0           // Discovery time budget per CoreComm tick (0 = one component)
+#endif
+
+#ifndef HESTIA_DISCOVERY_PROBE_MS
+#define HESTIA_DISCOVERY_PROBE_MS 1000       // Wait for the retained discovery sentinel before trusting fingerprints
+#endif
+
 // ========================================================================================
 //  Global network objects (declared in HestiaNetSDK.cpp)
 // ========================================================================================
 extern WiFiClient net;
-extern MQTTClient client;
 
 // ========================================================================================
 //  Forward Declarations — MQTT → HestiaCore Routing
@@ -42,6 +68,80 @@ namespace HestiaCore {
 // ========================================================================================
 namespace HestiaNet {
 
+  /**
+   * @brief The MQTT client, constructed on first use.
+   *
+   * Its read buffer is fixed at construction from "mqtt_rx_buffer"
+   * (HESTIA_MQTT_RX_BUFFER if absent), so the first call must come after
+   * the configuration is loaded — tryMQTTConnectNonBlocking() is the first.
+   */
+  MQTTClient& mqttClient();
+
+  // ====================================================================================
+  //  Publishing
+  // ====================================================================================
+
+  /**
+   * @brief Publish through the MQTT client, streaming packets it cannot buffer.
+   *
+   * Packets that fit HESTIA_MQTT_TX_BUFFER go through client.publish().
+   * Larger ones are written to the socket directly as a QoS 0 PUBLISH
+   * (a requested QoS 1 is downgraded), without blocking: what the socket
+   * does not accept now is kept (payload copied) and sent by loop() on the
+   * next ticks. A socket error or stall mid-packet closes the connection,
+   * since the stream can no longer be resynchronized.
+   *
+   * @param payload NUL-terminated; may reside in flash.
+   * @return true if the packet was handed to the client / socket; false
+   *         offline or while a streamed packet is still being sent.
+   */
+  bool publish(const char* topic, const char* payload, bool retained = false, int qos = 0);
+
+  /**
+   * @brief Subscribe / unsubscribe through the MQTT client.
+   *
+   * A SUBSCRIBE written while a streamed PUBLISH is on the socket would land
+   * inside it: both return false until the stream completes, so the caller
+   * retries on a later tick. Call these instead of client.subscribe().
+   *
+   * @return false offline, while a packet is streamed, or if the client failed.
+   */
+  bool subscribe(const char* topic, int qos = 0);
+  bool unsubscribe(const char* topic);
+
+  /**
+   * @brief Resume a streamed packet; true while one is still being sent.
+   */
+  bool streaming();
+
+  /**
+   * @brief Service the MQTT session: resume a streamed packet, then client.loop().
+   *
+   * client.loop() is held back while a packet is streamed, as a PINGREQ
+   * would land in the middle of it. Call this instead of client.loop().
+   */
+  void loop();
+
+  /**
+   * @brief MQTT size counters (since boot).
+   */
+  struct MqttStats {
+    uint32_t streamed;       // Outbound packets larger than the TX buffer, streamed
+    uint32_t streamFailed;   // Streamed packets cut by a socket error, stall or disconnect
+    uint32_t rxOversize;     // Inbound packets larger than the RX buffer (dropped)
+  };
+
+  const MqttStats& mqttStats();
+
+  // ====================================================================================
+  //  DiscoveryEntry — one pre-serialized discovery config (tools/gen_discovery.py)
+  // ====================================================================================
+  struct DiscoveryEntry {
+    const char* topic;     ///< homeassistant/<p>/<id>/config (PROGMEM)
+    const char* payload;   ///< Final JSON, device merged (PROGMEM)
+    uint32_t    hash;      ///< HestiaHash::fnv1a(payload, HestiaHash::fnv1a(topic))
+  };
+
   /**
    * @brief Load runtime Wi-Fi and MQTT parameters from HestiaConfig.
    *
@@ -51,6 +151,10 @@ namespace HestiaNet {
    *   • Prevent repeated O(n) lookups in HestiaConfig
    *   • Ensure networking always uses the freshest provisioning values
    *   • Separate firmware defaults from provisioning/runtime configuration
+   *
+   * Builds HestiaConfig::netSnapshot() / mqttSnapshot(). The guards read those
+   * snapshots each tick; they are rebuilt only when HestiaConfig::generation()
+   * changes (setParam(), HestiaParam::write()).
    */
   void loadConfig();
 
@@ -65,7 +169,8 @@ namespace HestiaNet {
    * Features:
    *   • Radio-level Wi-Fi stack reset when needed
    *   • Exponential backoff + random jitter
-   *   • Optional SSID presence scan after multiple failures
+   *   • Asynchronous SSID presence scan after multiple failures; the channel and
+   *     BSSID found steer the next connection attempts
    *   • No blocking delays — designed for call-every-loop()
    *
    * @return true if WL_CONNECTED, false otherwise.
@@ -97,6 +202,8 @@ namespace HestiaNet {
    *
    * Behavior:
    *   • Initializes client.begin() once
+   *   • Resolves the broker asynchronously (cached) and opens the TCP socket
+   *     without blocking; progress is polled on each call
    *   • Uses exponential backoff on failure
    *   • Returns true once MQTT is fully connected
    */
@@ -126,15 +233,54 @@ namespace HestiaNet {
   //  MQTT Discovery (Home Assistant)
   // ====================================================================================
 
+  enum class DiscoveryStatus : uint8_t {
+    IN_PROGRESS,   ///< Components left, call discoveryStep() again
+    DONE,          ///< Every component processed
+    FAILED         ///< MQTT lost or invalid JSON; nothing more to do this session
+  };
+
   /**
-   * @brief Publish the Home Assistant Discovery JSON block.
+   * @brief Start an incremental discovery run over the injected JSON.
    *
-   * The JSON must be injected via loadDiscoveryJson() and stored in PROGMEM.
+   * Locates "device" and "cmps" in place (the JSON is never copied) and
+   * prepares the device fragment.
    *
-   * Publishes to:
-   *     homeassistant/device/<device_id>/config
+   * @return false if MQTT is offline or the JSON structure is invalid.
+   */
+  bool beginDiscovery();
+
+  /**
+   * @brief Publish the next component(s) of the running discovery.
    *
-   * Retained = true to persist device attributes on the broker.
+   * Publishes at least one component, then continues while @p budgetMs has
+   * not elapsed (0 → exactly one component per call). Each component is
+   * parsed into its own small document and published retained, QoS 1, to:
+   *     homeassistant/<p>/<unique_id>/config
+   *
+   * Components unchanged since they were last published to the same broker
+   * (fingerprints in NVS namespace "HDisc") are skipped without parsing, as
+   * long as the broker still holds the retained sentinel of the last
+   * complete run (hestia/<device_id>/discovery); the first calls wait up to
+   * HESTIA_DISCOVERY_PROBE_MS for it, and without it everything is republished.
+   * With a generated table (loadDiscoveryTable) entries are published as-is.
+   */
+  DiscoveryStatus discoveryStep(uint32_t budgetMs);
+
+  /**
+   * @brief Republish every component on the next discovery run.
+   *
+   * Normally components whose fingerprint matches the one stored in NVS for
+   * the current broker are skipped. A broker that lost its retained
+   * messages is detected by the sentinel; use this when HA itself needs a
+   * resync.
+   */
+  void forceFullDiscovery();
+
+  /**
+   * @brief Publish the whole Home Assistant discovery block in one call.
+   *
+   * Blocking convenience wrapper over beginDiscovery() / discoveryStep();
+   * CoreComm uses the incremental form.
    */
   void MQTTDiscovery();
 
@@ -189,6 +335,17 @@ namespace HestiaNet {
    */
   void loadDiscoveryJson(const char* json);
 
+  /**
+   * @brief Register a generated discovery table (DiscoveryTable.h).
+   *
+   * Takes precedence over loadDiscoveryJson(): discovery then publishes each
+   * entry as-is, with no JSON parsing or serialization at runtime.
+   *
+   * @param table HESTIA_DISCOVERY_TABLE (entries and strings in flash).
+   * @param count HESTIA_DISCOVERY_COUNT.
+   */
+  void loadDiscoveryTable(const DiscoveryEntry* table, size_t count);
+
 } // namespace HestiaNet
 
 
@@ -5,7 +5,10 @@
 
 #include "HestiaConfig.h"    // pour getParam()
 #include "HardwareInit.h"    // pour watchdogKick
+#include "HestiaPersist.h"   // flush pending NVS writes before OTA / reboot
 #include "HestiaOTA.h"   // header minimal fourni plus tard si nécessaire
+#include "HestiaHtml.h"  // pages envoyées en chunked, sans String géante
+#include "HestiaWebAssets.h" // CSS/JS gzip en flash
 
 // ---------------------------------------------------------------------------
 // INTERNAL STATE
@@ -21,11 +24,11 @@ static bool otaAuthenticated = false;
 // HELPERS
 // ---------------------------------------------------------------------------
 
-static String makeTitle()
+static void addTitle(HestiaHtml::ChunkedPage& page)
 {
-    String dev = HestiaConfig::getParam("device_id");
-    String ver = HestiaConfig::getParam("version_prog");
-    return dev + " - " + ver;
+    page.add(HestiaConfig::getParamCStr("device_id"));
+    page.add(" - ");
+    page.add(HestiaConfig::getParamCStr("version_prog"));
 }
 
 static void rebootDevice()
@@ -33,7 +36,7 @@ static void rebootDevice()
     server.send(200, "text/html; charset=utf-8",
         "<html><body><h2>Rebooting...</h2></body></html>");
     delay(1500);
-    ESP.restart();
+    HestiaPersist::restart();
 }
 
 static bool otaAuthRequired()
@@ -57,28 +60,29 @@ static bool ensureOtaAuthenticated()
 // LOGIN PAGE (if user/pass configured)
 // ---------------------------------------------------------------------------
 
+static const char LOGIN_FORM[] PROGMEM =
+    "<form method='POST' action='/login'>"
+    "Login:<br><input name='user'><br><br>"
+    "Password:<br><input name='pass' type='password'><br><br>"
+    "<button type='submit'>Login</button>"
+    "</form><br>"
+    "<form method='POST' action='/cancel'>"
+    "<button type='submit'>Cancel</button>"
+    "</form>"
+    "</body></html>";
+
 static void handleLoginPage(bool invalid = false)
 {
-    String html;
-    html += "<html><body>";
-    html += "<h2>" + makeTitle() + "</h2>";
-
-    if (invalid)
-        html += "<p style='color:red;'>Invalid login or password</p>";
+    HestiaHtml::ChunkedPage page(server, "[OTA]");
 
-    html += "<form method='POST' action='/login'>";
-    html += "Login:<br><input name='user'><br><br>";
-    html += "Password:<br><input name='pass' type='password'><br><br>";
-    html += "<button type='submit'>Login</button>";
-    html += "</form><br>";
+    page.add("<html><body><h2>");
+    addTitle(page);
+    page.add("</h2>");
 
-    html += "<form method='POST' action='/cancel'>";
-    html += "<button type='submit'>Cancel</button>";
-    html += "</form>";
-
-    html += "</body></html>";
+    if (invalid)
+        page.add("<p style='color:red;'>Invalid login or password</p>");
 
-    server.send(200, "text/html; charset=utf-8", html);
+    page.addStatic(LOGIN_FORM);
 }
 
 static void handleLoginPost()
@@ -113,104 +117,47 @@ static void handleLoginPost()
 // OTA FILE SELECTION PAGE
 // ---------------------------------------------------------------------------
 
-static void handleOtaPage()
-{
-    if (!ensureOtaAuthenticated()) {
-        return;
-    }
-
-    String title = makeTitle();
-
-    String html;
-    html += "<html><head><style>";
-    html += "body { font-family: sans-serif; text-align:center; margin-top:40px; }";
-    html += ".row { margin: 15px; }";
-    html += ".btn { padding:10px 22px; margin:0 10px; }";
-    html += "#progress { width:80%; height:20px; background:#ddd; margin:auto; }";
-    html += "#bar { width:0%; height:100%; background:#4CAF50; }";
-    html += "</style></head><body>";
-
+// Static parts of the page, sent from flash around the dynamic title.
+// Styles and script are gzip assets (web/ota.css, web/ota.js).
+static const char OTA_PAGE_HEAD[] PROGMEM =
+    "<html><head>"
+    "<link rel='stylesheet' href='" HESTIA_ASSET_OTA_CSS "'>"
+    "</head><body>"
     // TITRES
-    html += "<h3>Update firmware by over the air (OTA)</h3>";
-    html += "<h2>" + title + "</h2>";
+    "<h3>Update firmware by over the air (OTA)</h3>"
+    "<h2>";
 
+static const char OTA_PAGE_BODY[] PROGMEM =
+    "</h2>"
     // COMPTE À REBOURS
-    html += "<p id='countdown' style='font-size:18px; margin-bottom:20px;'>Time remaining: 10m 00s</p>";
-
+    "<p id='countdown' style='font-size:18px; margin-bottom:20px;'>Time remaining: 10m 00s</p>"
     // INPUT FICHIER
-    html += "<div class='row'><input id='file' type='file'></div>";
-
+    "<div class='row'><input id='file' type='file'></div>"
     // BOUTONS
-    html += "<div class='row'>";
-    html += "<button class='btn' onclick='startUpload()'>Update</button>";
-    html += "<form method=\"POST\" action=\"/cancel\" style=\"display:inline;\">";
-    html += "<button class='btn' type='submit'>Cancel</button>";
-    html += "</form>";
-    html += "</div>";
-
+    "<div class='row'>"
+    "<button class='btn' onclick='startUpload()'>Update</button>"
+    "<form method=\"POST\" action=\"/cancel\" style=\"display:inline;\">"
+    "<button class='btn' type='submit'>Cancel</button>"
+    "</form>"
+    "</div>"
     // BARRE PROGRESSION
-    html += "<div id='progress'><div id='bar'></div></div>";
-    html += "<p id='status'></p>";
-
-    // JAVASCRIPT
-    html += "<script>";
-
-    // ---------------------------------------------------------------
-    // TIMER 10 minutes (600 secondes)
-    // ---------------------------------------------------------------
-    html += "var timeoutSec = 600;";
-    html += "function updateCountdown(){";
-    html += "  var m = Math.floor(timeoutSec/60);";
-    html += "  var s = timeoutSec % 60;";
-    html += "  document.getElementById('countdown').innerText = "
-            "'Time remaining: ' + m + 'm ' + (s<10?'0':'') + s + 's';";
-    html += "  timeoutSec--;";
-    html += "}";
-    html += "setInterval(updateCountdown, 1000);";
-
-    // RESET TIMER FRONTEND
-    html += "function resetTimer(){ timeoutSec = 600; }";
-    html += "document.getElementById('file').addEventListener('change', resetTimer);";
-
-    // ---------------------------------------------------------------
-    // UPLOAD + PROGRESSION
-    // ---------------------------------------------------------------
-    html += "function startUpload(){";
-    html += " var f = document.getElementById('file').files[0];";
-    html += " if(!f){ alert('Select a file first'); return; }";
-
-    html += " resetTimer();"; // activité détectée
-
-    html += " var xhr = new XMLHttpRequest();";
-    html += " xhr.open('POST', '/upload', true);";
-
-    // PROGRESSION
-    html += " xhr.upload.onprogress = function(e){";
-    html += "   resetTimer();"; // activité → reset
-    html += "   if(e.lengthComputable){";
-    html += "     var p = Math.round((e.loaded / e.total) * 100);";
-    html += "     document.getElementById('bar').style.width = p + '%';";
-    html += "     document.getElementById('status').innerText = p + '%';";
-    html += "   }";
-    html += " };";
-
-    // FIN UPLOAD
-    html += " xhr.onload = function(){";
-    html += "   document.getElementById('status').innerHTML = 'Upload complete. Device rebooting…';";
-    html += " };";
-
-  
-
-    html += " var form = new FormData();";
-    html += " form.append('firmware', f);";
-    html += " xhr.send(form);";
-    html += "}";
-
-    html += "</script>";
-    html += "</body></html>";
+    "<div id='progress'><div id='bar'></div></div>"
+    "<p id='status'></p>"
+    "<script src='" HESTIA_ASSET_OTA_JS "'></script>"
+    "</body></html>";
+
+static void handleOtaPage()
+{
+    if (!ensureOtaAuthenticated()) {
+        return;
+    }
 
     lastActivity = millis();   // reset timer serveur
-    server.send(200, "text/html; charset=utf-8", html);
+
+    HestiaHtml::ChunkedPage page(server, "[OTA]");
+    page.addStatic(OTA_PAGE_HEAD);
+    addTitle(page);
+    page.addStatic(OTA_PAGE_BODY);
 }
 
 
@@ -246,7 +193,7 @@ static void handleUpload()
             server.send(200, "text/html; charset=utf-8",
                 "<html><body><h2>Firmware updated successfully. Rebooting…</h2></body></html>");
             delay(1500);
-            ESP.restart();
+            HestiaPersist::restart();
         }
         else
         {
@@ -285,6 +232,7 @@ static void configureRoutes()
 
     server.on("/login", HTTP_POST, handleLoginPost);
     server.on("/ota", HTTP_GET, handleOtaPage);
+    HestiaHtml::registerBuiltinAssets(server);
     server.on("/cancel", HTTP_POST, handleCancel);
 
     server.on(
@@ -308,6 +256,9 @@ void HestiaOTA_Web_Start()
     loginAttempts = 0;
     otaAuthenticated = false;
 
+    // The loop below never returns: commit deferred entity values now
+    HestiaPersist::flushNow();
+
     configureRoutes();
     server.begin();
     lastActivity = millis();
@@ -1,65 +1,212 @@
 #include "HestiaParam.h"
 #include <Preferences.h>
+#include <string.h>
+#include <stdlib.h>
 
 // NVS namespace used for all configuration parameters.
-static constexpr const char* NAMESPACE = "HConfig";
+static constexpr const char* NAMESPACE = HestiaParam::NVS_NAMESPACE;
+
+// Shared by all parameters; consumers compare it to detect configuration changes.
+std::atomic<uint32_t> HestiaParam::s_generation{0};
 
 
 /**
  * ============================================================================
- *  Constructor — Build a parameter from a JSON schema entry
+ *  Pattern matchers — table-driven, selected once per parameter
  * ============================================================================
  *
- * The JSON object must define:
- *    - key           (string)
- *    - type          (string: "string", "int", "float", "bool")
- *    - label         (string, optional)
- *    - provisioning  (bool)
- *    - required      (bool)
- *    - critical      (bool)
- *    - default       (string)
- *    - decimals      (int, optional)
- *    - pattern       (string: ip, hostname, anything…)
- *
- * Optional validator object:
- *    "validate": {
- *        "minLen": n,
- *        "maxLen": n,
- *        "min"   : n,
- *        "max"   : n
- *    }
+ * Each PatternType maps to a plain function working on (ptr, len). Character
+ * classes come from a 128-entry table built at compile time, so matching is
+ * one lookup per character with no String copies.
  */
-HestiaParam::HestiaParam(const JsonObject& obj)
-{
-    key          = obj["key"]          | "";
-    type         = obj["type"]         | "";
-    label        = obj["label"]        | key;
-    provisioning = obj["provisioning"] | false;
-    required     = obj["required"]     | false;
-    critical     = obj["critical"]     | false;
+namespace {
+
+    enum CharClass : uint8_t {
+        CC_DIGIT = 1 << 0,
+        CC_ALPHA = 1 << 1,
+        CC_HOST  = 1 << 2,   // hostname label chars: alnum and '-'
+        CC_URL   = 1 << 3,   // RFC 3986 unreserved + reserved + '%' (path/query)
+        CC_LOCAL = 1 << 4    // RFC 5322 atext + '.' (e-mail local part)
+    };
+
+    struct CharTable {
+        uint8_t c[128];
+
+        constexpr CharTable() : c{} {
+            for (int i = 0; i < 128; ++i) {
+                uint8_t m = 0;
+                bool digit = (i >= '0' && i <= '9');
+                bool alpha = (i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z');
+                if (digit) m |= CC_DIGIT;
+                if (alpha) m |= CC_ALPHA;
+                if (digit || alpha || i == '-') m |= CC_HOST;
+                if (digit || alpha || has("-._~:/?#[]@!$&'()*+,;=%", i)) m |= CC_URL;
+                if (digit || alpha || has("!#$%&'*+-/=?^_`{|}~.", i)) m |= CC_LOCAL;
+                c[i] = m;
+            }
+        }
 
-    defaultValue = obj["default"] | "";
-    _value       = defaultValue;
+        static constexpr bool has(const char* set, int ch) {
+            for (; *set; ++set) if (*set == ch) return true;
+            return false;
+        }
+    };
 
-    decimals     = obj["decimals"] | 0;
-    pattern      = obj["pattern"]  | "anything";
+    constexpr CharTable kChars;
+
+    inline bool is(char ch, uint8_t cls) {
+        return (uint8_t)ch < 128 && (kChars.c[(uint8_t)ch] & cls);
+    }
 
-    // Parse optional validation rules
-    if (obj.containsKey("validate")) {
-        JsonObject v = obj["validate"];
+    // Dotted hostname: labels of [A-Za-z0-9-], 1..63 chars, no leading/trailing '-'.
+    bool matchHost(const char* s, size_t len) {
+        if (len < 1 || len > 64) return false;
+        size_t label = 0;
+        for (size_t i = 0; i < len; ++i) {
+            char ch = s[i];
+            if (ch == '.') {
+                if (label == 0 || s[i - 1] == '-') return false;
+                label = 0;
+                continue;
+            }
+            if (!is(ch, CC_HOST)) return false;
+            if (label == 0 && ch == '-') return false;
+            if (++label > 63) return false;
+        }
+        return label > 0 && s[len - 1] != '-';
+    }
+
+    bool matchAnything(const char*, size_t) { return true; }
+
+    bool matchBool(const char* s, size_t len) {
+        return (len == 4 && memcmp(s, "true", 4) == 0) ||
+               (len == 5 && memcmp(s, "false", 5) == 0);
+    }
+
+    // Four dotted octets, each 1..255 (0 rejected, as in R1).
+    bool matchIp(const char* s, size_t len) {
+        int octets = 0, value = -1;
+        for (size_t i = 0; i <= len; ++i) {
+            char ch = (i < len) ? s[i] : '.';
+            if (is(ch, CC_DIGIT)) {
+                value = (value < 0 ? 0 : value * 10) + (ch - '0');
+                if (value > 255) return false;
+            } else if (ch == '.') {
+                if (value < 1 || ++octets > 4) return false;
+                value = -1;
+            } else {
+                return false;
+            }
+        }
+        return octets == 4;
+    }
 
-        if (v.containsKey("minLen")) validators.minLen = v["minLen"];
-        if (v.containsKey("maxLen")) validators.maxLen = v["maxLen"];
+    // Accepted URL schemes; the host part follows "://".
+    const char* const kUrlSchemes[] = { "http", "https", "mqtt", "mqtts", "ws", "wss" };
+
+    // scheme://host[:port][/path?query#frag]
+    bool matchUrl(const char* s, size_t len) {
+        const char* sep = (const char*)memmem(s, len, "://", 3);
+        if (!sep) return false;
+
+        size_t schemeLen = sep - s;
+        bool known = false;
+        for (const char* scheme : kUrlSchemes) {
+            if (strlen(scheme) == schemeLen && strncasecmp(scheme, s, schemeLen) == 0) {
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+
+        const char* host = sep + 3;
+        const char* end  = s + len;
+        const char* p    = host;
+        while (p < end && *p != ':' && *p != '/' && *p != '?' && *p != '#') ++p;
+        if (!matchHost(host, p - host)) return false;
+
+        if (p < end && *p == ':') {
+            const char* port = ++p;
+            long value = 0;
+            while (p < end && is(*p, CC_DIGIT)) {
+                value = value * 10 + (*p++ - '0');
+                if (value > 65535) return false;
+            }
+            if (p == port || value == 0) return false;
+        }
 
-        if (v.containsKey("min")) {
-            validators.min    = v["min"];
-            validators.hasMin = true;
+        for (; p < end; ++p) {
+            if (!is(*p, CC_URL)) return false;
         }
-        if (v.containsKey("max")) {
-            validators.max    = v["max"];
-            validators.hasMax = true;
+        return true;
+    }
+
+    // local@domain — local from atext, domain a hostname with at least one dot.
+    bool matchEmail(const char* s, size_t len) {
+        const char* at = (const char*)memchr(s, '@', len);
+        if (!at || at == s) return false;
+
+        size_t localLen = at - s;
+        if (localLen > 64 || s[0] == '.' || s[localLen - 1] == '.') return false;
+        for (size_t i = 0; i < localLen; ++i) {
+            if (!is(s[i], CC_LOCAL)) return false;
+            if (s[i] == '.' && s[i + 1] == '.') return false;
         }
+
+        const char* domain = at + 1;
+        size_t domainLen = len - localLen - 1;
+        if (!memchr(domain, '.', domainLen)) return false;
+        return matchHost(domain, domainLen);
+    }
+
+    // Indexed by PatternType (order must follow HestiaParamSchema.h).
+    typedef bool (*MatcherFn)(const char*, size_t);
+    const MatcherFn kMatchers[] = {
+        matchAnything,   // ANYTHING
+        matchIp,         // IP
+        matchHost,       // HOSTNAME
+        matchUrl,        // URL
+        matchEmail,      // EMAIL
+        matchBool        // BOOL
+    };
+    static_assert(sizeof(kMatchers) / sizeof(kMatchers[0]) == (size_t)HestiaConfig::PatternType::BOOL + 1,
+                  "kMatchers must cover every PatternType");
+
+    MatcherFn matcherFor(HestiaConfig::PatternType pattern) {
+        size_t i = (size_t)pattern;
+        return i < sizeof(kMatchers) / sizeof(kMatchers[0]) ? kMatchers[i] : matchAnything;
     }
+
+    // "true"/"1"/"on" (case-insensitive, surrounding blanks ignored) → true.
+    bool parseBoolText(const char* s) {
+        while (*s == ' ' || *s == '\t') ++s;
+        size_t len = strlen(s);
+        while (len && (s[len - 1] == ' ' || s[len - 1] == '\t' || s[len - 1] == '\r' || s[len - 1] == '\n')) --len;
+
+        return (len == 4 && strncasecmp(s, "true", 4) == 0) ||
+               (len == 2 && strncasecmp(s, "on", 2) == 0) ||
+               (len == 1 && s[0] == '1');
+    }
+}
+
+
+/**
+ * ============================================================================
+ *  Constructor — Bind a parameter to its schema descriptor
+ * ============================================================================
+ *
+ * The descriptor (key, type, flags, validators, default) is not copied: it
+ * normally lives in a generated flash table (see HestiaParamSchema.h) and
+ * must outlive the parameter. Only the value is held in RAM, initialized
+ * to the schema default. The pattern matcher is resolved here once, so
+ * validation never dispatches on the pattern again.
+ */
+HestiaParam::HestiaParam(const HestiaConfig::ParamDescriptor* desc)
+    : _desc(desc),
+      _value(desc->defaultValue),
+      _match(matcherFor(desc->pattern))
+{
+    parseValue();
 }
 
 
@@ -81,27 +228,37 @@ HestiaParam::HestiaParam(const JsonObject& obj)
  */
 void HestiaParam::loadFromNVS(bool lazyInit)
 {
-    if (!provisioning) return;
+    if (!provisioning()) return;
 
     Preferences prefs;
     prefs.begin(NAMESPACE, false);
+    loadFromNVS(prefs, lazyInit);
+    prefs.end();
+}
 
-    String k = HestiaParam::nvsKey(key);
+/**
+ * Session-sharing variant used by HestiaConfig::loadDeviceParams(): the
+ * caller opens NAMESPACE once (read-write, lazyInit may write) for all
+ * parameters instead of one begin()/end() per key.
+ */
+void HestiaParam::loadFromNVS(Preferences& prefs, bool lazyInit)
+{
+    if (!provisioning()) return;
+
+    String k = HestiaParam::nvsKey(key());
 
     if (prefs.isKey(k.c_str())) {
-        _value = prefs.getString(k.c_str(), _value);
+        assign(prefs.getString(k.c_str(), _value));
         // Healing path: if a required/critical provisioning value is stored empty
         // but a schema default exists, restore and persist the default.
-        if (lazyInit && _value.length() == 0 && defaultValue.length() > 0 && (required || critical)) {
-            _value = defaultValue;
+        if (lazyInit && _value.length() == 0 && defaultValue()[0] != '\0' && (required() || critical())) {
+            assign(defaultValue());
             prefs.putString(k.c_str(), _value);
         }
     }
     else if (lazyInit) {
         prefs.putString(k.c_str(), _value);
     }
-
-    prefs.end();
 }
 
 
@@ -117,143 +274,113 @@ void HestiaParam::saveToNVS()
 {
     Preferences prefs;
     prefs.begin(NAMESPACE, false);
-    String k = HestiaParam::nvsKey(key);
-    prefs.putString(k.c_str(), _value);
+    saveToNVS(prefs);
     prefs.end();
 }
 
+/**
+ * Session-sharing variant used by batch writers (provisioning API): the
+ * caller opens NAMESPACE read-write once for all parameters.
+ */
+void HestiaParam::saveToNVS(Preferences& prefs)
+{
+    String k = HestiaParam::nvsKey(key());
+    prefs.putString(k.c_str(), _value);
+}
+
 
 /**
  * ============================================================================
- *  WRITE API — Core method
+ *  normalize() — canonical form of an incoming value
  * ============================================================================
+ *
+ * What write() stores: surrounding blanks trimmed and, for BOOL parameters,
+ * "on"/"1"/"true" (any case) folded to "true" and "off"/"0"/"false" to
+ * "false". Any other bool value is kept as is; validation decides. Callers
+ * that validate before writing (provisioning API) validate this form.
  */
-bool HestiaParam::write(const String& v)
+String HestiaParam::normalize(const String& v) const
 {
     String x = v;
     x.trim();
 
-    // -----------------------------------------------------
-    // 1) Normalisation booléenne (optionnelle mais utile)
-    // -----------------------------------------------------
-    if (type == "bool") {
+    if (type() == HestiaConfig::ParamType::BOOL) {
         String low = x;
         low.toLowerCase();
 
-        if (low == "true" || low == "on" || low == "1") {
-            _value = "true";
-            return true;
-        }
-
-        if (low == "false" || low == "off" || low == "0") {
-            _value = "false";
-            return true;
-        }
-
-        // toute autre valeur bool est acceptée telle quelle
-        // la validation décidera
-        _value = x;
-        return true;
+        if (low == "true" || low == "on" || low == "1")   return "true";
+        if (low == "false" || low == "off" || low == "0") return "false";
     }
-
-    // -----------------------------------------------------
-    // 2) Tous les autres types : stockage brut
-    // -----------------------------------------------------
-    _value = x;
-    return true;
+    return x;
 }
 
-
-
-
 /**
  * ============================================================================
- *  WRITE overloads — forward to core String write()
+ *  WRITE API — Core method
  * ============================================================================
  */
-bool HestiaParam::write(int v){ return write(String(v));}
-bool HestiaParam::write(long v){ return write(String(v));}
-bool HestiaParam::write(float v){ return write(formatNumber(v)); }
-bool HestiaParam::write(double v){ return write(formatNumber(v)); }
-bool HestiaParam::write(bool v){ return write(v ? "true" : "false"); }
+bool HestiaParam::write(const String& v)
+{
+    assign(normalize(v));
+    return true;
+}
 
 /**
  * ============================================================================
- *  formatNumber() — format a number according to decimal precision
+ *  assign() — single mutation point for _value
  * ============================================================================
+ *
+ * Bumps the shared generation so cached views (HestiaConfig snapshots)
+ * rebuild on their next access. Rewriting the same value is free.
  */
-String HestiaParam::formatNumber(double v) const
+void HestiaParam::assign(const String& v)
 {
-    if (decimals == 0) {
-        return String((long)v);   // no decimals
-    }
-    return String(v, (unsigned int)decimals);
+    if (_value == v) return;
+    _value = v;
+    parseValue();
+    bumpGeneration();
 }
 
-
 /**
- * ============================================================================
- *  READ API — typed accessors
- * ============================================================================
+ * Refresh the typed cache from _value. Conversions match the former
+ * per-read behavior (String::toInt/toFloat are atol/atof underneath).
  */
-int HestiaParam::readInt() const { return _value.toInt();}
-// Arduino String has no toLong(), so reuse toInt().
-long HestiaParam::readLong() const { return (long)_value.toInt();} 
-float HestiaParam::readFloat() const { return _value.toFloat(); }
-double HestiaParam::readDouble() const { return atof(_value.c_str()); }
-
-bool HestiaParam::readBool() const
+void HestiaParam::parseValue()
 {
-    String v = _value;
-    v.toLowerCase();
-    v.trim();
+    const char* s = _value.c_str();
+    _long   = atol(s);
+    _double = atof(s);
+    _bool   = parseBoolText(s);
+}
 
-    if (v == "true" || v == "1" || v == "on")
-        return true;
 
-    if (v == "false" || v == "0" || v == "off")
-        return false;
 
-    // fallback : toute autre valeur est considérée false
-    return false;
-}
 
+/**
+ * ============================================================================
+ *  WRITE overloads — forward to core String write()
+ * ============================================================================
+ */
+bool HestiaParam::write(int v){ return write(String(v));}
+bool HestiaParam::write(long v){ return write(String(v));}
+bool HestiaParam::write(float v){ return write(formatNumber(v)); }
+bool HestiaParam::write(double v){ return write(formatNumber(v)); }
+bool HestiaParam::write(bool v){ return write(v ? "true" : "false"); }
 
 /**
  * ============================================================================
- *  VALIDATION: Pattern rules
+ *  formatNumber() — format a number according to decimal precision
  * ============================================================================
  */
-bool HestiaParam::validatePattern(const String& candidate) const
+String HestiaParam::formatNumber(double v) const
 {
-    if (pattern == "anything")
-        return true;
-
-    if (pattern == "bool")
-        return (candidate == "true" || candidate == "false");
-
-    if (pattern == "ip") {
-        int a,b,c,d;
-        if (sscanf(candidate.c_str(), "%d.%d.%d.%d", &a,&b,&c,&d) != 4)
-            return false;
-        return (a>=1&&a<=255 &&
-                b>=1&&b<=255 &&
-                c>=1&&c<=255 &&
-                d>=1&&d<=255);
+    if (_desc->decimals == 0) {
+        return String((long)v);   // no decimals
     }
+    return String(v, (unsigned int)_desc->decimals);
+}
 
-    if (pattern == "hostname") {
-        if (candidate.length() < 1 || candidate.length() > 64)
-            return false;
-        for (char c : candidate) {
-            if (!(isalnum(c) || c=='-' || c=='.'))
-                return false;
-        }
-        return true;
-    }
 
-    return true;
-}
 
 /**
  * ============================================================================
@@ -262,23 +389,29 @@ bool HestiaParam::validatePattern(const String& candidate) const
  */
 bool HestiaParam::validateRange(const String& candidate) const
 {
-    if (type == "string") {
-        if (validators.minLen >= 0 &&
-            candidate.length() < (size_t)validators.minLen)
+    using HestiaConfig::ParamType;
+    const HestiaConfig::ParamDescriptor& d = *_desc;
+
+    if (d.type == ParamType::STRING) {
+        if (d.minLen >= 0 &&
+            candidate.length() < (size_t)d.minLen)
             return false;
 
-        if (validators.maxLen >= 0 &&
-            candidate.length() > (size_t)validators.maxLen)
+        if (d.maxLen >= 0 &&
+            candidate.length() > (size_t)d.maxLen)
             return false;
 
         return true;
     }
 
-    if (type == "number" || type == "int" || type == "float") {
-        double v = candidate.toFloat();
+    if (d.type == ParamType::NUMBER || d.type == ParamType::INT || d.type == ParamType::FLOAT) {
+        if (!(d.flags & (HestiaConfig::PF_HAS_MIN | HestiaConfig::PF_HAS_MAX)))
+            return true;
+
+        double v = atof(candidate.c_str());
 
-        if (validators.hasMin && v < validators.min) return false;
-        if (validators.hasMax && v > validators.max) return false;
+        if ((d.flags & HestiaConfig::PF_HAS_MIN) && v < d.min) return false;
+        if ((d.flags & HestiaConfig::PF_HAS_MAX) && v > d.max) return false;
 
         return true;
     }
@@ -293,10 +426,10 @@ bool HestiaParam::validateRange(const String& candidate) const
  */
 bool HestiaParam::validate(const String& candidate) const
 {
-    if (required && candidate.length() == 0)
+    if (required() && candidate.length() == 0)
         return false;
 
-    if (!validatePattern(candidate))
+    if (!_match(candidate.c_str(), candidate.length()))
         return false;
 
     return validateRange(candidate);
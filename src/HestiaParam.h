@@ -1,7 +1,8 @@
 #pragma once
 #include <Arduino.h>
-#include <ArduinoJson.h>
 #include <Preferences.h>
+#include <atomic>
+#include "HestiaParamSchema.h"
 
 /**
  * ============================================================================
@@ -10,8 +11,9 @@
  *
  *  Overview:
  *    Represents a single configuration parameter as defined by the device’s
- *    JSON schema (DeviceParams.json). Each instance contains:
- *      • Static metadata  (key, type, rules, defaults)
+ *    schema (DeviceParams.h). Each instance contains:
+ *      • A pointer to its static metadata (ParamDescriptor: key, type, rules,
+ *        default) — in flash for generated tables
  *      • Runtime value    (always stored as a String)
  *      • Optional NVS persistence for provisioning parameters
  *
@@ -19,6 +21,7 @@
  *    • Hold and manage the parameter’s current value
  *    • Load and save provisioning parameters to NVS
  *    • Perform type-aware formatting (float precision)
+ *    • Keep a parsed numeric/bool copy of the value so typed reads are free
  *    • Enforce validation rules (required, length, range, pattern)
  *
  *  Notes:
@@ -29,15 +32,27 @@
 class HestiaParam {
 public:
 
-    // ---- Construct from JSON schema entry ----
-    HestiaParam(const JsonObject& obj);
+    // ---- Construct from a schema descriptor (must outlive the parameter) ----
+    explicit HestiaParam(const HestiaConfig::ParamDescriptor* desc);
 
     // ---- Load value from NVS (lazyInit writes default if missing) ----
     void loadFromNVS(bool lazyInit);
 
+    // ---- Same, inside a caller-owned session on "HConfig" (opened read-write) ----
+    void loadFromNVS(Preferences& prefs, bool lazyInit);
+
+    // ---- NVS namespace used for all configuration parameters ----
+    static constexpr const char* NVS_NAMESPACE = "HConfig";
+
     // ---- Persist current value into NVS ----
     void saveToNVS();
 
+    // ---- Same, inside a caller-owned session on "HConfig" ----
+    void saveToNVS(Preferences& prefs);
+
+    // ---- Value as write() would store it: trimmed, bool spelled "true"/"false" ----
+    String normalize(const String& v) const;
+
     // ---- Write API (all supported types) ----
     bool write(const String& v);
     bool write(const char* v)      { return write(String(v)); }
@@ -47,52 +62,63 @@ public:
     bool write(double v);
     bool write(bool v);
 
-    // ---- Read API ----
+    // ---- Read API (typed reads return the cache parsed on assignment) ----
     String read()    const { return _value; }
-    int    readInt() const;
-    long   readLong() const;
-    float  readFloat() const;
-    double readDouble() const;
-    bool   readBool() const;
+    const String& value() const { return _value; }   // no copy
+    const char*   c_str() const { return _value.c_str(); }
+    int    readInt()    const { return (int)_long; }
+    long   readLong()   const { return _long; }
+    float  readFloat()  const { return (float)_double; }
+    double readDouble() const { return _double; }
+    bool   readBool()   const { return _bool; }
 
     // ---- Validation API ----
     bool validate(const String& candidate) const;
     bool validateValue() const;        // validate current internal value
 
-    // ---- Public metadata extracted from schema ----
-    String key;            ///< Unique identifier (NVS key)
-    String type;           ///< Raw schema type ("string", "int", ...)
-    String label;          ///< Human-readable label (i18n-ready)
-    bool   provisioning = false;  ///< true → persisted via NVS
-    bool   required     = false;  ///< missing value must be filled in provisioning
-    bool   critical     = false;  ///< invalid → force device provisioning
-    String defaultValue;          ///< schema default
+    // ---- Change generation: bumped whenever any parameter value changes ----
+    static uint32_t generation() { return s_generation.load(std::memory_order_acquire); }
+    static void     bumpGeneration() { s_generation.fetch_add(1, std::memory_order_release); }
+
+    // ---- Metadata (read from the descriptor, never copied) ----
+    const char* key()          const { return _desc->key; }           ///< Unique identifier (NVS key)
+    HestiaConfig::ParamType type() const { return _desc->type; }
+    const char* label()        const { return _desc->label; }         ///< Human-readable label
+    bool provisioning()        const { return _desc->flags & HestiaConfig::PF_PROVISIONING; }
+    bool required()            const { return _desc->flags & HestiaConfig::PF_REQUIRED; }
+    bool critical()            const { return _desc->flags & HestiaConfig::PF_CRITICAL; }
+    const char* defaultValue() const { return _desc->defaultValue; }  ///< Schema default
+    const HestiaConfig::ParamDescriptor& descriptor() const { return *_desc; }
 
 private:
 
+    // ---- Static metadata ----
+    const HestiaConfig::ParamDescriptor* _desc;
+
     // ---- Runtime storage ----
     String _value;
 
+    // ---- Parse-once cache, refreshed by assign() ----
+    long   _long   = 0;
+    double _double = 0.0;
+    bool   _bool   = false;
+
+    // ---- Pattern matcher selected from the descriptor at construction ----
+    typedef bool (*Matcher)(const char* s, size_t len);
+    Matcher _match;
+
+    // ---- Store a new value; bumps the generation only on an actual change ----
+    void assign(const String& v);
+    void parseValue();
+
+    static std::atomic<uint32_t> s_generation;
+
     // ---- Float formatting ----
-    int decimals = 0;              // configured precision for numeric types
     String formatNumber(double v) const;
 
-    // ---- Pattern and range validation helpers ----
-    bool validatePattern(const String& candidate) const;
+    // ---- Range validation helper ----
     bool validateRange(const String& candidate) const;
 
-    // ---- Validation rules extracted from schema ----
-    struct {
-        int     minLen = -1;
-        int     maxLen = -1;
-        double  min    = 0;
-        double  max    = 0;
-        bool    hasMin = false;
-        bool    hasMax = false;
-    } validators;
-
-    String pattern = "anything";   // schema pattern (ip, hostname, bool, …)
-
     // ---- max 15 characters for nvskey ----
     static String nvsKey(const String &jsonKey);
 };
@@ -0,0 +1,98 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*****************************************************************************************
+ *  File     : HestiaParamSchema.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Build-time description of the device parameters:
+ *    • ParamType / PatternType enums shared by HestiaParam and HestiaConfig
+ *    • ParamDescriptor — one schema entry (key, type, validators, default)
+ *
+ *  A project's DeviceParams.h JSON is turned into a `static const ParamDescriptor[]`
+ *  table by tools/gen_device_params.py. The table lives in flash; at boot each
+ *  HestiaParam only points at its descriptor and holds its value in RAM.
+ *
+ *  Design Principles
+ *  -----------------
+ *    • Aggregate, pointer-only fields → the table is constant-initialized and
+ *      placed in .rodata (flash) without any runtime constructor
+ *    • Same semantics as the JSON schema (see DeviceParams.h reference)
+ *
+ *****************************************************************************************/
+
+namespace HestiaConfig {
+
+  // ============================================================================
+  //  Enums — Parameter types and validation patterns
+  // ============================================================================
+
+  enum class ParamType : uint8_t {
+    STRING,
+    INT,
+    BOOL,
+    FLOAT,
+    NUMBER      ///< Integer or float, formatted via decimals
+  };
+
+  enum class PatternType : uint8_t {
+    ANYTHING,
+    IP,
+    HOSTNAME,
+    URL,
+    EMAIL,
+    BOOL
+  };
+
+  // ---- Schema spelling of each enum value (DeviceParams JSON, /api/params) ----
+  constexpr const char* typeName(ParamType t) {
+    return t == ParamType::INT    ? "int"
+         : t == ParamType::BOOL   ? "bool"
+         : t == ParamType::FLOAT  ? "float"
+         : t == ParamType::NUMBER ? "number"
+         :                          "string";
+  }
+
+  constexpr const char* patternName(PatternType p) {
+    return p == PatternType::IP       ? "ip"
+         : p == PatternType::HOSTNAME ? "hostname"
+         : p == PatternType::URL      ? "url"
+         : p == PatternType::EMAIL    ? "email"
+         : p == PatternType::BOOL     ? "bool"
+         :                              "anything";
+  }
+
+  // ============================================================================
+  //  Descriptor flags
+  // ============================================================================
+  enum ParamFlags : uint8_t {
+    PF_PROVISIONING = 1 << 0,   ///< Persisted in NVS, shown in provisioning UI
+    PF_REQUIRED     = 1 << 1,   ///< Empty value is invalid
+    PF_CRITICAL     = 1 << 2,   ///< Invalid value forces provisioning (validateR2)
+    PF_HAS_MIN      = 1 << 3,   ///< `min` is meaningful
+    PF_HAS_MAX      = 1 << 4    ///< `max` is meaningful
+  };
+
+  // ============================================================================
+  //  ParamDescriptor — one schema entry (flash-resident)
+  // ============================================================================
+  struct ParamDescriptor {
+    const char* key;            ///< Logical key (NVS key after nvsKey() shortening)
+    const char* label;          ///< UI label (generator substitutes key if absent)
+    const char* defaultValue;   ///< Schema default ("" if none)
+    ParamType   type;
+    PatternType pattern;
+    uint8_t     flags;          ///< ParamFlags
+    uint8_t     decimals;
+    int16_t     minLen;         ///< -1 = no constraint
+    int16_t     maxLen;         ///< -1 = no constraint
+    double      min;
+    double      max;
+    const char* options;        ///< '|'-separated allowed values, nullptr if none
+  };
+
+} // namespace HestiaConfig
+// ============================================================================
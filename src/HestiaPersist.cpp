@@ -0,0 +1,118 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <vector>
+#include <algorithm>
+#include "HestiaPersist.h"
+#include "HAIotBridge.h"
+
+// =====================================================================================
+// Internal state
+// =====================================================================================
+namespace {
+    std::vector<HAIoTBridge*> g_dirty;        // Pending bridges, in request order
+    uint32_t g_commitDelayMs = HestiaPersist::DEFAULT_COMMIT_DELAY_MS;
+    uint32_t g_firstDirtyMs  = 0;             // millis() of the oldest pending change
+
+    HestiaPersist::Stats g_stats = {};
+}
+
+namespace HestiaPersist {
+
+    // =====================================================================================
+    //  begin() — Configure commit delay
+    // =====================================================================================
+    void begin(uint32_t commitDelayMs) {
+        g_commitDelayMs = commitDelayMs;
+
+        Serial.printf("[HestiaPersist] Write-behind enabled: commit delay %lu ms\n",
+                      (unsigned long)g_commitDelayMs);
+    }
+
+    // =====================================================================================
+    //  requestSave() — Mark a bridge dirty
+    // =====================================================================================
+    void requestSave(HAIoTBridge* bridge, bool coalesced) {
+        if (!bridge) return;
+        g_stats.requests++;
+
+        if (coalesced) {
+            g_stats.writesAvoided++;
+            return;
+        }
+
+        if (g_dirty.empty()) {
+            g_firstDirtyMs = millis();
+        }
+        g_dirty.push_back(bridge);
+    }
+
+    // =====================================================================================
+    //  cancel() — Forget a pending bridge (HAIoTBridge::reset())
+    // =====================================================================================
+    void cancel(HAIoTBridge* bridge) {
+        g_dirty.erase(std::remove(g_dirty.begin(), g_dirty.end(), bridge), g_dirty.end());
+    }
+
+    // =====================================================================================
+    //  service() — Commit once the delay has elapsed
+    // =====================================================================================
+    void service() {
+        if (g_dirty.empty()) return;
+        if ((uint32_t)(millis() - g_firstDirtyMs) < g_commitDelayMs) return;
+        flushNow();
+    }
+
+    // =====================================================================================
+    //  flushNow() — One Preferences session for every pending bridge
+    // =====================================================================================
+    void flushNow() {
+        if (g_dirty.empty()) return;
+
+        uint32_t t0 = micros();
+        uint32_t written = 0;
+
+        Preferences prefs;
+        prefs.begin(HAIoTBridge::NVS_NAMESPACE, false);
+        for (auto* b : g_dirty) {
+            if (b->saveToNVS(prefs)) written++;
+        }
+        prefs.end();
+
+        g_dirty.clear();
+        g_stats.commits++;
+        g_stats.keysWritten += written;
+
+        Serial.printf("[HestiaPersist] Commit: %lu key(s) in %lu us\n",
+                      (unsigned long)written,
+                      (unsigned long)(micros() - t0));
+    }
+
+    // =====================================================================================
+    //  restart() — Commit, then reboot
+    // -------------------------------------------------------------------------------------
+    //  Not an esp_register_shutdown_handler() hook: those run inside esp_restart(),
+    //  after other tasks may have been stopped mid-way, where a flash write is unsafe.
+    // =====================================================================================
+    void restart() {
+        flushNow();
+        ESP.restart();
+    }
+
+    bool pending() {
+        return !g_dirty.empty();
+    }
+
+    const Stats& stats() {
+        return g_stats;
+    }
+
+    void logStats() {
+        Serial.printf("[HestiaPersist] Requests: %lu | Coalesced: %lu | Commits: %lu | Keys written: %lu\n",
+                      (unsigned long)g_stats.requests,
+                      (unsigned long)g_stats.writesAvoided,
+                      (unsigned long)g_stats.commits,
+                      (unsigned long)g_stats.keysWritten);
+    }
+
+} // namespace HestiaPersist
+// ============================================================================
@@ -0,0 +1,103 @@
+#pragma once
+#include <Arduino.h>
+
+/*****************************************************************************************
+ *  File     : HestiaPersist.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Write-behind persistence for HA_CONTROL entities:
+ *    • Writes only mark the entity dirty — no flash access on the hot path
+ *    • Dirty entities are committed together, in ONE Preferences session,
+ *      once the commit delay has elapsed since the first pending change
+ *    • Repeated writes to the same entity before the commit are coalesced
+ *      (only the latest value reaches flash)
+ *
+ *  Design Principles
+ *  -----------------
+ *    • Bounded loss window: at most commitDelayMs of changes on power loss
+ *    • Explicit flush on every intentional reboot: restart() replaces
+ *      ESP.restart(), OTA calls flushNow() before taking over the loop
+ *    • Counters expose how many flash writes were avoided
+ *
+ *****************************************************************************************/
+
+class HAIoTBridge;
+
+namespace HestiaPersist {
+
+  /**
+   * @brief Default commit delay when the device has no "nvs_commit_ms" parameter.
+   */
+  static constexpr uint32_t DEFAULT_COMMIT_DELAY_MS = 2000;
+
+  /**
+   * @brief Persistence counters (since boot).
+   */
+  struct Stats {
+    uint32_t requests;       // Save requests received from bridges
+    uint32_t writesAvoided;  // Requests coalesced into an already pending write
+    uint32_t commits;        // Preferences sessions opened
+    uint32_t keysWritten;    // Keys actually written to flash
+  };
+
+  /**
+   * @brief Configure the commit delay.
+   *
+   * @param commitDelayMs  Delay between the first pending change and the commit.
+   *                       0 → commit on the next service() call.
+   */
+  void begin(uint32_t commitDelayMs);
+
+  /**
+   * @brief Queue a bridge for persistence (called by HAIoTBridge).
+   *
+   * @param bridge     Entity whose current value must be saved.
+   * @param coalesced  True if the bridge was already pending.
+   */
+  void requestSave(HAIoTBridge* bridge, bool coalesced);
+
+  /**
+   * @brief Drop a pending bridge without saving it (HAIoTBridge::reset()).
+   */
+  void cancel(HAIoTBridge* bridge);
+
+  /**
+   * @brief Commit pending values once the delay has elapsed.
+   *
+   * Called from HestiaCore::CoreComm() on every loop.
+   */
+  void service();
+
+  /**
+   * @brief Commit all pending values immediately.
+   *
+   * Must be called before any intentional reboot or OTA update.
+   */
+  void flushNow();
+
+  /**
+   * @brief flushNow(), then ESP.restart().
+   *
+   * Use for every intentional reboot instead of ESP.restart().
+   */
+  void restart();
+
+  /**
+   * @brief True if at least one value is waiting to be committed.
+   */
+  bool pending();
+
+  /**
+   * @brief Access the persistence counters.
+   */
+  const Stats& stats();
+
+  /**
+   * @brief Print the persistence counters to Serial.
+   */
+  void logStats();
+
+} // namespace HestiaPersist
+// ============================================================================
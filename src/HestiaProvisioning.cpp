@@ -1,11 +1,16 @@
 
 #include <ArduinoJson.h>
+#include <Preferences.h>
 #include <WiFi.h>
 #include <WebServer.h>
 #include <DNSServer.h>
+#include <vector>
 #include "HestiaConfig.h"
 #include "HestiaProvisioning.h"
 #include "HardwareInit.h"
+#include "HestiaPersist.h"   // flush pending NVS writes before rebooting
+#include "HestiaHtml.h"
+#include "HestiaWebAssets.h"
 
 
 /*****************************************************************************************
@@ -19,15 +24,19 @@
  *  High-level behavior:
  *    • Start an ESP32 SoftAP using DEVICE_ID as access point name
  *    • Serve a captive-portal configuration form dynamically generated from the
- *      HestiaConfigSchema (master JSON definition)
+ *      parameter metadata already loaded by HestiaConfig (ParamDescriptor)
  *    • Validate submitted fields through HestiaConfig::validateAll()
  *    • Save only valid key/value pairs into NVS (namespace "HConfig")
  *    • Automatically restart the device after a successful save
+ *    • Headless JSON API (/api/params) for scripted bring-up: schema + values
+ *      out, validated atomic batch in, reboot only on request
  *
  *  Notes:
  *    • This module *intentionally* blocks execution inside StartProvisioning().
  *    • Provisioning mode must start BEFORE any Wi-Fi or MQTT operation.
  *    • The watchdog is actively serviced to avoid resets during UI interaction.
+ *    • Nothing is allocated until StartProvisioning(): devices in normal
+ *      runtime pay no heap for the portal.
  *
  *****************************************************************************************/
 
@@ -38,257 +47,144 @@ namespace Provisioning {
   // --------------------------------------------------------------------------------------
   // Internal module state (file-local)
   // --------------------------------------------------------------------------------------
-  static DNSServer dnsServer;        ///< Captive-portal DNS redirector
-  static WebServer server(80);       ///< HTTP provisioning server
-  static bool formSaved = false;     ///< Set to true when /save completes successfully
-  static JsonArray schemaParams;     ///< R2: DeviceParams schema array (used by handleSave)
-  static DynamicJsonDocument schemaDoc(8192);
+  static DNSServer* dnsServer = nullptr;   ///< Captive-portal DNS redirector (lazy)
+  static WebServer* server    = nullptr;   ///< HTTP provisioning server (lazy)
+  static bool formSaved = false;           ///< Set to true when /save completes successfully
 
   // ======================================================================================
-  //  buildHtmlForm() — HTML Form Generator
+  //  Static page parts — served straight from flash
+  // ======================================================================================
+  //  Styles and script are separate gzip assets (web/prov.css, web/prov.js),
+  //  cached by the browser across reloads; only the field list is per request.
+  static const char FORM_HEAD[] PROGMEM =
+    "<html><head>"
+    "<meta name='viewport' content='width=device-width, initial-scale=1.0'/>"
+    "<title>Provisioning</title>"
+    "<link rel='stylesheet' href='" HESTIA_ASSET_PROV_CSS "'>"
+    "</head><body>"
+    "<h2>Device configuration</h2>"
+    "<form id='provForm' method='POST'>";
+
+  static const char FORM_TAIL[] PROGMEM =
+    "<div id='cfgStatus' class='status-badge'></div>"
+    "<button type='button' id='saveBtn'>Save configuration</button>"
+    "</form>"
+    "<script src='" HESTIA_ASSET_PROV_JS "'></script>"
+    "</body></html>";
+
+  // ======================================================================================
+  //  streamHtmlForm() — HTML Form Generator
   // ======================================================================================
   /**
    * @brief Dynamically generate the provisioning UI.
    *
-   * The generator iterates over all parameters returned by HestiaConfig::allParams(),
-   * creating:
+   * The generator iterates over the HestiaConfig registry (provisioning
+   * parameters only) and reads each ParamDescriptor, creating:
    *    • <select>   for option-based parameters
    *    • <input>    for scalar types (string, number, etc.)
    *
-   * All existing values are pre-filled.
-   *
-   * @return The full HTML page as a String.
+   * All existing values are pre-filled. The page is sent with chunked
+   * transfer: static parts from flash, fields through a small fixed buffer,
+   * so heap use does not grow with the number of parameters.
    */
-  String buildHtmlForm() {
-    String html = R"(
-      <html><head>
-        <meta name='viewport' content='width=device-width, initial-scale=1.0'/>
-        <title>Provisioning</title>
-        <style>
-          body { font-family: sans-serif; margin: 20px; }
-
-          /* iOS Captive Portal: prevent automatic zoom */
-          input, select, textarea, button {
-            font-size: 16px;
-          }
-
-          h2 { margin-bottom: 16px; }
-          label { font-weight: bold; display: block; margin-top: 8px; }
+  void streamHtmlForm() {
+    HestiaHtml::ChunkedPage page(*server, "[Provisioning]");
 
-          input, select {
-            width: 100%;
-            padding: 8px;
-            margin-bottom: 12px;
-            box-sizing: border-box;
-          }
-
-          input:invalid {
-            border: 1px solid #cc0000;
-            background: #ffe6e6;
-          }
-          input:valid {
-            border: 1px solid #33aa33;
-            background: #eaffea;
-          }
-
-          .status-badge {
-            font-size: 14px;
-            padding: 4px 10px;
-            border-radius: 999px;
-            display: inline-block;
-            margin: 8px 0 12px 0;
-          }
-          .status-ok {
-            background: #e6f6e6;
-            color: #006600;
-          }
-          .status-bad {
-            background: #fde0e0;
-            color: #990000;
-          }
-
-          button {
-            padding: 12px;
-            width: 100%;
-            font-size: 16px;   /* important */
-            border: none;
-            border-radius: 6px;
-          }
-          #saveBtn.save-normal {
-            background: #009900;
-            color: #ffffff;
-          }
-          #saveBtn.save-force {
-            background: #cc0000;
-            color: #ffffff;
-          }
-        </style>
-
-      </head><body>
-      <h2>Device configuration</h2>
-      <form id='provForm' method='POST'>
-    )";
+    page.addStatic(FORM_HEAD);
 
     // ----------------------------------------------------------------------
-    // Generate form fields from DeviceParams JSON (R2)
+    // Generate form fields from the loaded parameter metadata (R2)
     // ----------------------------------------------------------------------
-    for (JsonObject meta : schemaParams) {
+    for (HestiaParam* p : HestiaConfig::_params) {
 
-    // Provisioning filter
-    // --------------------------------------------------
-      if (!meta["provisioning"].as<bool>())
-          continue;
-
-        const char* key   = meta["key"];
-        const char* label = meta["label"] | key;
-        const char* type  = meta["type"]  | "string";
+        // Provisioning filter
+        // --------------------------------------------------
+        if (!p->provisioning())
+            continue;
 
-        // Retrieve current value through the HestiaParam pipeline
-        HestiaParam* p = HestiaConfig::getParamObj(key);
-        String value = p ? p->read() : "";
+        const ParamDescriptor& d = p->descriptor();
+        const String& value = p->value();
 
         // --- LABEL ---
-        html += "<label>";
-        html += label;
-        html += "</label>";
-
-        // --- SELECT (if options exist) ---
-        if (meta.containsKey("options")) {
-            html += "<select name='";
-            html += key;
-            html += "'>";
-
-            JsonArray opts = meta["options"].as<JsonArray>();
-            for (JsonVariant ov : opts) {
-                const char* opt = ov.as<const char*>();
-                bool selected = (value == opt);
-
-                html += "<option value='";
-                html += opt;
-                html += "'";
-                if (selected) html += " selected";
-                html += ">";
-                html += opt;
-                html += "</option>";
+        page.add("<label>");
+        page.add(d.label);
+        page.add("</label>");
+
+        // --- SELECT (if options exist, '|'-separated) ---
+        if (d.options) {
+            page.add("<select name='");
+            page.add(d.key);
+            page.add("'>");
+
+            const char* opt = d.options;
+            while (*opt) {
+                const char* end = strchr(opt, '|');
+                size_t len = end ? (size_t)(end - opt) : strlen(opt);
+                bool selected = (value.length() == len && strncmp(value.c_str(), opt, len) == 0);
+
+                page.add("<option value='");
+                page.add(opt, len);
+                page.add("'");
+                if (selected) page.add(" selected");
+                page.add(">");
+                page.add(opt, len);
+                page.add("</option>");
+
+                opt += len;
+                if (*opt == '|') ++opt;
             }
 
-            html += "</select>";
+            page.add("</select>");
             continue;
         }
 
         // --- INPUT ---
-        String htmlType = "text";
-        if (strcmp(type, "int") == 0)   htmlType = "number";
-        if (strcmp(type, "float") == 0) htmlType = "text";  // floats in <input type="number"> behave poorly
-
-        html += "<input type='";
-        html += htmlType;
-        html += "' name='";
-        html += key;
-        html += "' value='";
-        html += value;
-        html += "'";
+        // floats stay in <input type="text">: type="number" behaves poorly with them
+        const char* htmlType = (d.type == ParamType::INT) ? "number" : "text";
+
+        page.add("<input type='");
+        page.add(htmlType);
+        page.add("' name='");
+        page.add(d.key);
+        page.add("' value='");
+        page.add(value);
+        page.add("'");
 
         // Required attribute
-        bool required = meta["required"] | false;
-        if (required) html += " required";
+        if (d.flags & PF_REQUIRED) page.add(" required");
 
         // MIN/MAX validators
-        if (meta.containsKey("validate")) {
-            JsonObject val = meta["validate"];
-
-            if (val.containsKey("min")) {
-                html += " min='";
-                html += val["min"].as<int>();
-                html += "'";
-            }
-            if (val.containsKey("max")) {
-                html += " max='";
-                html += val["max"].as<int>();
-                html += "'";
-            }
-            if (val.containsKey("minLen")) {
-                html += " minlength='";
-                html += val["minLen"].as<int>();
-                html += "'";
-            }
-            if (val.containsKey("maxLen")) {
-                html += " maxlength='";
-                html += val["maxLen"].as<int>();
-                html += "'";
-            }
+        if (d.flags & PF_HAS_MIN) {
+            page.add(" min='");
+            page.add((long)d.min);
+            page.add("'");
         }
-
-        // Pattern constraints (e.g., IP address)
-        const char* pattern = meta["pattern"] | nullptr;
-        if (pattern && strcmp(pattern, "ip") == 0) {
-            html += " pattern='^([0-9]{1,3}\\.){3}[0-9]{1,3}$'";
+        if (d.flags & PF_HAS_MAX) {
+            page.add(" max='");
+            page.add((long)d.max);
+            page.add("'");
         }
-
-        html += ">";
-    }
-
-
-
-    html += R"(
-        <div id='cfgStatus' class='status-badge'></div>
-        <button type='button' id='saveBtn'>Save configuration</button>
-      </form>
-
-      <script>
-        function updateProvisioningStatus() {
-          var form = document.getElementById('provForm');
-          var fields = form.querySelectorAll('input, select');
-          var allValid = true;
-          for (var i = 0; i < fields.length; i++) {
-            if (!fields[i].checkValidity()) {
-              allValid = false;
-              break;
-            }
-          }
-          var status = document.getElementById('cfgStatus');
-          var btn = document.getElementById('saveBtn');
-          if (allValid) {
-            status.textContent = 'Valid configuration';
-            status.className = 'status-badge status-ok';
-            btn.textContent = 'Save configuration';
-            btn.className = 'save-normal';
-            btn.dataset.mode = 'normal';
-          } else {
-            status.textContent = 'Invalid configuration';
-            status.className = 'status-badge status-bad';
-            btn.textContent = 'Save invalid configuration';
-            btn.className = 'save-force';
-            btn.dataset.mode = 'force';
-          }
+        if (d.minLen >= 0) {
+            page.add(" minlength='");
+            page.add(d.minLen);
+            page.add("'");
         }
-
-        function submitProvisioningForm(ev) {
-          ev.preventDefault();
-          var form = document.getElementById('provForm');
-          var btn = document.getElementById('saveBtn');
-          var mode = btn.dataset.mode || 'normal';
-          if (mode === 'force') {
-            form.action = '/forceSave';
-          } else {
-            form.action = '/save';
-          }
-          form.submit();
+        if (d.maxLen >= 0) {
+            page.add(" maxlength='");
+            page.add(d.maxLen);
+            page.add("'");
         }
 
-        document.addEventListener('DOMContentLoaded', function() {
-          var form = document.getElementById('provForm');
-          var btn = document.getElementById('saveBtn');
-          form.addEventListener('input', updateProvisioningStatus);
-          btn.addEventListener('click', submitProvisioningForm);
-          updateProvisioningStatus();
-        });
-      </script>
+        // Pattern constraints (e.g., IP address)
+        if (d.pattern == PatternType::IP) {
+            page.add(" pattern='^([0-9]{1,3}\\.){3}[0-9]{1,3}$'");
+        }
 
-      </body></html>
-    )";
+        page.add(">");
+    }
 
-    return html;
+    page.addStatic(FORM_TAIL);
+    page.end();
   }
 
   // ======================================================================================
@@ -300,7 +196,7 @@ namespace Provisioning {
    * Returns the fully generated configuration form.
    */
   void handleRoot() {
-      server.send(200, "text/html", buildHtmlForm());
+      streamHtmlForm();
   }
 
 
@@ -326,44 +222,37 @@ namespace Provisioning {
   void handleSave(bool force) {
     Serial.println("[Provisioning] handleSave() ENTER");
 
-      // Iterate over DeviceParams (R2 JSON schema)
-      for (JsonObject meta : schemaParams) {
+      // Iterate over the provisioning parameters (R2 registry)
+      for (HestiaParam* hp : HestiaConfig::_params) {
 
-          const char* key = meta["key"];
-
-          if (!server.hasArg(key))
+          if (!hp->provisioning() || !server->hasArg(hp->key()))
               continue;
 
-          String v = server.arg(key);
-
           // R2 pipeline: store → persist, regardless of validity
-          HestiaParam* hp = HestiaConfig::getParamObj(key);
-          if (hp) {
-              hp->write(v);       // always write to RAM
-              hp->saveToNVS();    // persist value immediately
-          }
+          hp->write(server->arg(hp->key()));   // always write to RAM
+          hp->saveToNVS();                     // persist value immediately
       }
 
       // Final user response
       if (force) {
           HestiaConfig::SetForceProvisioning(true);
-          server.send(200, "text/html",
+          server->send(200, "text/html",
               "<h3>Forced configuration saved.</h3>"
               "<p>The device will reboot into provisioning mode.</p>");
           formSaved = true;
           Serial.println("[Provisioning] handleSave() EXIT → reboot");
           delay(2000);
-          ESP.restart();
+          HestiaPersist::restart();
       } 
       else {
           HestiaConfig::SetForceProvisioning(false);
-          server.send(200, "text/html",
+          server->send(200, "text/html",
               "<h3>Configuration saved successfully.</h3>"
               "<p>The device will reboot automatically.</p>");
           formSaved = true;
           Serial.println("[Provisioning] handleSave() EXIT → reboot");
           delay(2000);
-          ESP.restart();
+          HestiaPersist::restart();
       }
   }
 
@@ -375,6 +264,196 @@ namespace Provisioning {
   void handleForceSaveRouter()  { handleSave(true); }
 
 
+  // ======================================================================================
+  //  Headless provisioning API — /api/params
+  // ======================================================================================
+  //  GET  /api/params
+  //      → {"device":"…","params":[{"key","label","type","pattern","required",
+  //          "critical","min","max","minLen","maxLen","options","value","valid"}…]}
+  //
+  //  POST /api/params   body: {"params":{"key":"value",…},"reboot":false}
+  //      • Every field is normalized (HestiaParam::normalize(): trimmed, bool
+  //        "on"/"1"/… folded) and that form checked with validate() before
+  //        anything is written: one bad field rejects the whole batch (422)
+  //      • On success all values are written to RAM, then persisted in a single
+  //        NVS session, and force_prov is cleared (same as /save)
+  //      → {"ok":bool,"results":[{"key","ok","error"?}…],"reboot":bool}
+  //      • The device reboots only when "reboot":true and the batch is accepted;
+  //        otherwise it stays in provisioning mode for further requests
+  // --------------------------------------------------------------------------------------
+
+  static constexpr size_t API_MAX_BODY = 4096;
+
+  /**
+   * @brief GET /api/params — schema and current values of provisioning parameters.
+   */
+  void handleApiGet() {
+      HestiaHtml::ChunkedPage page(*server, "[Provisioning]", "application/json");
+
+      page.add("{\"device\":");
+      page.addJson(HestiaConfig::getParamCStr("device_id"));
+      page.add(",\"params\":[");
+
+      bool first = true;
+      for (HestiaParam* p : HestiaConfig::_params) {
+          if (!p->provisioning()) continue;
+          const ParamDescriptor& d = p->descriptor();
+
+          page.add(first ? "{" : ",{");
+          first = false;
+
+          page.add("\"key\":");        page.addJson(d.key);
+          page.add(",\"label\":");     page.addJson(d.label);
+          page.add(",\"type\":");      page.addJson(typeName(d.type));
+          page.add(",\"pattern\":");   page.addJson(patternName(d.pattern));
+          page.add(",\"required\":");  page.add((d.flags & PF_REQUIRED) ? "true" : "false");
+          page.add(",\"critical\":");  page.add((d.flags & PF_CRITICAL) ? "true" : "false");
+          if (d.flags & PF_HAS_MIN) { page.add(",\"min\":"); page.add(d.min); }
+          if (d.flags & PF_HAS_MAX) { page.add(",\"max\":"); page.add(d.max); }
+          if (d.minLen >= 0) { page.add(",\"minLen\":"); page.add(d.minLen); }
+          if (d.maxLen >= 0) { page.add(",\"maxLen\":"); page.add(d.maxLen); }
+
+          if (d.options) {
+              page.add(",\"options\":[\"");
+              for (const char* o = d.options; *o; ++o) {
+                  if (*o == '|') page.add("\",\"");
+                  else if (*o == '"' || *o == '\\') { page.add('\\'); page.add(*o); }
+                  else page.add(*o);
+              }
+              page.add("\"]");
+          }
+
+          page.add(",\"value\":");     page.addJson(p->c_str());
+          page.add(",\"valid\":");     page.add(p->validateValue() ? "true" : "false");
+          page.add("}");
+      }
+
+      page.add("]}");
+  }
+
+  /**
+   * @brief Send a one-line JSON error ({"ok":false,"error":"…"}).
+   */
+  static void apiError(int code, const char* error) {
+      String body = F("{\"ok\":false,\"error\":\"");
+      body += error;
+      body += F("\"}");
+      server->send(code, "application/json", body);
+  }
+
+  /**
+   * @brief POST /api/params — validate a batch, then commit all or nothing.
+   */
+  void handleApiPost() {
+      if (!server->hasArg("plain")) {
+          apiError(400, "empty body");
+          return;
+      }
+
+      const String& body = server->arg("plain");
+      if (body.length() > API_MAX_BODY) {
+          apiError(413, "body too large");
+          return;
+      }
+
+      // Working memory only for the duration of the request
+      DynamicJsonDocument doc(body.length() * 2 + 512);
+      DeserializationError err = deserializeJson(doc, body);
+      if (err) {
+          apiError(400, err.c_str());
+          return;
+      }
+
+      JsonObject fields = doc["params"].as<JsonObject>();
+      if (fields.isNull()) {
+          apiError(400, "missing params object");
+          return;
+      }
+      bool reboot = doc["reboot"] | false;
+
+      // --- Pass 1: validate every field, nothing is modified ---------------------------
+      size_t n = fields.size();
+      std::vector<HestiaParam*> targets(n, nullptr);
+      std::vector<String>       values(n);   // Normalized: what pass 2 stores
+      std::vector<const char*>  errors(n, nullptr);
+      bool allOk = true;
+
+      size_t i = 0;
+      for (JsonPair kv : fields) {
+          HestiaParam* p = nullptr;
+          for (HestiaParam* q : HestiaConfig::_params) {
+              if (strcmp(q->key(), kv.key().c_str()) == 0) { p = q; break; }
+          }
+
+          const char* error = nullptr;
+          if (!p)                              error = "unknown";
+          else if (!p->provisioning())         error = "read-only";
+          else if (!kv.value().is<const char*>() && !kv.value().is<double>() && !kv.value().is<bool>())
+                                               error = "bad type";
+          else {
+              values[i] = p->normalize(kv.value().as<String>());
+              if (!p->validate(values[i]))     error = "invalid";
+          }
+
+          targets[i] = p;
+          errors[i]  = error;
+          if (error) allOk = false;
+          ++i;
+      }
+
+      // --- Pass 2: commit all (RAM, then one NVS session) -----------------------------
+      if (allOk) {
+          for (i = 0; i < n; ++i) {
+              targets[i]->write(values[i]);
+          }
+
+          Preferences prefs;
+          prefs.begin(HestiaParam::NVS_NAMESPACE, false);
+          for (i = 0; i < n; ++i) {
+              targets[i]->saveToNVS(prefs);
+          }
+          prefs.end();
+
+          HestiaConfig::SetForceProvisioning(false);
+      }
+
+      Serial.printf("[Provisioning] API batch: %u field(s), %s%s\n",
+                    (unsigned)n,
+                    allOk ? "committed" : "rejected",
+                    (allOk && reboot) ? ", rebooting" : "");
+
+      // --- Per-field report ---------------------------------------------------------------
+      {
+          HestiaHtml::ChunkedPage page(*server, "[Provisioning]", "application/json",
+                                       allOk ? 200 : 422);
+          page.add(allOk ? "{\"ok\":true,\"results\":[" : "{\"ok\":false,\"results\":[");
+
+          i = 0;
+          for (JsonPair kv : fields) {
+              page.add(i ? ",{\"key\":" : "{\"key\":");
+              page.addJson(kv.key().c_str());
+              if (errors[i]) {
+                  page.add(",\"ok\":false,\"error\":");
+                  page.addJson(errors[i]);
+              } else {
+                  page.add(",\"ok\":true");
+              }
+              page.add("}");
+              ++i;
+          }
+
+          page.add("],\"reboot\":");
+          page.add((allOk && reboot) ? "true}" : "false}");
+      }
+
+      if (allOk && reboot) {
+          formSaved = true;
+          delay(500);
+          HestiaPersist::restart();
+      }
+  }
+
+
   // ======================================================================================
   //  StartProvisioning() — Public API
   // ======================================================================================
@@ -388,30 +467,33 @@ namespace Provisioning {
    *   • Configure captive DNS redirect (all domains → 192.168.4.1)
    *   • Expose GET "/" and POST "/save" and "/forceSave"
    *   • Enter a loop:
-   *         dnsServer.processNextRequest()
-   *         server.handleClient()
+   *         dnsServer->processNextRequest()
+   *         server->handleClient()
    *         watchdogKick()
    *   • Exit only after a successful save
    *   • Automatically restart ESP
    *
-   * @param jsonSchema  Pointer to the DeviceParams (R2) JSON schema in RAM/PROGMEM
+   * The form is built from the parameters HestiaConfig already holds; the
+   * HTTP and DNS servers are allocated here, on first entry.
    */
-  void StartProvisioning(const char* jsonSchema) {
+  void StartProvisioning() {
 
       Serial.println("=== PROVISIONING MODE ===");
 
-      // Parse the R2 JSON schema (persistent storage)
-      schemaDoc.clear();
-      //deserializeJson(schemaDoc, jsonSchema);
-      deserializeJson(schemaDoc, jsonSchema, DeserializationOption::NestingLimit(10));
-      JsonArray arr = schemaDoc["params"].as<JsonArray>();
-      if (arr.isNull()) {
-          Serial.println("[Provisioning] ERROR: 'params' array not found in schema");
-      } else {
-          schemaParams = arr;
+      size_t fields = 0;
+      for (HestiaParam* p : HestiaConfig::_params) {
+          if (p->provisioning()) fields++;
       }
-      Serial.printf("[Provisioning] schema params count = %u\n",
-              (unsigned)schemaParams.size());
+      Serial.printf("[Provisioning] %u provisioning field(s) from %u parameter(s)\n",
+                    (unsigned)fields, (unsigned)HestiaConfig::_params.size());
+
+      // --- Portal working memory (allocated only in provisioning mode) ------------------
+      uint32_t heapBefore = ESP.getFreeHeap();
+      if (!dnsServer) dnsServer = new DNSServer();
+      if (!server)    server    = new WebServer(80);
+      Serial.printf("[Provisioning] Free heap: %u bytes (portal servers %u bytes)\n",
+                    (unsigned)ESP.getFreeHeap(),
+                    (unsigned)(heapBefore - ESP.getFreeHeap()));
 
       // --- Wi-Fi Access Point ------------------------------------------------------------
       WiFi.mode(WIFI_AP);
@@ -431,61 +513,64 @@ namespace Provisioning {
       Serial.println(WiFi.softAPIP());
 
       // --- Captive Portal DNS ------------------------------------------------------------
-      dnsServer.start(53, "*", apIP);
+      dnsServer->start(53, "*", apIP);
 
       // --- WebServer routes --------------------------------------------------------------
-      server.on("/", handleRoot);
-      server.on("/save", HTTP_POST, handleSaveRouter);
-      server.on("/forceSave", HTTP_POST, handleForceSaveRouter);
+      server->on("/", handleRoot);
+      HestiaHtml::registerBuiltinAssets(*server);
+      server->on("/save", HTTP_POST, handleSaveRouter);
+      server->on("/forceSave", HTTP_POST, handleForceSaveRouter);
+      server->on("/api/params", HTTP_GET, handleApiGet);
+      server->on("/api/params", HTTP_POST, handleApiPost);
       // --------------------------------------------------------------------------------------
       // Captive Portal Support (iOS / Android / Windows / ChromeOS)
       // --------------------------------------------------------------------------------------
 
       // iOS / macOS
-      server.on("/hotspot-detect.html", []() {
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+      server->on("/hotspot-detect.html", []() {
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
       // Android
-      server.on("/generate_204", []() {
+      server->on("/generate_204", []() {
           // Many implementations return 204, but redirecting works better for captive portals
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
       // Windows (NCSI)
-      server.on("/ncsi.txt", []() {
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+      server->on("/ncsi.txt", []() {
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
       // Windows fallback
-      server.on("/fwlink", []() {
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+      server->on("/fwlink", []() {
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
       // ChromeOS
-      server.on("/connecttest.txt", []() {
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+      server->on("/connecttest.txt", []() {
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
       // Fallback for ANY unknown path (critical!)
-      server.onNotFound([]() {
-          server.sendHeader("Location", "/", true);
-          server.send(302, "text/plain", "");
+      server->onNotFound([]() {
+          server->sendHeader("Location", "/", true);
+          server->send(302, "text/plain", "");
       });
 
-      server.begin();
+      server->begin();
 
       Serial.println("Provisioning portal ready");
 
       // --- Blocking loop until formSaved is set -------------------------------------------
       while (!formSaved) {
-          dnsServer.processNextRequest();
-          server.handleClient();
+          dnsServer->processNextRequest();
+          server->handleClient();
           HardwareInit::watchdogKick();
           delay(10);
       }
@@ -494,4 +579,8 @@ namespace Provisioning {
       Serial.println("Exiting provisioning mode");
   }
 
+  void StartProvisioning(const char* /*jsonSchema*/) {
+      StartProvisioning();
+  }
+
 } // namespace Provisioning
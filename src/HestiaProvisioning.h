@@ -9,8 +9,8 @@
  *  Responsibilities:
  *    • Start a self-contained Wi-Fi Access Point using the device identifier
  *    • Host a captive-portal HTTP server on 192.168.4.1
- *    • Dynamically generate a full configuration form from the DeviceParams
- *      JSON schema (HESTIA_PARAM_JSON)
+ *    • Dynamically generate a full configuration form from the parameter
+ *      metadata loaded by HestiaConfig (no second schema parse)
  *    • Persist values via HestiaParam / NVS
  *    • Defer final validation to HestiaConfig::validateR2() at next boot
  *
@@ -23,7 +23,7 @@
  *
  *  Usage:
  *    if (HestiaConfig::loadBAD() || HestiaConfig::ForceProvisioning()) {
- *        Provisioning::StartProvisioning(HESTIA_PARAM_JSON);
+ *        Provisioning::StartProvisioning();
  *    }
  *
  *****************************************************************************************/
@@ -33,7 +33,7 @@
 namespace Provisioning {
 
   /**
-   * @brief Start provisioning mode using the provided JSON schema.
+   * @brief Start provisioning mode using the parameters loaded by HestiaConfig.
    *
    * Behavior:
    *   • Configures DNS redirection for captive-portal behavior
@@ -41,8 +41,10 @@ namespace Provisioning {
    *         GET  "/"         → dynamic configuration form
    *         POST "/save"     → normal save (clears force_prov)
    *         POST "/forceSave"→ forced save (sets force_prov = true)
+   *         GET  "/api/params" → schema + current values (JSON)
+   *         POST "/api/params" → validated atomic batch, optional reboot
    *   • Blocks in a loop until the form is submitted successfully
-   *   • Triggers ESP.restart() to apply new configuration
+   *   • Triggers HestiaPersist::restart() to apply new configuration
    *
    * Notes:
    *   • This function NEVER returns.
@@ -50,9 +52,14 @@ namespace Provisioning {
    *   • Firmware accepts any submitted value.
    *   • Final authoritative validation is performed at next boot via
    *     HestiaConfig::validateR2(), which may trigger provisioning again.
+   *   • HestiaConfig::loadDeviceParams() must have run first.
+   */
+  void StartProvisioning();
+
+  /**
+   * @brief Former entry point, kept for source compatibility.
    *
-   * @param jsonSchema  Pointer to a PROGMEM string containing the full
-   *                    DeviceParams JSON schema.
+   * The schema argument is ignored: the form now comes from HestiaConfig.
    */
   void StartProvisioning(const char* jsonSchema);
 
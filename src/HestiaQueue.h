@@ -0,0 +1,88 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/*****************************************************************************************
+ *  File     : HestiaQueue.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Lock-free single-producer / single-consumer ring buffer used to pass messages
+ *  between the application task and the network task:
+ *    • Fixed capacity, storage embedded in the object — no heap
+ *    • push() never blocks: it fails when the ring is full
+ *    • One task may push, one (other) task may pop — no mutex, no critical section
+ *
+ *  Design Principles
+ *  -----------------
+ *    • Indices are free-running; capacity is a power of two so wrap-around is a mask
+ *    • The producer publishes a slot with a release store on _head, the consumer
+ *      acquires it before reading; symmetric for _tail
+ *
+ *****************************************************************************************/
+
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing: capacity must be a power of two");
+
+public:
+  /**
+   * @brief Copy @p item into the ring (producer side).
+   * @return false if the ring is full.
+   */
+  bool push(const T& item) {
+    size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= N) return false;
+    _slots[head & (N - 1)] = item;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Reserve the next slot for in-place filling (producer side).
+   * @return Slot pointer, or nullptr if the ring is full. Must be followed by commit().
+   */
+  T* reserve() {
+    size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= N) return nullptr;
+    return &_slots[head & (N - 1)];
+  }
+
+  /**
+   * @brief Publish the slot obtained with reserve() (producer side).
+   */
+  void commit() {
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copy the oldest item out of the ring (consumer side).
+   * @return false if the ring is empty.
+   */
+  bool pop(T& out) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) return false;
+    out = _slots[tail & (N - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Approximate number of queued items (exact from either endpoint's task).
+   */
+  size_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  T _slots[N];
+  std::atomic<size_t> _head{0};   // Written by the producer only
+  std::atomic<size_t> _tail{0};   // Written by the consumer only
+};
+// ============================================================================
@@ -0,0 +1,81 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "HestiaHash.h"
+
+/*****************************************************************************************
+ *  File     : HestiaTopicIndex.h
+ *  Project  : Hestia SDK / Virgo IoT
+ *
+ *  Summary
+ *  -------
+ *  Inbound MQTT topic → bridge row lookup used by HestiaCore dispatch:
+ *    • Open addressing (linear probing) over uint16_t row numbers
+ *    • Slot = fnv1a(topic, seed) & mask; a generated perfect-hash table
+ *      (tools/gen_mapping.py) is the same layout with a chosen seed
+ *
+ *  Design Principles
+ *  -----------------
+ *    • The table stores rows, not strings: the caller maps a row to its
+ *      topic (topicOf), and every hit is confirmed by a full comparison
+ *    • Dependency-free so the same code is host-compiled by test/host
+ *
+ *****************************************************************************************/
+
+namespace HestiaTopicIndex {
+
+  static constexpr uint16_t SLOT_EMPTY = 0xFFFF;
+
+  /**
+   * @brief Slot count for @p inbound topics: next power of two ≥ 2× (min 8).
+   *
+   * Keeps the load factor ≤ 0.5 so probe chains stay short.
+   */
+  inline size_t slotsFor(size_t inbound) {
+    size_t slots = 8;
+    while (slots < inbound * 2) slots <<= 1;
+    return slots;
+  }
+
+  /**
+   * @brief Insert @p row, whose topic is topicOf(row).
+   *
+   * @param existing  Set to the row already holding this topic on a duplicate.
+   * @return Probe length, or -1 if the topic is already indexed.
+   */
+  template <typename TopicOf>
+  int insert(uint16_t* slots, uint32_t mask, uint32_t seed,
+             uint16_t row, TopicOf topicOf, uint16_t& existing) {
+    const char* topic = topicOf(row);
+    uint32_t pos = HestiaHash::fnv1a(topic, seed) & mask;
+    int probe = 0;
+
+    while (slots[pos] != SLOT_EMPTY) {
+      if (strcmp(topicOf(slots[pos]), topic) == 0) {
+        existing = slots[pos];
+        return -1;
+      }
+      pos = (pos + 1) & mask;
+      probe++;
+    }
+    slots[pos] = row;
+    return probe;
+  }
+
+  /**
+   * @brief Row whose topic equals @p topic, or SLOT_EMPTY.
+   */
+  template <typename TopicOf>
+  uint16_t find(const uint16_t* slots, uint32_t mask, uint32_t seed,
+                const char* topic, TopicOf topicOf) {
+    uint32_t pos = HestiaHash::fnv1a(topic, seed) & mask;
+    while (slots[pos] != SLOT_EMPTY) {
+      if (strcmp(topicOf(slots[pos]), topic) == 0) return slots[pos];
+      pos = (pos + 1) & mask;
+    }
+    return SLOT_EMPTY;
+  }
+
+} // namespace HestiaTopicIndex
+// ============================================================================
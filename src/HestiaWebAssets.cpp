@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include "HestiaWebAssets.h"
+
+// ============================================================================
+//  GENERATED by tools/embed_assets.py from web/ — do not edit by hand.
+// ============================================================================
+
+// ota.css: 256 bytes, gzip 186 bytes
+static const uint8_t ASSET_OTA_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x4d, 0x8c, 0x41, 0x0a, 0x83, 0x30,
+    0x10, 0x45, 0xf7, 0x3d, 0xc5, 0x80, 0x74, 0x69, 0x49, 0x44, 0xa1, 0xc4, 0x55, 0x29, 0xf4, 0x1e,
+    0xd1, 0xc4, 0x18, 0xaa, 0x93, 0x90, 0x8c, 0xa8, 0x94, 0xde, 0xbd, 0x6a, 0x45, 0x5c, 0xce, 0x9f,
+    0xf7, 0x5e, 0xe5, 0xd4, 0x0c, 0x1f, 0x68, 0x1c, 0x52, 0xda, 0xc8, 0xde, 0x76, 0xb3, 0x80, 0x28,
+    0x31, 0xa6, 0x51, 0x07, 0xdb, 0x94, 0x40, 0x7a, 0xa2, 0x54, 0x76, 0xd6, 0xa0, 0xa8, 0x35, 0x92,
+    0x0e, 0x25, 0xf4, 0x32, 0x18, 0x8b, 0x29, 0x39, 0x2f, 0x72, 0xe6, 0xa7, 0x12, 0xbe, 0x97, 0x5b,
+    0x70, 0xe3, 0x52, 0xf9, 0x7f, 0x04, 0xf0, 0x62, 0x9f, 0x2b, 0xc2, 0x65, 0xf6, 0x52, 0x29, 0x8b,
+    0x46, 0xf0, 0x85, 0x86, 0x2c, 0x5b, 0x7f, 0x3b, 0xc9, 0x80, 0xef, 0x85, 0xc4, 0x07, 0x67, 0x82,
+    0x8e, 0x71, 0xe1, 0x47, 0xab, 0xa8, 0x15, 0x77, 0x76, 0x2d, 0xa1, 0xd5, 0xd6, 0xb4, 0x24, 0xb2,
+    0x8d, 0xaa, 0x64, 0xfd, 0x36, 0xc1, 0x0d, 0xa8, 0x44, 0xa2, 0x94, 0x3a, 0x2a, 0x72, 0x20, 0xb7,
+    0x35, 0x2a, 0x19, 0x0e, 0xfd, 0x64, 0x73, 0xb6, 0x1e, 0x67, 0x3b, 0x7f, 0x3e, 0x5e, 0x05, 0x5b,
+    0x9d, 0x1f, 0xc7, 0xfc, 0xaa, 0x08, 0x00, 0x01, 0x00, 0x00,
+};
+
+// ota.js: 1249 bytes, gzip 654 bytes
+static const uint8_t ASSET_OTA_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x53, 0xcb, 0x4e, 0xdb, 0x40,
+    0x14, 0xdd, 0xfb, 0x2b, 0x6e, 0x17, 0x68, 0xec, 0x02, 0x8e, 0xd9, 0xb0, 0x20, 0x45, 0x55, 0x4b,
+    0x42, 0x89, 0x94, 0x07, 0x4a, 0x8c, 0x54, 0xa9, 0xea, 0x62, 0xb0, 0xaf, 0x13, 0x4b, 0xf6, 0x8c,
+    0x3b, 0x73, 0x9d, 0x80, 0x2a, 0xa4, 0xae, 0xfa, 0x01, 0xfd, 0x88, 0x4a, 0x7c, 0x07, 0x7f, 0xc2,
+    0x97, 0xf4, 0x8e, 0x9d, 0x34, 0xa1, 0x15, 0xa5, 0x59, 0x38, 0x63, 0xdf, 0xd7, 0x39, 0x67, 0xce,
+    0xed, 0x74, 0x20, 0x1e, 0x8c, 0xfa, 0x53, 0x38, 0x8a, 0xa0, 0xcc, 0x55, 0x4d, 0x68, 0xc1, 0x3f,
+    0x8e, 0x22, 0xb0, 0x98, 0x68, 0x95, 0xa2, 0x0d, 0xbc, 0xa5, 0x34, 0x40, 0x79, 0x89, 0xba, 0xa6,
+    0x19, 0x26, 0x70, 0x0a, 0x1c, 0xee, 0x7a, 0x59, 0xad, 0x12, 0xca, 0xb5, 0x82, 0xba, 0x4a, 0x25,
+    0xe1, 0x99, 0xae, 0x15, 0xa5, 0x7a, 0xa5, 0xfc, 0xe0, 0xab, 0x07, 0xe0, 0x6a, 0x4a, 0x4e, 0x1d,
+    0x49, 0x5a, 0x84, 0x59, 0xa1, 0xb5, 0xf1, 0xb7, 0x2d, 0x3a, 0xc7, 0x51, 0xd0, 0x5d, 0x27, 0x59,
+    0x4e, 0xda, 0x69, 0xbe, 0xc7, 0xcd, 0x5d, 0x28, 0xd5, 0x49, 0x5d, 0xa2, 0xa2, 0x70, 0x8e, 0xd4,
+    0x2f, 0xd0, 0x1d, 0xdf, 0xdf, 0x0e, 0x52, 0x5f, 0x24, 0x9b, 0x39, 0x22, 0x08, 0x73, 0xa5, 0xd0,
+    0xc4, 0x78, 0x43, 0x70, 0xca, 0x25, 0x00, 0x22, 0xe6, 0x46, 0x60, 0xb0, 0x94, 0xb9, 0xca, 0xd5,
+    0xfc, 0x04, 0x04, 0xec, 0x33, 0x8a, 0x7d, 0x10, 0x65, 0x73, 0xf4, 0xed, 0x9b, 0xa3, 0xe8, 0xad,
+    0x88, 0xc4, 0x89, 0x10, 0x01, 0xbf, 0x5b, 0x17, 0xb2, 0xc2, 0xcd, 0xdb, 0x42, 0x38, 0x3c, 0xec,
+    0x7a, 0x77, 0x9e, 0x45, 0x1a, 0x28, 0x42, 0xb3, 0x94, 0x85, 0xff, 0x07, 0xc1, 0x03, 0x96, 0x2a,
+    0x72, 0x04, 0xbc, 0x4e, 0x07, 0xa6, 0xfd, 0x59, 0x3f, 0x5e, 0x2b, 0x78, 0x3e, 0x9d, 0x8c, 0xe3,
+    0xfe, 0xb8, 0xb7, 0x95, 0xc6, 0x20, 0xf7, 0x71, 0xa0, 0x0c, 0xab, 0xf2, 0xb7, 0x86, 0x70, 0xe7,
+    0x3d, 0xcb, 0x33, 0xcb, 0x0b, 0x64, 0x8a, 0x32, 0x4d, 0xfb, 0x4b, 0xfe, 0x38, 0xcc, 0x2d, 0x21,
+    0xb3, 0x65, 0x01, 0x16, 0x52, 0xcd, 0x51, 0x1c, 0xec, 0x34, 0x5f, 0x63, 0xb9, 0xba, 0x1c, 0x4e,
+    0xde, 0xf5, 0x98, 0xd3, 0xe5, 0x74, 0xf2, 0x81, 0x81, 0xcd, 0x06, 0x93, 0xf1, 0x16, 0x8b, 0x25,
+    0x69, 0xe8, 0xaa, 0x2a, 0xb4, 0x4c, 0xb7, 0x57, 0x94, 0x31, 0x92, 0x97, 0x20, 0xb8, 0x3f, 0xfb,
+    0x29, 0xfa, 0xec, 0x64, 0xca, 0x33, 0xff, 0x55, 0xc6, 0x54, 0x64, 0x81, 0x86, 0x7c, 0x31, 0xc3,
+    0x02, 0x13, 0x02, 0x09, 0x2e, 0x87, 0x1f, 0xc6, 0x92, 0x08, 0xba, 0x8c, 0x8c, 0x6a, 0xa3, 0x1c,
+    0x3d, 0x78, 0x22, 0x41, 0x17, 0x18, 0xa5, 0x64, 0x38, 0xcb, 0x9c, 0x1e, 0xee, 0x21, 0x7d, 0xb8,
+    0x27, 0x2e, 0x7f, 0xb8, 0x47, 0x6f, 0x0d, 0xe7, 0x66, 0x61, 0x18, 0x90, 0xc2, 0x15, 0x7c, 0x1c,
+    0x0d, 0x2f, 0x88, 0xaa, 0x29, 0x7e, 0xa9, 0xd1, 0x92, 0xdf, 0xd8, 0x85, 0xa3, 0xa1, 0xae, 0x50,
+    0xf9, 0xe2, 0x72, 0x32, 0x8b, 0x59, 0x01, 0xd1, 0xa9, 0x1b, 0x3e, 0x7c, 0x24, 0x53, 0xa3, 0x93,
+    0x01, 0xdc, 0x88, 0x5d, 0xfe, 0x6d, 0x59, 0x9b, 0x17, 0x6a, 0x55, 0x19, 0x3d, 0x67, 0x48, 0xce,
+    0x75, 0x1b, 0x65, 0x7c, 0x6c, 0xe4, 0xf8, 0x27, 0xd4, 0xc7, 0xef, 0x3f, 0xda, 0x70, 0x93, 0xc8,
+    0x2a, 0x60, 0x58, 0xa0, 0x9a, 0xd3, 0xe2, 0x4c, 0x97, 0x55, 0x4d, 0xf2, 0xba, 0xd8, 0x34, 0x69,
+    0x89, 0x54, 0x1b, 0xeb, 0x1b, 0x76, 0x4d, 0xea, 0xbb, 0x74, 0x9e, 0x8f, 0x29, 0x74, 0x00, 0x43,
+    0xd2, 0x24, 0x8b, 0x00, 0x5e, 0x3b, 0x1f, 0x35, 0xc4, 0xdc, 0xef, 0xd9, 0x5b, 0xb8, 0x96, 0x86,
+    0x2f, 0xc1, 0xd2, 0x6d, 0x81, 0xe1, 0x2a, 0x4f, 0x69, 0xc1, 0xad, 0x2b, 0x67, 0xdc, 0x3d, 0xf1,
+    0x62, 0x2d, 0xdf, 0x39, 0xd5, 0xf6, 0xe9, 0xa6, 0x3c, 0x2d, 0x76, 0x57, 0x74, 0xb7, 0xd1, 0xed,
+    0x7c, 0x30, 0x5e, 0x9b, 0x68, 0xa3, 0xb6, 0x72, 0xb0, 0x77, 0xb5, 0x5a, 0xb3, 0xfc, 0xcf, 0x89,
+    0x17, 0xf1, 0x68, 0xc8, 0xd5, 0xa2, 0xb5, 0x1d, 0x24, 0x2c, 0x56, 0x81, 0x84, 0x21, 0xf4, 0x70,
+    0x99, 0x27, 0x6e, 0x55, 0xaf, 0xb5, 0x26, 0x5e, 0xd5, 0xc7, 0x6f, 0x3f, 0x1b, 0x40, 0x2d, 0x94,
+    0xc6, 0x99, 0xda, 0x94, 0x6b, 0x2f, 0x9c, 0xf3, 0xb1, 0x27, 0x49, 0xb6, 0x2e, 0x70, 0x81, 0x50,
+    0x56, 0xec, 0x83, 0xc6, 0xa2, 0xa6, 0x5c, 0x49, 0xe3, 0xd6, 0x21, 0xfb, 0xed, 0x11, 0xeb, 0x42,
+    0x2e, 0x2d, 0x70, 0x9b, 0xfc, 0x0b, 0x20, 0x0f, 0xe3, 0x53, 0xe1, 0x04, 0x00, 0x00,
+};
+
+// prov.css: 977 bytes, gzip 461 bytes
+static const uint8_t ASSET_PROV_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x92, 0x41, 0x6e, 0xdb, 0x30,
+    0x10, 0x45, 0xf7, 0x3e, 0xc5, 0x00, 0x46, 0x37, 0x41, 0x94, 0xb0, 0x76, 0x21, 0x54, 0xf2, 0xae,
+    0x3d, 0x40, 0x0b, 0xf4, 0x04, 0x23, 0x71, 0x64, 0x13, 0xa6, 0x38, 0x02, 0x49, 0x39, 0x4e, 0x82,
+    0xde, 0xbd, 0x23, 0xd2, 0x76, 0x6c, 0x2b, 0x28, 0x37, 0x04, 0x29, 0xce, 0x9f, 0xf7, 0xbf, 0xa6,
+    0x61, 0xfd, 0x0a, 0xef, 0xd0, 0xb1, 0x8b, 0x45, 0x87, 0xbd, 0xb1, 0xaf, 0x35, 0x04, 0x74, 0xa1,
+    0x08, 0xe4, 0x4d, 0xb7, 0x81, 0x1e, 0xfd, 0xd6, 0xb8, 0x1a, 0x56, 0x6a, 0x38, 0x6e, 0xe0, 0xef,
+    0x62, 0xf1, 0xfc, 0x00, 0xe6, 0xd7, 0x1f, 0xf8, 0x89, 0x43, 0x34, 0x07, 0x82, 0xdf, 0xec, 0x23,
+    0xda, 0x1a, 0x06, 0x4f, 0x07, 0x72, 0x11, 0x70, 0x8c, 0xdc, 0x63, 0x34, 0x2d, 0xbc, 0x31, 0xf7,
+    0xf0, 0xf0, 0xbc, 0x30, 0x6e, 0x18, 0xe3, 0x23, 0x04, 0xb2, 0xd4, 0xca, 0x1e, 0xe9, 0x18, 0xd1,
+    0x13, 0x3e, 0x42, 0x33, 0xc6, 0xc8, 0x0e, 0xde, 0x17, 0x90, 0xdb, 0x07, 0xf3, 0x46, 0x35, 0x7c,
+    0x2d, 0xa5, 0xd1, 0x42, 0x1a, 0xed, 0x56, 0xc2, 0x95, 0xdb, 0x17, 0x0d, 0xcb, 0xd3, 0xfe, 0xf4,
+    0x51, 0x28, 0x2c, 0x36, 0x64, 0xcf, 0xd8, 0x2f, 0x64, 0xb6, 0xbb, 0x58, 0x43, 0xc3, 0x56, 0x6f,
+    0x40, 0x9b, 0x30, 0x58, 0x14, 0x17, 0x8d, 0xe5, 0x76, 0x7f, 0x36, 0x50, 0x44, 0x1e, 0x6a, 0xf8,
+    0x7e, 0xf2, 0x70, 0x83, 0x94, 0x00, 0x5e, 0x8c, 0x8e, 0x3b, 0xd1, 0x57, 0xea, 0xcb, 0x46, 0x8e,
+    0x03, 0x6a, 0x6d, 0xdc, 0x36, 0x57, 0xc8, 0xf9, 0x1e, 0x63, 0x95, 0xaf, 0x1b, 0x3e, 0x4e, 0xd4,
+    0xe9, 0x65, 0xc3, 0x5e, 0x93, 0x97, 0x27, 0x99, 0x3e, 0xb5, 0xa8, 0x8d, 0x3b, 0xa0, 0x35, 0x3a,
+    0xb5, 0xc8, 0x0f, 0xa4, 0x78, 0x38, 0x42, 0xe0, 0xe9, 0x76, 0xd9, 0xb6, 0x4a, 0x56, 0x52, 0xc2,
+    0x76, 0xbf, 0xf5, 0x3c, 0x3a, 0x5d, 0xc3, 0xb2, 0xeb, 0xa8, 0xa4, 0x72, 0x92, 0xc9, 0x2a, 0xff,
+    0xd5, 0x58, 0xaf, 0x11, 0xd7, 0xeb, 0x99, 0x06, 0xa1, 0xa8, 0x60, 0x42, 0x79, 0x0a, 0x11, 0xe3,
+    0x18, 0x8a, 0x06, 0xf5, 0x96, 0x66, 0x71, 0x7f, 0xcb, 0x56, 0x2e, 0x8e, 0xe5, 0x2c, 0x31, 0x9c,
+    0xfd, 0x25, 0x4f, 0x1e, 0xb5, 0x19, 0x43, 0x0d, 0x55, 0x55, 0xe5, 0xfb, 0x4b, 0xc6, 0xc6, 0x59,
+    0xe3, 0xa8, 0xc8, 0x51, 0x5f, 0x72, 0x4a, 0xb1, 0x81, 0x4a, 0x31, 0x81, 0x9a, 0x18, 0xce, 0x08,
+    0xbc, 0xcf, 0x36, 0x6e, 0x48, 0xcb, 0x2e, 0xb9, 0x05, 0x68, 0xd9, 0xb2, 0x98, 0x5b, 0x2a, 0x55,
+    0x96, 0xea, 0xa6, 0x4e, 0xd0, 0xe7, 0x85, 0x9d, 0x26, 0x45, 0xea, 0xba, 0xb0, 0xaa, 0x72, 0x9e,
+    0x62, 0xfa, 0x6a, 0xb8, 0x2e, 0xd6, 0xce, 0xbf, 0xed, 0xee, 0x67, 0xdf, 0x0f, 0x1f, 0x00, 0x4c,
+    0x43, 0xde, 0x0f, 0xd3, 0x68, 0xcb, 0x48, 0xcb, 0x0c, 0x7f, 0x24, 0xef, 0xd8, 0xd1, 0x27, 0xd1,
+    0x9c, 0x86, 0x76, 0x19, 0xf0, 0x40, 0x3f, 0xa2, 0x7b, 0x9a, 0xf6, 0xc2, 0xb1, 0xef, 0xd1, 0xce,
+    0xc1, 0x95, 0x9a, 0x40, 0xaf, 0xc1, 0xbb, 0xb4, 0xe6, 0x0a, 0x1d, 0xfb, 0x96, 0xe6, 0x02, 0x1f,
+    0x73, 0x33, 0x17, 0xf8, 0x07, 0x87, 0x37, 0x7f, 0x00, 0xd1, 0x03, 0x00, 0x00,
+};
+
+// prov.js: 1489 bytes, gzip 515 bytes
+static const uint8_t ASSET_PROV_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x54, 0x4d, 0x6f, 0xdb, 0x30,
+    0x0c, 0xbd, 0xfb, 0x57, 0x68, 0x27, 0x2b, 0x68, 0xe3, 0xed, 0x9e, 0xf5, 0xd0, 0xae, 0x1d, 0x50,
+    0xa0, 0xfb, 0x00, 0x02, 0xec, 0x32, 0xec, 0xa0, 0x48, 0xb4, 0x2b, 0x44, 0x96, 0x32, 0x7d, 0x18,
+    0x0b, 0xd6, 0xfc, 0xf7, 0x51, 0x92, 0x9d, 0xb8, 0x4d, 0xea, 0x21, 0xa8, 0x01, 0xc3, 0x96, 0xf8,
+    0x1e, 0x45, 0x3e, 0x92, 0xaa, 0x83, 0xe6, 0x5e, 0x1a, 0x4d, 0xc2, 0x46, 0x30, 0x0f, 0xdf, 0xad,
+    0xe9, 0xa4, 0xc3, 0xb5, 0xd4, 0xcd, 0xd2, 0x33, 0x1f, 0x1c, 0x9d, 0x91, 0xbf, 0x05, 0x21, 0x1d,
+    0xb3, 0xa4, 0x36, 0xb6, 0x25, 0x57, 0x44, 0x18, 0x1e, 0x5a, 0xd0, 0xbe, 0x6a, 0xc0, 0xdf, 0x29,
+    0x88, 0xbf, 0x37, 0xdb, 0x7b, 0x41, 0xcb, 0x0d, 0x92, 0x3f, 0x23, 0xa6, 0x9c, 0x2d, 0x06, 0x86,
+    0x04, 0x25, 0x1c, 0x72, 0x22, 0xb5, 0xfa, 0x1d, 0xc0, 0x6e, 0x97, 0xa0, 0x80, 0x7b, 0x63, 0xaf,
+    0x95, 0xa2, 0xa5, 0xd4, 0x9b, 0xe0, 0x2f, 0x89, 0x4b, 0x7b, 0x07, 0x1a, 0x53, 0xea, 0x07, 0x53,
+    0x52, 0x20, 0xd1, 0xdb, 0x00, 0x71, 0x1b, 0x1d, 0x10, 0x1a, 0x6d, 0x12, 0x37, 0x3f, 0x2c, 0xf0,
+    0xf3, 0xb1, 0xf7, 0x5e, 0x29, 0xd0, 0x8d, 0x7f, 0xc4, 0xad, 0x8b, 0x8b, 0x1c, 0x2b, 0x21, 0xb2,
+    0x26, 0xf4, 0x5d, 0x36, 0xff, 0x94, 0xbf, 0x2a, 0xfe, 0x08, 0x7c, 0x9d, 0x3c, 0x4a, 0xbf, 0xa5,
+    0xb3, 0x01, 0x45, 0xc6, 0x07, 0xd5, 0x4c, 0xb9, 0x74, 0x52, 0x7c, 0x56, 0x16, 0xd8, 0x3a, 0x2f,
+    0x76, 0x45, 0x7e, 0xe3, 0xd9, 0x2e, 0x29, 0x32, 0x25, 0x01, 0xaf, 0x7b, 0xd9, 0x0e, 0xc9, 0xac,
+    0xbc, 0x9e, 0x62, 0x38, 0xd6, 0xc1, 0x8d, 0xd7, 0x19, 0x1f, 0xe3, 0x1e, 0x62, 0x1a, 0xa2, 0xcc,
+    0x87, 0x56, 0x1e, 0xfe, 0xf8, 0x4f, 0x46, 0x7b, 0x24, 0xa2, 0xbb, 0x32, 0x87, 0xcd, 0x8d, 0xae,
+    0x65, 0x13, 0x2c, 0x8b, 0x25, 0x2c, 0x17, 0x63, 0x3c, 0x57, 0xcc, 0xb9, 0xaf, 0xac, 0x85, 0x88,
+    0xce, 0x7b, 0xf3, 0x15, 0x13, 0x0d, 0xf4, 0x80, 0xb9, 0x59, 0xf7, 0x04, 0x0c, 0xf0, 0xa5, 0xf7,
+    0x25, 0x06, 0x75, 0xd2, 0x79, 0xc4, 0x3e, 0xf7, 0x8c, 0xc8, 0xb9, 0xc6, 0xea, 0x32, 0x35, 0x82,
+    0x60, 0x2b, 0x31, 0x07, 0xbe, 0x6a, 0x8d, 0x48, 0xa8, 0x11, 0x60, 0x47, 0x00, 0x85, 0x9e, 0xcc,
+    0xed, 0x5e, 0x77, 0x6f, 0xce, 0x0e, 0x17, 0xff, 0x49, 0x4f, 0x4e, 0x9c, 0x72, 0x3a, 0x4d, 0xec,
+    0x41, 0x0e, 0x13, 0x59, 0x1e, 0xec, 0xbb, 0x62, 0x57, 0x14, 0xf5, 0x30, 0x5a, 0x2e, 0xac, 0x5a,
+    0xe9, 0xc7, 0xa3, 0x15, 0xa7, 0x84, 0x42, 0x97, 0x4b, 0x0c, 0x5d, 0xb5, 0xb1, 0xd0, 0x61, 0x6c,
+    0xb7, 0x50, 0xb3, 0xa0, 0x3c, 0x3d, 0xcc, 0xcf, 0xd9, 0x13, 0x77, 0x4e, 0xb7, 0x45, 0x7c, 0x1f,
+    0xfb, 0x51, 0x3a, 0x4f, 0x4f, 0xcf, 0xaa, 0x16, 0x1b, 0x33, 0x43, 0xaf, 0xf6, 0x89, 0x0e, 0x0d,
+    0x9a, 0x66, 0x9b, 0xe5, 0x54, 0xd1, 0xf8, 0x3e, 0x59, 0xa3, 0xc4, 0xc7, 0xf5, 0x7e, 0x09, 0x75,
+    0x7b, 0x54, 0xd1, 0x1b, 0xb3, 0x56, 0x51, 0x01, 0x54, 0x70, 0x9f, 0x06, 0x13, 0xe2, 0x2e, 0x0a,
+    0xf4, 0x20, 0x1d, 0xd6, 0x10, 0x2c, 0x2d, 0x6f, 0xbf, 0x7d, 0xe9, 0x0b, 0xfa, 0x60, 0x98, 0x00,
+    0x51, 0x5e, 0x92, 0x41, 0xef, 0x37, 0xdd, 0x58, 0xe7, 0xe8, 0x97, 0xb3, 0x39, 0x0a, 0x2d, 0x5d,
+    0x6a, 0x18, 0xcf, 0x6b, 0x37, 0x6a, 0xe2, 0x46, 0xc1, 0x8f, 0xa9, 0x5c, 0x49, 0xbe, 0x46, 0xea,
+    0xe9, 0x8e, 0x49, 0xc4, 0xd7, 0xef, 0x69, 0x94, 0x0c, 0xdf, 0x7f, 0x33, 0x80, 0x4e, 0x36, 0xd1,
+    0x05, 0x00, 0x00,
+};
+
+const HestiaHtml::Asset HESTIA_WEB_ASSETS[] = {
+    { HESTIA_ASSET_OTA_CSS, "text/css", ASSET_OTA_CSS_GZ, sizeof(ASSET_OTA_CSS_GZ), "\"396edea0\"" },
+    { HESTIA_ASSET_OTA_JS, "application/javascript", ASSET_OTA_JS_GZ, sizeof(ASSET_OTA_JS_GZ), "\"16f58f8e\"" },
+    { HESTIA_ASSET_PROV_CSS, "text/css", ASSET_PROV_CSS_GZ, sizeof(ASSET_PROV_CSS_GZ), "\"10b1fb5c\"" },
+    { HESTIA_ASSET_PROV_JS, "application/javascript", ASSET_PROV_JS_GZ, sizeof(ASSET_PROV_JS_GZ), "\"718e8b4b\"" },
+};
+
+const size_t HESTIA_WEB_ASSET_COUNT = sizeof(HESTIA_WEB_ASSETS) / sizeof(HESTIA_WEB_ASSETS[0]);
@@ -0,0 +1,14 @@
+#pragma once
+#include "HestiaHtml.h"
+
+// ============================================================================
+//  GENERATED by tools/embed_assets.py from web/ — do not edit by hand.
+// ============================================================================
+
+#define HESTIA_ASSET_OTA_CSS "/hs/ota.396edea0.css"   // 256 → 186 bytes
+#define HESTIA_ASSET_OTA_JS "/hs/ota.16f58f8e.js"   // 1249 → 654 bytes
+#define HESTIA_ASSET_PROV_CSS "/hs/prov.10b1fb5c.css"   // 977 → 461 bytes
+#define HESTIA_ASSET_PROV_JS "/hs/prov.718e8b4b.js"   // 1489 → 515 bytes
+
+extern const HestiaHtml::Asset HESTIA_WEB_ASSETS[];
+extern const size_t HESTIA_WEB_ASSET_COUNT;
@@ -0,0 +1,63 @@
+#pragma once
+// ============================================================================
+//  Host shim — the slice of Arduino's String that HestiaParam.cpp uses.
+//  Only for test/host builds; never on the device include path.
+// ============================================================================
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    String(int v)  : _s(std::to_string(v)) {}
+    String(long v) : _s(std::to_string(v)) {}
+    String(double v, unsigned int decimals) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        _s = buf;
+    }
+
+    const char* c_str() const { return _s.c_str(); }
+    size_t length() const     { return _s.size(); }
+
+    String substring(size_t from) const { return from < _s.size() ? _s.substr(from) : ""; }
+    String substring(size_t from, size_t to) const {
+        if (to > _s.size()) to = _s.size();
+        return from < to ? _s.substr(from, to - from) : "";
+    }
+
+    void trim() {
+        size_t b = 0, e = _s.size();
+        while (b < e && isBlank(_s[b])) ++b;
+        while (e > b && isBlank(_s[e - 1])) --e;
+        _s = _s.substr(b, e - b);
+    }
+
+    void toLowerCase() {
+        for (char& c : _s) if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+    }
+
+    bool equalsIgnoreCase(const String& o) const {
+        return _s.size() == o._s.size() && strcasecmp(_s.c_str(), o._s.c_str()) == 0;
+    }
+
+    String& operator+=(const String& o) { _s += o._s; return *this; }
+    String& operator+=(const char* o)   { _s += o; return *this; }
+    String& operator+=(char c)          { _s += c; return *this; }
+
+    friend String operator+(const String& a, const String& b) { return a._s + b._s; }
+
+    bool operator==(const String& o) const { return _s == o._s; }
+    bool operator==(const char* o) const   { return _s == (o ? o : ""); }
+    bool operator!=(const String& o) const { return _s != o._s; }
+    bool operator!=(const char* o) const   { return !(*this == o); }
+
+private:
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    std::string _s;
+};
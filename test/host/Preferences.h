@@ -0,0 +1,77 @@
+#pragma once
+// ============================================================================
+//  Host shim — Preferences over an in-memory store.
+//  test_nvs_image.cpp fills the store from an NVS partition image, then the
+//  real HestiaParam::loadFromNVS() reads it through this interface.
+// ============================================================================
+#include <map>
+#include <string>
+#include "Arduino.h"
+
+class Preferences {
+public:
+    struct Item {
+        bool        isString = true;
+        std::string str;
+        uint8_t     u8 = 0;
+    };
+    typedef std::map<std::string, std::map<std::string, Item>> Store;
+
+    static Store& store() {
+        static Store s;
+        return s;
+    }
+
+    bool begin(const char* name, bool readOnly = false) {
+        _ns = name;
+        _readOnly = readOnly;
+        _open = true;
+        return true;
+    }
+
+    void end() { _open = false; }
+
+    bool isKey(const char* key) {
+        if (!_open) return false;
+        const auto& ns = store()[_ns];
+        return ns.find(key) != ns.end();
+    }
+
+    String getString(const char* key, const String& def = String()) {
+        const Item* it = find(key);
+        return (it && it->isString) ? String(it->str) : def;
+    }
+
+    uint8_t getUChar(const char* key, uint8_t def = 0) {
+        const Item* it = find(key);
+        return (it && !it->isString) ? it->u8 : def;
+    }
+
+    size_t putString(const char* key, const String& value) {
+        if (!_open || _readOnly) return 0;
+        Item& it = store()[_ns][key];
+        it.isString = true;
+        it.str = value.c_str();
+        return value.length();
+    }
+
+    size_t putUChar(const char* key, uint8_t value) {
+        if (!_open || _readOnly) return 0;
+        Item& it = store()[_ns][key];
+        it.isString = false;
+        it.u8 = value;
+        return 1;
+    }
+
+private:
+    const Item* find(const char* key) {
+        if (!_open) return nullptr;
+        const auto& ns = store()[_ns];
+        auto it = ns.find(key);
+        return it == ns.end() ? nullptr : &it->second;
+    }
+
+    std::string _ns;
+    bool _readOnly = false;
+    bool _open = false;
+};
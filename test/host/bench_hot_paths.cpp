@@ -0,0 +1,210 @@
+// ============================================================================
+//  bench_hot_paths — host microbenchmark of the per-message lookups
+//
+//    • HestiaTopicIndex insert/find (inbound dispatch, HestiaCore::findByTopic)
+//      against the linear strcmp scan it replaced, from 10 to 1000 topics
+//    • HestiaFixed parseScaled/formatScaled (typed bridge slots) against
+//      strtod/snprintf
+//
+//  Each section checks its results before timing them; any mismatch exits 1.
+//  Absolute numbers are host numbers — compare the ratios, not the ns, with
+//  the ESP32.
+//
+//      c++ -std=gnu++17 -O2 -Isrc test/host/bench_hot_paths.cpp -o bench_hot_paths
+//      ./bench_hot_paths
+// ============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "HestiaTopicIndex.h"
+#include "HestiaFixed.h"
+
+namespace {
+
+  int g_failures = 0;
+  volatile uint32_t g_sink = 0;   // Keeps timed results observable
+
+  void fail(const char* what, const char* detail) {
+    fprintf(stderr, "FAIL: %s: %s\n", what, detail);
+    g_failures++;
+  }
+
+  // ns per call of fn(i) over `iters` calls
+  template <typename Fn>
+  double timeNs(size_t iters, Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; ++i) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)iters;
+  }
+
+  // ==========================================================================
+  //  Topic index
+  // ==========================================================================
+  std::vector<std::string> g_topics;
+
+  const char* topicOf(uint16_t row) { return g_topics[row].c_str(); }
+
+  void benchTopicIndex(size_t count, size_t iters) {
+    g_topics.clear();
+    std::vector<std::string> misses;
+    for (size_t i = 0; i < count; ++i) {
+      g_topics.push_back("hestia/virgo/entity_" + std::to_string(i) + "/set");
+      misses.push_back("hestia/virgo/other_" + std::to_string(i) + "/set");
+    }
+
+    size_t slots = HestiaTopicIndex::slotsFor(count);
+    std::vector<uint16_t> table(slots, HestiaTopicIndex::SLOT_EMPTY);
+    uint32_t mask = (uint32_t)(slots - 1);
+    uint32_t seed = HestiaHash::FNV_OFFSET;
+
+    int maxProbe = 0;
+    long sumProbe = 0;   // Insert probe = extra slots a hit on that topic visits
+    for (size_t i = 0; i < count; ++i) {
+      uint16_t existing;
+      int probe = HestiaTopicIndex::insert(table.data(), mask, seed, (uint16_t)i, topicOf, existing);
+      if (probe < 0) fail("insert", g_topics[i].c_str());
+      if (probe > maxProbe) maxProbe = probe;
+      sumProbe += probe > 0 ? probe : 0;
+    }
+
+    uint16_t existing = HestiaTopicIndex::SLOT_EMPTY;
+    g_topics.push_back(g_topics[0]);   // Duplicate topic on a new row
+    if (HestiaTopicIndex::insert(table.data(), mask, seed, (uint16_t)count, topicOf, existing) != -1 ||
+        existing != 0) {
+      fail("insert", "duplicate topic not reported");
+    }
+    g_topics.pop_back();
+
+    for (size_t i = 0; i < count; ++i) {
+      if (HestiaTopicIndex::find(table.data(), mask, seed, g_topics[i].c_str(), topicOf) != i)
+        fail("find hit", g_topics[i].c_str());
+      if (HestiaTopicIndex::find(table.data(), mask, seed, misses[i].c_str(), topicOf) != HestiaTopicIndex::SLOT_EMPTY)
+        fail("find miss", misses[i].c_str());
+    }
+
+    auto linear = [&](const char* topic) -> uint16_t {
+      for (size_t r = 0; r < count; ++r) {
+        if (strcmp(g_topics[r].c_str(), topic) == 0) return (uint16_t)r;
+      }
+      return HestiaTopicIndex::SLOT_EMPTY;
+    };
+
+    double hit = timeNs(iters, [&](size_t i) {
+      g_sink += HestiaTopicIndex::find(table.data(), mask, seed, g_topics[i % count].c_str(), topicOf);
+    });
+    double miss = timeNs(iters, [&](size_t i) {
+      g_sink += HestiaTopicIndex::find(table.data(), mask, seed, misses[i % count].c_str(), topicOf);
+    });
+    double scanHit = timeNs(iters, [&](size_t i) { g_sink += linear(g_topics[i % count].c_str()); });
+    double scanMiss = timeNs(iters, [&](size_t i) { g_sink += linear(misses[i % count].c_str()); });
+
+    printf("  %4zu topics %5zu slots  probe avg %.2f max %2d | index hit %5.1f ns  miss %5.1f ns"
+           " | scan hit %7.1f ns  miss %7.1f ns\n",
+           count, slots, (double)sumProbe / (double)count, maxProbe, hit, miss, scanHit, scanMiss);
+  }
+
+  // ==========================================================================
+  //  Fixed-point conversions
+  // ==========================================================================
+  struct ParseCase {
+    const char* text;
+    uint8_t     dec;
+    bool        ok;
+    int32_t     value;
+    const char* formatted;   // formatScaled(value, dec)
+  };
+
+  const ParseCase kCases[] = {
+    { "21.46",        1, true,  215,        "21.5"        },
+    { "21.45",        1, true,  215,        "21.5"        },   // strtod gives 21.449999…
+    { "-0.04",        1, true,  0,          "0.0"         },
+    { "-0.05",        1, true,  -1,         "-0.1"        },
+    { "7",            1, true,  70,         "7.0"         },
+    { "7",            0, true,  7,          "7"           },
+    { "0.001",        3, true,  1,          "0.001"       },
+    { "-12.5",        2, true,  -1250,      "-12.50"      },
+    { "2147.483647",  6, true,  2147483647, "2147.483647" },
+    { "2147.483648",  6, false, 0,          nullptr       },
+    { "1.2.3",        1, false, 0,          nullptr       },
+    { "abc",          0, false, 0,          nullptr       },
+    { "-",            0, false, 0,          nullptr       },
+    { "unavailable",  1, false, 0,          nullptr       },
+  };
+
+  void checkFixed() {
+    char buf[HestiaFixed::FMT_BUF];
+    for (const ParseCase& c : kCases) {
+      int32_t v = 0;
+      bool ok = HestiaFixed::parseScaled(c.text, c.dec, v);
+      if (ok != c.ok || (ok && v != c.value)) fail("parseScaled", c.text);
+      if (c.formatted && strcmp(HestiaFixed::formatScaled(c.value, c.dec, buf), c.formatted) != 0)
+        fail("formatScaled", c.formatted);
+    }
+    int32_t r[3];
+    if (!HestiaFixed::rescale(215, 1, 0, r[0]) || !HestiaFixed::rescale(-215, 1, 0, r[1]) ||
+        !HestiaFixed::rescale(22, 0, 2, r[2]) || r[0] != 22 || r[1] != -22 || r[2] != 2200) {
+      fail("rescale", "rounding");
+    }
+    // write(300000) on a 0.0001-resolution entity: must report, not wrap
+    if (HestiaFixed::rescale(300000, 0, 4, r[0]) || r[0] != INT32_MAX ||
+        HestiaFixed::rescale(-300000, 0, 4, r[1]) || r[1] != INT32_MIN) {
+      fail("rescale", "int32 overflow not reported");
+    }
+    if (!HestiaFixed::rescale(INT32_MIN, 6, 5, r[2]) || r[2] != -214748365) {
+      fail("rescale", "rounding at INT32_MIN");
+    }
+  }
+
+  void benchFixed(size_t iters) {
+    static const char* const payloads[] = { "21.46", "-3.5", "1013.2", "0.07", "100", "-0.04", "57.123" };
+    constexpr size_t N = sizeof(payloads) / sizeof(payloads[0]);
+    constexpr uint8_t DEC = 1;
+
+    double parse = timeNs(iters, [&](size_t i) {
+      int32_t v = 0;
+      HestiaFixed::parseScaled(payloads[i % N], DEC, v);
+      g_sink += (uint32_t)v;
+    });
+    double parseFloat = timeNs(iters, [&](size_t i) {
+      g_sink += (uint32_t)lround(strtod(payloads[i % N], nullptr) * 10.0);
+    });
+
+    char buf[HestiaFixed::FMT_BUF];
+    char fbuf[32];
+    double format = timeNs(iters, [&](size_t i) {
+      g_sink += (uint8_t)HestiaFixed::formatScaled((int32_t)(i * 37) - 50000, DEC, buf)[0];
+    });
+    double formatFloat = timeNs(iters, [&](size_t i) {
+      snprintf(fbuf, sizeof(fbuf), "%.*f", DEC, ((double)(i * 37) - 50000.0) / 10.0);
+      g_sink += (uint8_t)fbuf[0];
+    });
+
+    printf("  parseScaled  %6.1f ns   strtod+lround %6.1f ns\n", parse, parseFloat);
+    printf("  formatScaled %6.1f ns   snprintf %%.1f  %6.1f ns\n", format, formatFloat);
+  }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoul(argv[1], nullptr, 10) : 2000000;
+
+  printf("Topic index (HestiaTopicIndex vs linear scan), %zu lookups each\n", iters);
+  for (size_t count : { 10, 32, 100, 320, 1000 }) benchTopicIndex(count, iters);
+
+  checkFixed();
+  printf("Fixed-point conversions (HestiaFixed, 1 decimal), %zu calls each\n", iters);
+  benchFixed(iters);
+
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  return 0;
+}
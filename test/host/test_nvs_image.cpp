@@ -0,0 +1,237 @@
+// ============================================================================
+//  test_nvs_image — host round trip of a tools/gen_nvs_image.py image
+//
+//  Parses the NVS partition image (ESP-IDF page format v2, written here
+//  independently of the Python reader), loads it into the Preferences shim,
+//  then runs the firmware's own HestiaParam::loadFromNVS() over the
+//  parameter table and checks that every provisioning value comes back as
+//  expected, validates, and that a lazyInit boot would not rewrite anything.
+//
+//  Usage: test_nvs_image <image.nvs.bin> <expected.tsv>
+//         expected.tsv: one "key<TAB>value" line per provisioning parameter
+//
+//  Built and driven by test/host/test_nvs_image.py.
+// ============================================================================
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "HestiaParam.h"
+
+#ifndef HESTIA_TEST_PARAMS
+#define HESTIA_TEST_PARAMS "../../examples/Virgo/DeviceParamsTable.h"
+#endif
+#include HESTIA_TEST_PARAMS
+
+namespace {
+
+  constexpr size_t   PAGE_SIZE        = 4096;
+  constexpr size_t   ENTRY_SIZE       = 32;
+  constexpr size_t   ENTRIES_PER_PAGE = 126;
+  constexpr size_t   ENTRY_OFFSET     = 64;
+  constexpr uint32_t PAGE_EMPTY       = 0xFFFFFFFF;
+  constexpr uint8_t  PAGE_VERSION_2   = 0xFE;
+  constexpr uint8_t  TYPE_U8          = 0x01;
+  constexpr uint8_t  TYPE_SZ          = 0x21;
+  constexpr uint8_t  ENTRY_WRITTEN    = 2;
+
+  int g_failures = 0;
+
+  void fail(const std::string& what) {
+    fprintf(stderr, "FAIL: %s\n", what.c_str());
+    g_failures++;
+  }
+
+  // crc32_le(0xFFFFFFFF, …) as nvs_flash computes it (zlib.crc32 with that seed).
+  uint32_t crc32(const uint8_t* p, size_t n, uint32_t seed = 0xFFFFFFFF) {
+    uint32_t crc = ~seed;
+    while (n--) {
+      crc ^= *p++;
+      for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+  }
+
+  uint32_t rd32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+  uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+  // Entry CRC covers bytes 0..3 and 8..31 (the CRC field itself excluded).
+  uint32_t entryCrc(const uint8_t* e) {
+    uint8_t buf[28];
+    memcpy(buf, e, 4);
+    memcpy(buf + 4, e + 8, 24);
+    return crc32(buf, sizeof(buf));
+  }
+
+  struct RawItem {
+    uint8_t                ns;
+    std::string            key;
+    Preferences::Item      item;
+  };
+
+  // Every WRITTEN entry of every initialized page → the Preferences store.
+  bool loadImage(const std::vector<uint8_t>& image) {
+    if (image.empty() || image.size() % PAGE_SIZE) {
+      fail("image size is not a multiple of 4096");
+      return false;
+    }
+
+    std::map<uint8_t, std::string> names;
+    std::vector<RawItem> items;
+
+    for (size_t off = 0; off < image.size(); off += PAGE_SIZE) {
+      const uint8_t* page = image.data() + off;
+      if (rd32(page) == PAGE_EMPTY) continue;
+      if (page[8] != PAGE_VERSION_2) fail("page " + std::to_string(off / PAGE_SIZE) + ": not format version 2");
+      if (rd32(page + 28) != crc32(page + 4, 24)) {
+        fail("page " + std::to_string(off / PAGE_SIZE) + ": header CRC");
+        return false;
+      }
+
+      for (size_t i = 0; i < ENTRIES_PER_PAGE; ) {
+        uint8_t state = (page[32 + i / 4] >> (2 * (i % 4))) & 3;
+        if (state != ENTRY_WRITTEN) { ++i; continue; }
+
+        const uint8_t* e = page + ENTRY_OFFSET + i * ENTRY_SIZE;
+        uint8_t span = e[2];
+        std::string key((const char*)e + 8, strnlen((const char*)e + 8, 16));
+        if (span == 0 || i + span > ENTRIES_PER_PAGE) {
+          fail("'" + key + "': bad span");
+          return false;
+        }
+        if (rd32(e + 4) != entryCrc(e)) fail("'" + key + "': entry CRC");
+
+        RawItem raw{ e[0], key, {} };
+        if (e[1] == TYPE_U8) {
+          raw.item.isString = false;
+          raw.item.u8 = e[24];
+        } else if (e[1] == TYPE_SZ) {
+          uint16_t size = rd16(e + 24);
+          const uint8_t* data = e + ENTRY_SIZE;
+          if (size == 0 || size > (span - 1) * ENTRY_SIZE) {
+            fail("'" + key + "': string size exceeds its span");
+            return false;
+          }
+          if (rd32(e + 28) != crc32(data, size)) fail("'" + key + "': data CRC");
+          if (data[size - 1] != '\0') fail("'" + key + "': string not NUL-terminated");
+          raw.item.str.assign((const char*)data, size - 1);
+        } else {
+          fail("'" + key + "': unexpected type");
+        }
+
+        if (raw.ns == 0) names[raw.item.u8] = key;
+        else             items.push_back(raw);
+        i += span;
+      }
+    }
+
+    for (const RawItem& r : items) {
+      auto ns = names.find(r.ns);
+      if (ns == names.end()) {
+        fail("'" + r.key + "': unknown namespace index");
+        continue;
+      }
+      Preferences::store()[ns->second][r.key] = r.item;
+    }
+    return true;
+  }
+
+  std::map<std::string, std::string> loadExpected(const char* path) {
+    std::map<std::string, std::string> out;
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+      size_t tab = line.find('\t');
+      if (tab == std::string::npos) continue;
+      out[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+    return out;
+  }
+
+  // HestiaParam::nvsKey(): keys over 15 characters keep their last 15.
+  std::string nvsKey(const std::string& key) {
+    return key.size() <= 15 ? key : key.substr(key.size() - 15);
+  }
+
+  bool sameStore(const Preferences::Store& a, const Preferences::Store& b) {
+    if (a.size() != b.size()) return false;
+    for (const auto& ns : a) {
+      auto other = b.find(ns.first);
+      if (other == b.end() || other->second.size() != ns.second.size()) return false;
+      for (const auto& kv : ns.second) {
+        auto it = other->second.find(kv.first);
+        if (it == other->second.end() || it->second.isString != kv.second.isString ||
+            it->second.str != kv.second.str || it->second.u8 != kv.second.u8) return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s <image.nvs.bin> <expected.tsv>\n", argv[0]);
+    return 2;
+  }
+
+  std::ifstream in(argv[1], std::ios::binary);
+  std::vector<uint8_t> image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (!loadImage(image)) return 1;
+
+  std::map<std::string, std::string> expected = loadExpected(argv[2]);
+  const Preferences::Store before = Preferences::store();
+  const auto& stored = before.count(HestiaParam::NVS_NAMESPACE)
+                       ? before.at(HestiaParam::NVS_NAMESPACE)
+                       : std::map<std::string, Preferences::Item>();
+
+  size_t checked = 0;
+  const char* fwDefault = "";
+  for (const HestiaConfig::ParamDescriptor& d : HESTIA_PARAM_TABLE) {
+    if (strcmp(d.key, "version_prog") == 0) fwDefault = d.defaultValue;
+    if (!(d.flags & HestiaConfig::PF_PROVISIONING)) continue;
+
+    if (!stored.count(nvsKey(d.key))) {
+      fail(std::string(d.key) + ": missing from the image");
+      continue;
+    }
+
+    HestiaParam p(&d);
+    Preferences prefs;
+    prefs.begin(HestiaParam::NVS_NAMESPACE, false);
+    p.loadFromNVS(prefs, true);   // First boot: lazyInit may heal/write
+    prefs.end();
+
+    auto want = expected.find(d.key);
+    if (want == expected.end()) {
+      fail(std::string(d.key) + ": no expected value given");
+    } else if (want->second != p.c_str()) {
+      fail(std::string(d.key) + ": loaded '" + p.c_str() + "', expected '" + want->second + "'");
+    }
+    if (!p.validateValue()) fail(std::string(d.key) + ": '" + p.c_str() + "' does not validate");
+    checked++;
+  }
+
+  auto force = stored.find("force_prov");
+  if (force == stored.end() || force->second.isString || force->second.u8 != 0) {
+    fail("force_prov: expected u8 0");
+  }
+  auto fw = stored.find("last_fw_id");
+  if (fw == stored.end() || !fw->second.isString || fw->second.str != fwDefault) {
+    fail(std::string("last_fw_id: expected '") + fwDefault + "'");
+  }
+
+  if (!sameStore(before, Preferences::store())) {
+    fail("loadFromNVS(lazyInit) rewrote NVS: the image differs from a provisioned device");
+  }
+
+  if (g_failures) return 1;
+  printf("%s: %zu provisioning parameters round-trip\n", argv[1], checked);
+  return 0;
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+test_nvs_image.py — tools/gen_nvs_image.py checked against the firmware
+
+    python3 test/host/test_nvs_image.py
+
+  • Round trip: images generated for the Virgo schema are parsed by
+    test_nvs_image.cpp (built here with the host compiler against the real
+    src/HestiaParam.cpp and the Preferences shim) and loaded through
+    HestiaParam::loadFromNVS()
+  • Byte-level: the same entries written by ESP-IDF's nvs_partition_gen.py
+    must give an identical image. Runs when the generator is found
+    (NVS_PARTITION_GEN=<path to nvs_partition_gen.py>, $IDF_PATH, or the
+    esp-idf-nvs-partition-gen pip package), skipped otherwise.
+
+Needs Python 3 and a C++17 compiler ($CXX, default c++).
+"""
+
+import csv
+import importlib.util
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.normpath(os.path.join(HERE, "..", ".."))
+TOOL = os.path.join(ROOT, "tools", "gen_nvs_image.py")
+SCHEMA = os.path.join(ROOT, "examples", "Virgo", "DeviceParams.h")
+TABLE = os.path.join(ROOT, "examples", "Virgo", "DeviceParamsTable.h")
+PARTITION_SIZE = "0x5000"
+
+sys.path.insert(0, os.path.join(ROOT, "tools"))
+import gen_nvs_image  # noqa: E402
+from gen_device_params import nvs_key  # noqa: E402
+
+# Virgo provisioning parameters; empty cells fall back to the schema default.
+DEVICES = [
+    {"image": "virgo-001", "wifi_ssid": "Factory", "wifi_pass": "secret-001",
+     "mqtt_ip": "192.168.1.10", "mqtt_port": "", "mqtt_user": "virgo",
+     "mqtt_pass": "pw", "timezone": "", "iot_user": "", "iot_pass": ""},
+    # Padded cells (trimmed on both sides), UTF-8, and 64-byte strings whose
+    # data spans several entries
+    {"image": "virgo-002", "wifi_ssid": "  Café Wi-Fi ", "wifi_pass": "p" * 64,
+     "mqtt_ip": " 10.1.1.2", "mqtt_port": "8883 ", "mqtt_user": "u" * 64,
+     "mqtt_pass": "q" * 64, "timezone": "Europe/Paris", "iot_user": "i" * 64,
+     "iot_pass": "j" * 64},
+]
+
+
+def find_nvs_partition_gen():
+    """Command prefix running ESP-IDF's NVS generator, or None."""
+    path = os.environ.get("NVS_PARTITION_GEN")
+    if not path and os.environ.get("IDF_PATH"):
+        path = os.path.join(os.environ["IDF_PATH"], "components", "nvs_flash",
+                            "nvs_partition_generator", "nvs_partition_gen.py")
+    if path and os.path.isfile(path):
+        return [sys.executable, path]
+    if importlib.util.find_spec("esp_idf_nvs_partition_gen"):
+        return [sys.executable, "-m", "esp_idf_nvs_partition_gen"]
+    return None
+
+
+class NvsImageTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.mkdtemp(prefix="hestia-nvs-")
+        cls.params = gen_nvs_image.load_schema(SCHEMA)
+
+        cls.csv = os.path.join(cls.tmp, "devices.csv")
+        with open(cls.csv, "w", newline="", encoding="utf-8") as f:
+            w = csv.DictWriter(f, fieldnames=list(DEVICES[0]))
+            w.writeheader()
+            w.writerows(DEVICES)
+
+        out = os.path.join(cls.tmp, "images")
+        subprocess.run([sys.executable, TOOL, SCHEMA, cls.csv, "-d", out, "--size", PARTITION_SIZE],
+                       check=True, stdout=subprocess.DEVNULL)
+        cls.images = {d["image"]: os.path.join(out, d["image"] + ".nvs.bin") for d in DEVICES}
+
+        cls.harness = os.path.join(cls.tmp, "test_nvs_image")
+        cxx = os.environ.get("CXX", "c++")
+        subprocess.run([cxx, "-std=gnu++17", "-Wall", "-O1",
+                        "-I", HERE, "-I", os.path.join(ROOT, "src"),
+                        f'-DHESTIA_TEST_PARAMS="{TABLE}"',
+                        os.path.join(HERE, "test_nvs_image.cpp"),
+                        os.path.join(ROOT, "src", "HestiaParam.cpp"),
+                        "-o", cls.harness], check=True)
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.tmp, ignore_errors=True)
+
+    def expected_values(self, device):
+        values, errors = gen_nvs_image.build_values(self.params, device, device["image"])
+        self.assertEqual(errors, [])
+        return values
+
+    def test_round_trip_through_load_from_nvs(self):
+        for device in DEVICES:
+            with self.subTest(image=device["image"]):
+                tsv = os.path.join(self.tmp, device["image"] + ".tsv")
+                with open(tsv, "w", encoding="utf-8") as f:
+                    for key, value in self.expected_values(device).items():
+                        f.write(f"{key}\t{value}\n")
+                run = subprocess.run([self.harness, self.images[device["image"]], tsv],
+                                     capture_output=True, text=True)
+                self.assertEqual(run.returncode, 0, run.stderr)
+
+    def test_padded_cells_are_stored_trimmed(self):
+        values = self.expected_values(DEVICES[1])
+        self.assertEqual(values["wifi_ssid"], "Café Wi-Fi")
+        self.assertEqual(values["mqtt_port"], "8883")
+
+    def test_matches_nvs_partition_gen(self):
+        gen = find_nvs_partition_gen()
+        if not gen:
+            self.skipTest("nvs_partition_gen.py not found (set NVS_PARTITION_GEN or IDF_PATH)")
+
+        fw_id = next(str(p.get("default", "")) for p in self.params if p["key"] == "version_prog")
+        for device in DEVICES:
+            with self.subTest(image=device["image"]):
+                # Same entries, same order as gen_nvs_image.py writes them
+                ref_csv = os.path.join(self.tmp, device["image"] + ".ref.csv")
+                with open(ref_csv, "w", newline="", encoding="utf-8") as f:
+                    w = csv.writer(f)
+                    w.writerow(["key", "type", "encoding", "value"])
+                    w.writerow([gen_nvs_image.NAMESPACE, "namespace", "", ""])
+                    for key, value in self.expected_values(device).items():
+                        w.writerow([nvs_key(key), "data", "string", value])
+                    w.writerow([gen_nvs_image.KEY_FORCE_PROV, "data", "u8", "0"])
+                    w.writerow([gen_nvs_image.KEY_LAST_FW_ID, "data", "string", fw_id])
+
+                ref = os.path.join(self.tmp, device["image"] + ".ref.bin")
+                subprocess.run(gen + ["generate", ref_csv, ref, PARTITION_SIZE],
+                               check=True, stdout=subprocess.DEVNULL)
+
+                with open(ref, "rb") as f:
+                    expected = f.read()
+                with open(self.images[device["image"]], "rb") as f:
+                    actual = f.read()
+                self.assertEqual(len(actual), len(expected))
+                diff = next((i for i in range(len(actual)) if actual[i] != expected[i]), None)
+                self.assertIsNone(diff, f"first differing byte at 0x{diff or 0:x}")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+embed_assets.py — web/*.css|*.js → gzip-compressed flash assets
+
+Compresses every static asset of the provisioning portal and OTA UI and
+writes them as PROGMEM byte arrays, together with a HestiaHtml::Asset table
+(see src/HestiaHtml.h) that the web servers register as GET routes:
+
+    src/HestiaWebAssets.h    path macros (HESTIA_ASSET_PROV_CSS, ...) + table declaration
+    src/HestiaWebAssets.cpp  compressed data + HESTIA_WEB_ASSETS[] table
+
+Each URL embeds the first 8 hex digits of the content hash
+("/hs/prov.1a2b3c4d.css"), so responses can be cached as immutable: a new
+firmware with a changed asset references a new URL. The hash is also the
+ETag, for clients that revalidate anyway.
+
+Usage:
+    python3 tools/embed_assets.py                  # web/ → src/
+    python3 tools/embed_assets.py -i web -o src
+
+Compression is deterministic (mtime 0), so unchanged assets regenerate
+byte-identical files. Re-run whenever a file under web/ changes.
+"""
+
+import argparse
+import gzip
+import os
+import re
+import sys
+
+MIME = {
+    ".css":  "text/css",
+    ".js":   "application/javascript",
+    ".html": "text/html",
+    ".svg":  "image/svg+xml",
+}
+
+URL_PREFIX = "/hs/"
+
+
+def fnv1a(data):
+    """Same hash as HestiaHash::fnv1a()."""
+    h = 2166136261
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def symbol(name):
+    """prov.css → PROV_CSS"""
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def c_bytes(data, indent="    ", per_line=16):
+    rows = []
+    for i in range(0, len(data), per_line):
+        rows.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + per_line]) + ",")
+    return "\n".join(rows)
+
+
+def load_assets(in_dir):
+    assets = []
+    for name in sorted(os.listdir(in_dir)):
+        ext = os.path.splitext(name)[1]
+        if ext not in MIME:
+            continue
+        with open(os.path.join(in_dir, name), "rb") as f:
+            raw = f.read()
+        gz = gzip.compress(raw, compresslevel=9, mtime=0)
+        h = fnv1a(raw)
+        stem, _ = os.path.splitext(name)
+        assets.append({
+            "name": name,
+            "sym":  symbol(name),
+            "path": f"{URL_PREFIX}{stem}.{h:08x}{ext}",
+            "mime": MIME[ext],
+            "etag": f"{h:08x}",
+            "raw":  len(raw),
+            "gz":   gz,
+        })
+    return assets
+
+
+def write_header(assets, path):
+    out = [
+        "#pragma once",
+        '#include "HestiaHtml.h"',
+        "",
+        "// ============================================================================",
+        "//  GENERATED by tools/embed_assets.py from web/ — do not edit by hand.",
+        "// ============================================================================",
+        "",
+    ]
+    for a in assets:
+        out.append(f'#define HESTIA_ASSET_{a["sym"]} "{a["path"]}"   // {a["raw"]} → {len(a["gz"])} bytes')
+    out += [
+        "",
+        "extern const HestiaHtml::Asset HESTIA_WEB_ASSETS[];",
+        "extern const size_t HESTIA_WEB_ASSET_COUNT;",
+        "",
+    ]
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def write_source(assets, path):
+    out = [
+        '#include <Arduino.h>',
+        '#include "HestiaWebAssets.h"',
+        "",
+        "// ============================================================================",
+        "//  GENERATED by tools/embed_assets.py from web/ — do not edit by hand.",
+        "// ============================================================================",
+        "",
+    ]
+    for a in assets:
+        out.append(f'// {a["name"]}: {a["raw"]} bytes, gzip {len(a["gz"])} bytes')
+        out.append(f'static const uint8_t ASSET_{a["sym"]}_GZ[] PROGMEM = {{')
+        out.append(c_bytes(a["gz"]))
+        out.append("};")
+        out.append("")
+    out.append("const HestiaHtml::Asset HESTIA_WEB_ASSETS[] = {")
+    for a in assets:
+        out.append(f'    {{ HESTIA_ASSET_{a["sym"]}, "{a["mime"]}", ASSET_{a["sym"]}_GZ, '
+                   f'sizeof(ASSET_{a["sym"]}_GZ), "\\"{a["etag"]}\\"" }},')
+    out.append("};")
+    out.append("")
+    out.append("const size_t HESTIA_WEB_ASSET_COUNT = sizeof(HESTIA_WEB_ASSETS) / sizeof(HESTIA_WEB_ASSETS[0]);")
+    out.append("")
+    with open(path, "w") as f:
+        f.write("\n".join(out))
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("-i", "--input", default=os.path.join(root, "web"), help="asset directory")
+    ap.add_argument("-o", "--output", default=os.path.join(root, "src"), help="output directory")
+    args = ap.parse_args()
+
+    assets = load_assets(args.input)
+    if not assets:
+        sys.exit(f"{args.input}: no web assets found")
+
+    write_header(assets, os.path.join(args.output, "HestiaWebAssets.h"))
+    write_source(assets, os.path.join(args.output, "HestiaWebAssets.cpp"))
+
+    total_raw = sum(a["raw"] for a in assets)
+    total_gz = sum(len(a["gz"]) for a in assets)
+    for a in assets:
+        print(f'{a["path"]:<28} {a["raw"]:>6} → {len(a["gz"]):>5} bytes')
+    print(f"{len(assets)} asset(s): {total_raw} → {total_gz} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+gen_device_params.py — DeviceParams.h JSON schema → flash descriptor table
+
+Reads the HESTIA_PARAM_JSON raw string of a project's DeviceParams.h and
+writes a header holding the same schema as a constant ParamDescriptor table
+(see src/HestiaParamSchema.h), so the firmware no longer parses JSON at boot:
+
+    static const HestiaConfig::ParamDescriptor HESTIA_PARAM_TABLE[] = { ... };
+    static constexpr size_t HESTIA_PARAM_COUNT = ...;
+
+Usage:
+    python3 tools/gen_device_params.py examples/Virgo/DeviceParams.h
+    python3 tools/gen_device_params.py DeviceParams.h -o DeviceParamsTable.h
+
+The schema is validated on the way (unknown type/pattern, duplicate keys,
+keys colliding after NVS shortening); any error aborts without writing.
+Re-run whenever DeviceParams.h changes.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+TYPES = {
+    "string": "STRING",
+    "int":    "INT",
+    "bool":   "BOOL",
+    "float":  "FLOAT",
+    "number": "NUMBER",
+}
+
+PATTERNS = {
+    "anything": "ANYTHING",
+    "ip":       "IP",
+    "hostname": "HOSTNAME",
+    "url":      "URL",
+    "email":    "EMAIL",
+    "bool":     "BOOL",
+}
+
+NVS_KEY_MAX = 15
+
+
+def nvs_key(key):
+    """Same shortening as HestiaParam::nvsKey(): keep the last 15 characters."""
+    return key if len(key) <= NVS_KEY_MAX else key[-NVS_KEY_MAX:]
+
+
+def extract_schema(text, path):
+    """Return the JSON text of the HESTIA_PARAM_JSON raw string literal."""
+    m = re.search(r'HESTIA_PARAM_JSON\[\][^=]*=\s*R"(\w*)\((.*?)\)\1"', text, re.S)
+    if not m:
+        sys.exit(f"{path}: HESTIA_PARAM_JSON raw string not found")
+    return m.group(2)
+
+
+def c_str(value):
+    if value is None:
+        return "nullptr"
+    s = str(value)
+    s = s.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+    return f'"{s}"'
+
+
+def c_double(value):
+    return repr(float(value))
+
+
+def build_rows(params, path):
+    errors = []
+    rows = []
+    seen = {}
+    seen_nvs = {}
+
+    for i, p in enumerate(params):
+        key = p.get("key", "")
+        where = f"{path}: params[{i}] '{key}'"
+
+        if not key:
+            errors.append(f"{where}: missing key")
+            continue
+        if key in seen:
+            errors.append(f"{where}: duplicate key (also params[{seen[key]}])")
+        seen[key] = i
+
+        ptype = p.get("type", "string")
+        if ptype not in TYPES:
+            errors.append(f"{where}: unknown type '{ptype}'")
+            continue
+
+        pattern = p.get("pattern", "anything")
+        if pattern not in PATTERNS:
+            errors.append(f"{where}: unknown pattern '{pattern}'")
+            continue
+
+        flags = []
+        if p.get("provisioning", False):
+            flags.append("PF_PROVISIONING")
+            short = nvs_key(key)
+            if short in seen_nvs:
+                errors.append(f"{where}: NVS key '{short}' collides with '{seen_nvs[short]}'")
+            seen_nvs[short] = key
+        if p.get("required", False):
+            flags.append("PF_REQUIRED")
+        if p.get("critical", False):
+            flags.append("PF_CRITICAL")
+
+        v = p.get("validate", {}) or {}
+        if "min" in v:
+            flags.append("PF_HAS_MIN")
+        if "max" in v:
+            flags.append("PF_HAS_MAX")
+
+        options = p.get("options")
+        if options is not None:
+            options = "|".join(str(o) for o in options)
+
+        rows.append({
+            "key":      key,
+            "label":    p.get("label", key),
+            "default":  p.get("default", ""),
+            "type":     TYPES[ptype],
+            "pattern":  PATTERNS[pattern],
+            "flags":    " | ".join(flags) if flags else "0",
+            "decimals": int(p.get("decimals", 0)),
+            "minLen":   int(v.get("minLen", -1)),
+            "maxLen":   int(v.get("maxLen", -1)),
+            "min":      c_double(v.get("min", 0)),
+            "max":      c_double(v.get("max", 0)),
+            "options":  options,
+        })
+
+    if errors:
+        for e in errors:
+            print(e, file=sys.stderr)
+        sys.exit(1)
+    return rows
+
+
+def render(rows, source):
+    out = []
+    out.append("#pragma once")
+    out.append("// ============================================================================")
+    out.append(f"//  Generated by tools/gen_device_params.py from {source} — DO NOT EDIT.")
+    out.append("//  Re-run the generator after changing the DeviceParams JSON schema.")
+    out.append("// ============================================================================")
+    out.append('#include "HestiaParamSchema.h"')
+    out.append("")
+    out.append("static const HestiaConfig::ParamDescriptor HESTIA_PARAM_TABLE[] = {")
+    out.append("  // key, label, default, type, pattern, flags, decimals, minLen, maxLen, min, max, options")
+    for r in rows:
+        out.append("  {{ {key}, {label}, {default},".format(
+            key=c_str(r["key"]), label=c_str(r["label"]), default=c_str(r["default"])))
+        out.append("    HestiaConfig::ParamType::{t}, HestiaConfig::PatternType::{p},".format(
+            t=r["type"], p=r["pattern"]))
+        flags = r["flags"]
+        if flags != "0":
+            flags = " | ".join("HestiaConfig::" + f for f in flags.split(" | "))
+        out.append("    {flags}, {dec}, {minl}, {maxl}, {mn}, {mx}, {opts} }},".format(
+            flags=flags, dec=r["decimals"], minl=r["minLen"], maxl=r["maxLen"],
+            mn=r["min"], mx=r["max"], opts=c_str(r["options"])))
+    out.append("};")
+    out.append("")
+    out.append("static constexpr size_t HESTIA_PARAM_COUNT =")
+    out.append("    sizeof(HESTIA_PARAM_TABLE) / sizeof(HESTIA_PARAM_TABLE[0]);")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("device_params", help="path to DeviceParams.h")
+    ap.add_argument("-o", "--output",
+                    help="output header (default: DeviceParamsTable.h next to the input)")
+    args = ap.parse_args()
+
+    with open(args.device_params, encoding="utf-8") as f:
+        text = f.read()
+
+    try:
+        schema = json.loads(extract_schema(text, args.device_params))
+    except json.JSONDecodeError as e:
+        sys.exit(f"{args.device_params}: invalid JSON schema: {e}")
+
+    params = schema.get("params")
+    if not isinstance(params, list):
+        sys.exit(f"{args.device_params}: 'params' array not found")
+
+    rows = build_rows(params, args.device_params)
+    output = args.output or os.path.join(os.path.dirname(args.device_params) or ".",
+                                         "DeviceParamsTable.h")
+    with open(output, "w", encoding="utf-8", newline="\n") as f:
+        f.write(render(rows, os.path.basename(args.device_params)))
+
+    print(f"{output}: {len(rows)} parameters")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+"""
+gen_discovery.py — HA discovery JSON → pre-serialized flash discovery table
+
+Reads the config_json raw string of a project's main.h (or a plain .json
+file) and does at build time everything MQTTDiscovery() otherwise does at
+runtime, writing a header the firmware publishes as-is:
+
+    static const HestiaNet::DiscoveryEntry HESTIA_DISCOVERY_TABLE[] = { ... };
+    static constexpr size_t HESTIA_DISCOVERY_COUNT = ...;
+
+Per component of "cmps":
+    • topic   homeassistant/<p>/<unique_id|key>/config
+    • payload compact JSON, "device" merged (full object on the first
+              component, identifiers only on the others, identifiers
+              normalized to an array), keys shortened to the Home Assistant
+              abbreviations (unique_id → uniq_id, device → dev, ...)
+    • hash    HestiaHash::fnv1a(payload, HestiaHash::fnv1a(topic)), used by
+              the runtime to skip configs the broker already holds
+
+Usage:
+    python3 tools/gen_discovery.py examples/Virgo/main.h
+    python3 tools/gen_discovery.py main.h -o DiscoveryTable.h
+    python3 tools/gen_discovery.py discovery.json --no-abbrev
+
+Structural errors (missing "device"/"cmps", component without "p", no
+identifiers, duplicate topics) abort without writing. Payloads that do not
+fit the MQTT client buffer (--mqtt-buffer, default 256) are reported: the
+runtime streams them at QoS 0 (HestiaNet::publish).
+Re-run whenever the discovery JSON changes.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+DISCOVERY_PREFIX = "homeassistant"
+
+# Home Assistant MQTT discovery abbreviations (homeassistant/components/mqtt/abbreviations.py).
+# Only keys known to HA are shortened; anything else is passed through.
+ABBREV_COMPONENT = {
+    "action_topic":                "act_t",
+    "automation_type":             "atype",
+    "availability":                "avty",
+    "availability_mode":           "avty_mode",
+    "availability_template":       "avty_tpl",
+    "availability_topic":          "avty_t",
+    "command_template":            "cmd_tpl",
+    "command_topic":               "cmd_t",
+    "device":                      "dev",
+    "device_class":                "dev_cla",
+    "enabled_by_default":          "en",
+    "encoding":                    "e",
+    "entity_category":             "ent_cat",
+    "entity_picture":              "ent_pic",
+    "expire_after":                "exp_aft",
+    "force_update":                "frc_upd",
+    "icon":                        "ic",
+    "json_attributes_template":    "json_attr_tpl",
+    "json_attributes_topic":       "json_attr_t",
+    "object_id":                   "obj_id",
+    "optimistic":                  "opt",
+    "options":                     "ops",
+    "origin":                      "o",
+    "payload_available":           "pl_avail",
+    "payload_not_available":       "pl_not_avail",
+    "payload_off":                 "pl_off",
+    "payload_on":                  "pl_on",
+    "payload_press":               "pl_prs",
+    "payload_reset":               "pl_rst",
+    "platform":                    "p",
+    "retain":                      "ret",
+    "state_class":                 "stat_cla",
+    "state_off":                   "stat_off",
+    "state_on":                    "stat_on",
+    "state_template":              "stat_tpl",
+    "state_topic":                 "stat_t",
+    "state_value_template":        "stat_val_tpl",
+    "suggested_display_precision": "sug_dsp_prc",
+    "unique_id":                   "uniq_id",
+    "unit_of_measurement":         "unit_of_meas",
+    "value_template":              "val_tpl",
+}
+
+ABBREV_DEVICE = {
+    "configuration_url": "cu",
+    "connections":       "cns",
+    "hw_version":        "hw",
+    "identifiers":       "ids",
+    "manufacturer":      "mf",
+    "model":             "mdl",
+    "model_id":          "mdl_id",
+    "serial_number":     "sn",
+    "suggested_area":    "sa",
+    "sw_version":        "sw",
+}
+
+ABBREV_AVAILABILITY = {
+    "payload_available":     "pl_avail",
+    "payload_not_available": "pl_not_avail",
+    "topic":                 "t",
+    "value_template":        "val_tpl",
+}
+
+TOPIC_ID = re.compile(r"^[A-Za-z0-9_-]+$")
+
+
+def extract_json(text, path):
+    """Return the discovery JSON: the config_json raw string of a header, or the file itself."""
+    if path.endswith(".json"):
+        return text
+    m = re.search(r'config_json\[\][^=]*=\s*R"(\w*)\((.*?)\)\1"', text, re.S)
+    if not m:
+        sys.exit(f"{path}: config_json raw string not found")
+    return m.group(2)
+
+
+def abbreviate(obj, table):
+    return {table.get(k, k): v for k, v in obj.items()}
+
+
+def normalize_device(device, path):
+    """Same rules as prepareDevice(): identifiers always an array."""
+    dev = dict(device)
+    ids = dev.get("identifiers")
+    if isinstance(ids, str):
+        dev["identifiers"] = [ids]
+    elif not isinstance(ids, list) or not ids:
+        # The runtime falls back to the "device_id" parameter; a build-time
+        # table has no access to it.
+        sys.exit(f"{path}: device.identifiers is required to pre-build discovery")
+    return dev, {"identifiers": dev["identifiers"]}
+
+
+def build_entries(doc, path, abbrev):
+    errors = []
+    device = doc.get("device")
+    cmps = doc.get("cmps")
+    if not isinstance(device, dict):
+        sys.exit(f"{path}: missing or invalid 'device' object")
+    if not isinstance(cmps, dict) or not cmps:
+        sys.exit(f"{path}: missing or empty 'cmps' object")
+
+    full_dev, ids_dev = normalize_device(device, path)
+    if abbrev:
+        full_dev = abbreviate(full_dev, ABBREV_DEVICE)
+        ids_dev = abbreviate(ids_dev, ABBREV_DEVICE)
+
+    entries = []
+    topics = {}
+    for i, (key, cmp) in enumerate(cmps.items()):
+        where = f"{path}: cmps['{key}']"
+        if not isinstance(cmp, dict):
+            errors.append(f"{where}: not an object")
+            continue
+
+        body = {k: v for k, v in cmp.items() if k != "device"}
+        platform = body.get("p") or body.get("platform")
+        if not platform:
+            errors.append(f"{where}: missing 'p'")
+            continue
+
+        object_id = body.get("unique_id") or body.get("uniq_id") or key
+        if not TOPIC_ID.match(object_id):
+            print(f"warning: {where}: '{object_id}' is not a valid HA topic id "
+                  f"([A-Za-z0-9_-]); HA may ignore this config", file=sys.stderr)
+
+        topic = f"{DISCOVERY_PREFIX}/{platform}/{object_id}/config"
+        if topic in topics:
+            errors.append(f"{where}: topic '{topic}' already used by cmps['{topics[topic]}']")
+            continue
+        topics[topic] = key
+
+        if abbrev:
+            body = abbreviate(body, ABBREV_COMPONENT)
+            if isinstance(body.get("avty"), list):
+                body["avty"] = [abbreviate(a, ABBREV_AVAILABILITY) if isinstance(a, dict) else a
+                                for a in body["avty"]]
+
+        body["dev" if abbrev else "device"] = full_dev if i == 0 else ids_dev
+        payload = json.dumps(body, separators=(",", ":"), ensure_ascii=False)
+        entries.append({"key": key, "topic": topic, "payload": payload})
+
+    if errors:
+        sys.exit("\n".join(errors))
+    return entries
+
+
+def fnv1a(data, seed=2166136261):
+    """Same hash as HestiaHash::fnv1a()."""
+    h = seed
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def c_str(s):
+    out = s.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+    return f'"{out}"'
+
+
+def mqtt_packet_size(topic, payload):
+    """PUBLISH QoS 1: fixed header (≤ 5) + topic length + topic + packet id + payload."""
+    return 5 + 2 + len(topic.encode()) + 2 + len(payload.encode())
+
+
+def write_header(entries, out_path, src_name):
+    lines = [
+        "#pragma once",
+        "// ============================================================================",
+        f"//  Generated by tools/gen_discovery.py from {src_name} — DO NOT EDIT.",
+        "//  Re-run the generator after changing the discovery JSON.",
+        "// ============================================================================",
+        '#include "HestiaNetSDK.h"',
+        "",
+    ]
+    for i, e in enumerate(entries):
+        lines.append(f"// {e['key']}: {len(e['payload'].encode())} bytes")
+        lines.append(f"static const char HESTIA_DISC_TOPIC_{i}[] PROGMEM = {c_str(e['topic'])};")
+        lines.append(f"static const char HESTIA_DISC_PAYLOAD_{i}[] PROGMEM = {c_str(e['payload'])};")
+        lines.append("")
+
+    lines.append("static const HestiaNet::DiscoveryEntry HESTIA_DISCOVERY_TABLE[] = {")
+    lines.append("  // topic, payload, fnv1a(payload, fnv1a(topic))")
+    for i, e in enumerate(entries):
+        h = fnv1a(e["payload"].encode(), fnv1a(e["topic"].encode()))
+        lines.append(f"  {{ HESTIA_DISC_TOPIC_{i}, HESTIA_DISC_PAYLOAD_{i}, 0x{h:08x}u }},")
+    lines.append("};")
+    lines.append("")
+    lines.append("static constexpr size_t HESTIA_DISCOVERY_COUNT =")
+    lines.append("    sizeof(HESTIA_DISCOVERY_TABLE) / sizeof(HESTIA_DISCOVERY_TABLE[0]);")
+    lines.append("")
+
+    with open(out_path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("source", help="main.h holding config_json, or a discovery .json file")
+    ap.add_argument("-o", "--output", help="output header (default: DiscoveryTable.h next to source)")
+    ap.add_argument("--no-abbrev", action="store_true", help="keep full HA key names")
+    ap.add_argument("--mqtt-buffer", type=int, default=256,
+                    help="MQTTClient buffer size to check packets against (default 256)")
+    args = ap.parse_args()
+
+    with open(args.source, encoding="utf-8") as f:
+        text = f.read()
+
+    try:
+        doc = json.loads(extract_json(text, args.source))
+    except json.JSONDecodeError as e:
+        sys.exit(f"{args.source}: invalid discovery JSON: {e}")
+
+    entries = build_entries(doc, args.source, not args.no_abbrev)
+
+    out = args.output or os.path.join(os.path.dirname(os.path.abspath(args.source)), "DiscoveryTable.h")
+    write_header(entries, out, os.path.basename(args.source))
+
+    total = 0
+    for e in entries:
+        size = mqtt_packet_size(e["topic"], e["payload"])
+        total += len(e["payload"].encode())
+        note = "" if size <= args.mqtt_buffer else f"  > {args.mqtt_buffer}-byte MQTT buffer: streamed, QoS 0"
+        print(f"{e['topic']:<52} {len(e['payload'].encode()):>5} bytes{note}")
+    print(f"{len(entries)} component(s), {total} payload bytes → {out}")
+
+
+if __name__ == "__main__":
+    main()
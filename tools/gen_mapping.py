@@ -0,0 +1,367 @@
+#!/usr/bin/env python3
+"""
+gen_mapping.py — DiscoveryMapping.json → bridge_config[], discovery, HA macros
+
+Single source of truth for a project's entities. From the mapping (and
+DeviceParams.h, for components sourced from parameters) it writes:
+
+    DeviceMapping.h    bridge_config[] / BRIDGE_COUNT, config_json,
+                       HA_ID / HA(...) macros, HestiaEntity::ID_<name> handles,
+                       HESTIA_TOPIC_INDEX (perfect-hash inbound topic table)
+    DiscoveryTable.h   pre-serialized discovery (same output as gen_discovery.py)
+
+Mapping items (in order; bridge_config[] rows follow item order):
+
+    kind "device_identity"  data: HA device object (name required; identifiers
+                            defaults to name). Optional top-level "topic_prefix"
+                            (defaults to the device name).
+    kind "bridge"           internal bridge without discovery. data: bridge_ref,
+                            type (HA_ENTITIES, ...), topic_to, topic_from, default
+    kind "integration"      one HA component. integration_id is the HA platform.
+                            source_type "BridgeConfig": the bridge_ref bridge is
+                            generated, topics derived from the platform
+                            (<prefix>/<name>/toHA, <prefix>/<name>/fromHA) unless
+                            data overrides topic_to / topic_from / type / default /
+                            resolution / deadband / min_interval_ms / max_silence_ms.
+                            source_type "Parameters": the topic is the default of
+                            parameter_ref (side: parameter_topic_side).
+
+Usage:
+    python3 tools/gen_mapping.py examples/Output_Binary/DiscoveryMapping.json
+    python3 tools/gen_mapping.py DiscoveryMapping.json --params DeviceParams.h -o .
+
+Consistency errors (unknown parameter_ref, bridge_ref without the IotBridge_
+prefix, two bridges on one inbound topic, a command platform without an
+inbound topic, ...) abort without writing anything.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import gen_device_params   # noqa: E402  (extract_schema)
+import gen_discovery       # noqa: E402  (build_entries, write_header, fnv1a)
+
+BRIDGE_PREFIX = "IotBridge_"
+TOPIC_SLOT_EMPTY = 0xFFFF
+FNV_OFFSET = 2166136261
+
+TYPES = ("HA_CONTROL", "HA_INDICATOR", "HA_BUTTON", "HA_ENTITIES")
+
+# HA platform → bridge type. Indicators only publish; buttons only receive.
+PLATFORM_TYPE = {
+    "sensor":        "HA_INDICATOR",
+    "binary_sensor": "HA_INDICATOR",
+    "button":        "HA_BUTTON",
+    "switch":        "HA_CONTROL",
+    "number":        "HA_CONTROL",
+    "select":        "HA_CONTROL",
+    "text":          "HA_CONTROL",
+    "light":         "HA_CONTROL",
+}
+
+# Optional mapping fields copied to the discovery component when non-empty.
+COMPONENT_FIELDS = ("device_class", "unit_of_measurement", "icon", "state_class", "entity_category")
+
+
+class Errors(list):
+    def check(self):
+        if self:
+            sys.exit("\n".join(self))
+
+
+def load_param_defaults(path):
+    if not path or not os.path.exists(path):
+        return None
+    with open(path, encoding="utf-8") as f:
+        schema = json.loads(gen_device_params.extract_schema(f.read(), path))
+    return {p.get("key"): p.get("default") for p in schema.get("params", [])}
+
+
+def entity_name(bridge_ref, where, errors):
+    if not bridge_ref.startswith(BRIDGE_PREFIX) or len(bridge_ref) == len(BRIDGE_PREFIX):
+        errors.append(f"{where}: bridge_ref '{bridge_ref}' must be '{BRIDGE_PREFIX}<name>'")
+        return None
+    name = bridge_ref[len(BRIDGE_PREFIX):]
+    if not re.match(r"^[A-Za-z_][A-Za-z0-9_]*$", name):
+        errors.append(f"{where}: '{name}' is not a valid C++ identifier (used for HA_{name})")
+        return None
+    return name
+
+
+def make_bridge(name, data, btype, prefix):
+    inbound = btype in ("HA_CONTROL", "HA_BUTTON")
+    outbound = btype in ("HA_CONTROL", "HA_INDICATOR")
+    return {
+        "name":      name,
+        "type":      data.get("type") or btype,
+        "topic_to":  data.get("topic_to", f"{prefix}/{name}/toHA" if outbound else ""),
+        "topic_from": data.get("topic_from", f"{prefix}/{name}/fromHA" if inbound else ""),
+        "resolution": data.get("resolution", ""),
+        "default":   data.get("default", ""),
+        "deadband":  data.get("deadband"),
+        "min_ms":    int(data.get("min_interval_ms", 0)),
+        "max_ms":    int(data.get("max_silence_ms", 0)),
+    }
+
+
+def build(mapping, path, params):
+    errors = Errors()
+    items = mapping.get("items")
+    if not isinstance(items, list):
+        sys.exit(f"{path}: 'items' array missing")
+
+    ident = next((i for i in items if i.get("kind") == "device_identity"), None)
+    device = dict((ident or {}).get("data") or {})
+    if not device.get("name"):
+        sys.exit(f"{path}: device_identity.data.name is required")
+    device.setdefault("identifiers", device["name"])
+    prefix = mapping.get("topic_prefix") or device["name"]
+    dev_id = device["identifiers"][0] if isinstance(device["identifiers"], list) else device["identifiers"]
+
+    bridges = []
+    by_name = {}
+    cmps = {}
+
+    def add_bridge(b, where):
+        if b["type"] not in TYPES:
+            errors.append(f"{where}: unknown bridge type '{b['type']}'")
+            return None
+        prev = by_name.get(b["name"])
+        if prev:
+            return prev
+        by_name[b["name"]] = b
+        bridges.append(b)
+        return b
+
+    for idx, item in enumerate(items):
+        kind = item.get("kind")
+        data = item.get("data") or {}
+        where = f"{path}: items[{idx}] '{item.get('id', '')}'"
+
+        if kind == "device_identity":
+            continue
+
+        if kind == "bridge":
+            name = entity_name(data.get("bridge_ref", ""), where, errors)
+            if name:
+                add_bridge(make_bridge(name, data, data.get("type", ""), prefix), where)
+            continue
+
+        if kind != "integration":
+            errors.append(f"{where}: unknown kind '{kind}'")
+            continue
+
+        platform = item.get("integration_id", "")
+        btype = PLATFORM_TYPE.get(platform)
+        if not btype:
+            errors.append(f"{where}: unsupported platform '{platform}'")
+            continue
+
+        key = data.get("_last_cmp_key") or item.get("label") or item.get("id")
+        if key in cmps:
+            errors.append(f"{where}: component key '{key}' already used")
+            continue
+
+        source = data.get("source_type")
+        if source == "BridgeConfig":
+            name = entity_name(data.get("bridge_ref", ""), where, errors)
+            if not name:
+                continue
+            b = add_bridge(make_bridge(name, data, btype, prefix), where)
+            if not b:
+                continue
+            state, command = b["topic_to"], b["topic_from"]
+        elif source == "Parameters":
+            ref = data.get("parameter_ref", "")
+            if params is None:
+                errors.append(f"{where}: parameter_ref '{ref}' needs DeviceParams.h (--params)")
+                continue
+            if ref not in params:
+                errors.append(f"{where}: parameter_ref '{ref}' not in DeviceParams.h")
+                continue
+            topic = params[ref] or ""
+            side = data.get("parameter_topic_side", "topicTo")
+            state, command = (topic, "") if side == "topicTo" else ("", topic)
+        else:
+            errors.append(f"{where}: unknown source_type '{source}'")
+            continue
+
+        if btype in ("HA_CONTROL", "HA_BUTTON") and not command:
+            errors.append(f"{where}: {platform} needs an inbound (command) topic")
+            continue
+        if btype in ("HA_CONTROL", "HA_INDICATOR") and not state:
+            errors.append(f"{where}: {platform} needs a state topic")
+            continue
+
+        cmp = {"p": platform, "name": item.get("label") or key, "unique_id": f"{dev_id}_{key}"}
+        if state and btype != "HA_BUTTON":
+            cmp["stat_t"] = state
+        if command and btype != "HA_INDICATOR":
+            cmp["cmd_t"] = command
+        for f in COMPONENT_FIELDS:
+            if data.get(f):
+                cmp[f] = data[f]
+        if data.get("force_update"):
+            cmp["force_update"] = True
+        if data.get("availability"):
+            cmp["availability"] = [{"topic": f"{prefix}/availability"}]
+        cmps[key] = cmp
+
+    # Two consumers on one inbound topic: the runtime would silently keep the first.
+    seen = {}
+    for b in bridges:
+        if b["topic_from"] and b["type"] != "HA_INDICATOR":
+            other = seen.setdefault(b["topic_from"], b["name"])
+            if other != b["name"]:
+                errors.append(f"{path}: '{b['name']}' and '{other}' both consume '{b['topic_from']}'")
+
+    errors.check()
+    if not cmps:
+        sys.exit(f"{path}: no integration items, nothing to discover")
+
+    discovery = {"device": device, "o": {"name": device["name"]}, "cmps": cmps}
+    return bridges, discovery
+
+
+def perfect_hash(bridges):
+    """Seed + power-of-two table where every inbound topic has its own slot."""
+    rows = [(i, b["topic_from"].encode()) for i, b in enumerate(bridges)
+            if b["topic_from"] and b["type"] != "HA_INDICATOR"]
+    slots = 8
+    while slots < len(rows) * 2:
+        slots <<= 1
+
+    while True:
+        mask = slots - 1
+        for attempt in range(100000):
+            seed = FNV_OFFSET if attempt == 0 else attempt
+            table = [TOPIC_SLOT_EMPTY] * slots
+            for i, topic in rows:
+                pos = gen_discovery.fnv1a(topic, seed) & mask
+                if table[pos] != TOPIC_SLOT_EMPTY:
+                    break
+                table[pos] = i
+            else:
+                return seed, table, len(rows)
+        slots <<= 1
+
+
+def c_str(s):
+    return gen_discovery.c_str(s or "")
+
+
+def macro_name(name):
+    return name if name.startswith("HA_") else f"HA_{name}"
+
+
+def write_mapping_header(bridges, discovery, index, out_path, src_name):
+    seed, slots, inbound = index
+    L = [
+        "#pragma once",
+        "// ============================================================================",
+        f"//  Generated by tools/gen_mapping.py from {src_name} — DO NOT EDIT.",
+        "//  Re-run the generator after changing the mapping (or DeviceParams.h).",
+        "// ============================================================================",
+        "#include <Arduino.h>",
+        '#include "HAIotBridge.h"',
+        '#include "HestiaCore.h"',
+        "",
+        "// Format: { internalName, typeHA, topicTo, topicFrom, resolution, defaultValue",
+        "//           [, deadband, minIntervalMs, maxSilenceMs] }",
+        "static constexpr BridgeConfig bridge_config[] PROGMEM = {",
+    ]
+    for b in bridges:
+        row = (f'    {{ {c_str(BRIDGE_PREFIX + b["name"])}, TypeHA::{b["type"]}, '
+               f'{c_str(b["topic_to"])}, {c_str(b["topic_from"])}, '
+               f'{c_str(b["resolution"])}, {c_str(b["default"])}')
+        if b["deadband"] or b["min_ms"] or b["max_ms"]:
+            db = c_str(b["deadband"]) if b["deadband"] else "nullptr"
+            row += f', {db}, {b["min_ms"]}, {b["max_ms"]}'
+        L.append(row + " },")
+    L += [
+        "};",
+        "",
+        "static const size_t BRIDGE_COUNT = sizeof(bridge_config) / sizeof(BridgeConfig);",
+        "",
+        "// Discovery JSON (runtime-parsed form; DiscoveryTable.h is the pre-serialized one)",
+        'static const char config_json[] PROGMEM = R"rawliteral(',
+        json.dumps(discovery, indent=2, ensure_ascii=False),
+        ')rawliteral";',
+        "",
+        "// HA_ID(name): compile-time row of \"IotBridge_<name>\"; unknown names fail the build.",
+        "#define HA_ID(name) (HestiaCore::detail::CheckedHandle< \\",
+        "                       HestiaCore::handleOf(bridge_config, \"IotBridge_\" name)>::value)",
+        "#define HA(name)    HestiaCore::at(HA_ID(name))",
+        "",
+        "#define HA_FIXED(name, dec) HestiaCore::FixedHandle<dec>(HA_ID(name))",
+        "#define HA_INT(name)        HestiaCore::IntHandle(HA_ID(name))",
+        "#define HA_BOOL(name)       HestiaCore::BoolHandle(HA_ID(name))",
+        "",
+        "// Entity handles. ID_ prefix: a bare name would collide with HA_<name> macros.",
+        "namespace HestiaEntity {",
+    ]
+    width = max(len(b["name"]) for b in bridges) + 3
+    for i, b in enumerate(bridges):
+        L.append(f"  constexpr HestiaCore::BridgeHandle {'ID_' + b['name']:<{width}} = {i};")
+    L += ["}", ""]
+    for b in bridges:
+        L.append(f"static_assert(HA_ID({c_str(b['name'])}) == HestiaEntity::ID_{b['name']}, "
+                 f"\"bridge_config[] out of sync\");")
+    L.append("")
+    mwidth = max(len(macro_name(b["name"])) for b in bridges)
+    for b in bridges:
+        L.append(f"#define {macro_name(b['name']):<{mwidth}} HestiaCore::at(HestiaEntity::ID_{b['name']})")
+    L += [
+        "",
+        f"// Inbound topics: {inbound}, perfect hash fnv1a(topicFrom, seed) & {len(slots) - 1}",
+        f"static const uint16_t HESTIA_TOPIC_SLOTS[{len(slots)}] = {{",
+        "    " + ", ".join("0xFFFF" if s == TOPIC_SLOT_EMPTY else str(s) for s in slots),
+        "};",
+        "",
+        "static constexpr HestiaCore::TopicIndex HESTIA_TOPIC_INDEX = {",
+        f"    HESTIA_TOPIC_SLOTS, {len(slots)}, 0x{seed:08x}u",
+        "};",
+        "",
+    ]
+    with open(out_path, "w", encoding="utf-8") as f:
+        f.write("\n".join(L))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("mapping", help="DiscoveryMapping.json")
+    ap.add_argument("--params", help="DeviceParams.h (default: next to the mapping)")
+    ap.add_argument("-o", "--output", help="output directory (default: next to the mapping)")
+    ap.add_argument("--no-abbrev", action="store_true", help="keep full HA key names in DiscoveryTable.h")
+    args = ap.parse_args()
+
+    src_dir = os.path.dirname(os.path.abspath(args.mapping))
+    out_dir = args.output or src_dir
+    params_path = args.params or os.path.join(src_dir, "DeviceParams.h")
+
+    with open(args.mapping, encoding="utf-8") as f:
+        try:
+            mapping = json.load(f)
+        except json.JSONDecodeError as e:
+            sys.exit(f"{args.mapping}: invalid JSON: {e}")
+
+    bridges, discovery = build(mapping, args.mapping, load_param_defaults(params_path))
+    entries = gen_discovery.build_entries(discovery, args.mapping, not args.no_abbrev)
+    index = perfect_hash(bridges)
+
+    src_name = os.path.basename(args.mapping)
+    write_mapping_header(bridges, discovery, index, os.path.join(out_dir, "DeviceMapping.h"), src_name)
+    gen_discovery.write_header(entries, os.path.join(out_dir, "DiscoveryTable.h"), src_name)
+
+    for i, b in enumerate(bridges):
+        print(f"[{i:>2}] {b['name']:<20} {b['type']:<13} to={b['topic_to'] or '-'}  from={b['topic_from'] or '-'}")
+    print(f"{len(bridges)} bridge(s), {len(entries)} discovery component(s), "
+          f"{index[2]} inbound topic(s) in {len(index[1])} slots (seed 0x{index[0]:08x}) → {out_dir}")
+
+
+if __name__ == "__main__":
+    main()
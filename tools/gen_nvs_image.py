@@ -0,0 +1,397 @@
+#!/usr/bin/env python3
+"""
+gen_nvs_image.py — DeviceParams.h schema + per-device CSV → NVS partition images
+
+Factory provisioning without the captive portal: for each CSV row, validate
+the values with the same rules as HestiaParam::validate() and write an
+ESP-IDF NVS partition image holding the "HConfig" namespace exactly as the
+firmware would have written it (keys shortened by HestiaParam::nvsKey(),
+values as strings):
+
+    python3 tools/gen_nvs_image.py examples/Virgo/DeviceParams.h devices.csv -d out/
+    esptool.py --chip esp32 write_flash 0x9000 out/virgo-001.nvs.bin
+
+CSV layout: a header row of parameter keys, then one row per device.
+    image,wifi_ssid,wifi_pass,mqtt_ip
+    virgo-001,Factory,secret,192.168.1.10
+
+  • Only provisioning parameters may appear (the others are never read from NVS)
+  • An empty cell keeps the schema default (what lazyInit would write)
+  • One image per row: <image>.nvs.bin, or row<N>.nvs.bin without an "image" column
+
+The image also carries force_prov=0 and last_fw_id=<version_prog default> so
+the first boot neither enters provisioning nor runs the init_on_update reset.
+Every image is parsed back and compared before the tool reports success.
+
+The offset (0x9000) and size (--size, 0x5000) must match the "nvs" entry of
+the partition table in use. Runs on any host with Python 3 — no ESP-IDF needed.
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import re
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from gen_device_params import extract_schema, nvs_key, TYPES, PATTERNS  # noqa: E402
+
+NAMESPACE = "HConfig"              # HestiaParam::NVS_NAMESPACE
+KEY_FORCE_PROV = "force_prov"      # HestiaConfig NVS_KEY_FORCE_PROV
+KEY_LAST_FW_ID = "last_fw_id"      # HestiaConfig NVS_KEY_LAST_FW_ID
+IMAGE_COLUMN = "image"             # CSV column naming the output file, not a parameter
+
+# ----------------------------------------------------------------------------
+#  NVS on-flash format (ESP-IDF nvs_flash, page format version 2)
+# ----------------------------------------------------------------------------
+PAGE_SIZE = 4096
+ENTRY_SIZE = 32
+ENTRIES_PER_PAGE = 126
+ENTRY_OFFSET = 64                  # header (32) + state bitmap (32)
+PAGE_ACTIVE = 0xFFFFFFFE
+PAGE_FULL = 0xFFFFFFFC
+PAGE_VERSION = 0xFE                # version 2
+TYPE_U8 = 0x01
+TYPE_SZ = 0x21
+CHUNK_ANY = 0xFF
+MAX_STRING = 4000                  # including the terminating NUL
+
+
+def crc32(data):
+    """ESP-IDF crc32_le(0xFFFFFFFF, …) as used by nvs_flash."""
+    return zlib.crc32(bytes(data), 0xFFFFFFFF) & 0xFFFFFFFF
+
+
+# ============================================================================
+#  Validation — mirror of HestiaParam::write() + validate()
+# ============================================================================
+
+HOST_CHARS = re.compile(r"^[A-Za-z0-9-]+$")
+URL_CHARS = re.compile(r"^[A-Za-z0-9\-._~:/?#\[\]@!$&'()*+,;=%]*$")
+LOCAL_CHARS = re.compile(r"^[A-Za-z0-9!#$%&'*+\-/=?^_`{|}~.]+$")
+URL_SCHEMES = ("http", "https", "mqtt", "mqtts", "ws", "wss")
+FLOAT_PREFIX = re.compile(r"^\s*[+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?")
+
+
+def atof(s):
+    """C atof(): longest numeric prefix, 0.0 if none."""
+    m = FLOAT_PREFIX.match(s)
+    return float(m.group(0)) if m else 0.0
+
+
+def match_host(s):
+    if not 1 <= len(s) <= 64:
+        return False
+    labels = s.split(".")
+    return all(1 <= len(l) <= 63 and HOST_CHARS.match(l)
+               and not l.startswith("-") and not l.endswith("-") for l in labels)
+
+
+def match_ip(s):
+    parts = s.split(".")
+    return (len(parts) == 4 and
+            all(p.isdigit() and p.isascii() and 1 <= int(p) <= 255 for p in parts))
+
+
+def match_url(s):
+    scheme, sep, rest = s.partition("://")
+    if not sep or scheme.lower() not in URL_SCHEMES:
+        return False
+    m = re.match(r"^([^:/?#]*)(?::(\d*))?(.*)$", rest, re.S)
+    host, port, tail = m.group(1), m.group(2), m.group(3)
+    if not match_host(host):
+        return False
+    if port is not None and (not port or not 0 < int(port) <= 65535):
+        return False
+    return bool(URL_CHARS.match(tail))
+
+
+def match_email(s):
+    local, at, domain = s.partition("@")
+    if not at or not local or len(local) > 64:
+        return False
+    if local.startswith(".") or local.endswith(".") or ".." in local:
+        return False
+    if not LOCAL_CHARS.match(local):
+        return False
+    return "." in domain and match_host(domain)
+
+
+MATCHERS = {
+    "ANYTHING": lambda s: True,
+    "IP":       match_ip,
+    "HOSTNAME": match_host,
+    "URL":      match_url,
+    "EMAIL":    match_email,
+    "BOOL":     lambda s: s in ("true", "false"),
+}
+
+
+def normalize(p, value):
+    """HestiaParam::write(String): trim, canonical bool spelling."""
+    v = value.strip()
+    if p.get("type", "string") == "bool":
+        low = v.lower()
+        if low in ("true", "on", "1"):
+            return "true"
+        if low in ("false", "off", "0"):
+            return "false"
+    return v
+
+
+def validate(p, v):
+    """HestiaParam::validate(); returns None or a reason."""
+    if p.get("required", False) and not v:
+        return "required"
+    if not MATCHERS[PATTERNS[p.get("pattern", "anything")]](v):
+        return f"pattern '{p.get('pattern')}'"
+
+    rules = p.get("validate", {}) or {}
+    ptype = p.get("type", "string")
+    if ptype == "string":
+        if "minLen" in rules and len(v.encode()) < int(rules["minLen"]):
+            return f"shorter than {rules['minLen']}"
+        if "maxLen" in rules and len(v.encode()) > int(rules["maxLen"]):
+            return f"longer than {rules['maxLen']}"
+    elif ptype in ("number", "int", "float"):
+        n = atof(v)
+        if "min" in rules and n < float(rules["min"]):
+            return f"below min {rules['min']}"
+        if "max" in rules and n > float(rules["max"]):
+            return f"above max {rules['max']}"
+    return None
+
+
+# ============================================================================
+#  Image writer
+# ============================================================================
+
+class NvsImage:
+    def __init__(self, size):
+        if size % PAGE_SIZE or size < 3 * PAGE_SIZE:
+            sys.exit(f"partition size 0x{size:x}: must be a multiple of 0x1000, at least 0x3000")
+        self.pages = [bytearray(b"\xff" * PAGE_SIZE) for _ in range(size // PAGE_SIZE)]
+        self.page = 0
+        self.slot = 0
+        self.namespaces = {}
+
+    def _alloc(self, span):
+        if self.slot + span > ENTRIES_PER_PAGE:
+            self.page += 1
+            self.slot = 0
+        # nvs_flash keeps one page free for garbage collection
+        if self.page >= len(self.pages) - 1:
+            sys.exit("NVS image full: increase --size")
+        first = self.slot
+        self.slot += span
+        return self.page, first
+
+    def _put(self, ns, etype, key, data8, payload=b""):
+        if len(key) > 15:
+            raise ValueError(f"NVS key '{key}' longer than 15 characters")
+        span = 1 + math.ceil(len(payload) / ENTRY_SIZE)
+        page, first = self._alloc(span)
+
+        entry = bytearray(b"\xff" * ENTRY_SIZE)
+        entry[0] = ns
+        entry[1] = etype
+        entry[2] = span
+        entry[3] = CHUNK_ANY
+        entry[8:24] = key.encode().ljust(16, b"\x00")
+        entry[24:32] = data8
+        struct.pack_into("<I", entry, 4, crc32(entry[0:4] + entry[8:32]))
+
+        buf = self.pages[page]
+        off = ENTRY_OFFSET + first * ENTRY_SIZE
+        buf[off:off + ENTRY_SIZE] = entry
+        padded = payload.ljust(math.ceil(len(payload) / ENTRY_SIZE) * ENTRY_SIZE, b"\xff")
+        buf[off + ENTRY_SIZE:off + ENTRY_SIZE + len(padded)] = padded
+
+        for i in range(first, first + span):       # EMPTY (11) → WRITTEN (10)
+            buf[32 + i // 4] &= ~(1 << (2 * (i % 4))) & 0xFF
+
+    def namespace(self, name):
+        if name not in self.namespaces:
+            index = len(self.namespaces) + 1
+            self._put(0, TYPE_U8, name, bytes([index]) + b"\xff" * 7)
+            self.namespaces[name] = index
+        return self.namespaces[name]
+
+    def put_u8(self, ns, key, value):
+        self._put(self.namespace(ns), TYPE_U8, key, bytes([value & 0xFF]) + b"\xff" * 7)
+
+    def put_str(self, ns, key, value):
+        data = value.encode("utf-8") + b"\x00"
+        if len(data) > MAX_STRING:
+            raise ValueError(f"'{key}': string longer than {MAX_STRING - 1} bytes")
+        data8 = struct.pack("<HHI", len(data), 0xFFFF, crc32(data))
+        self._put(self.namespace(ns), TYPE_SZ, key, data8, data)
+
+    def render(self):
+        for i, buf in enumerate(self.pages[:self.page + 1]):
+            header = bytearray(b"\xff" * 32)
+            struct.pack_into("<II", header, 0, PAGE_ACTIVE if i == self.page else PAGE_FULL, i)
+            header[8] = PAGE_VERSION
+            struct.pack_into("<I", header, 28, crc32(header[4:28]))
+            buf[0:32] = header
+        return b"".join(self.pages)
+
+
+# ============================================================================
+#  Image reader — independent parse used to verify every written image
+# ============================================================================
+
+def read_image(image):
+    """Return {namespace: {key: value}} for every valid entry; raise on CRC errors."""
+    names = {}
+    items = []
+    for p in range(len(image) // PAGE_SIZE):
+        buf = image[p * PAGE_SIZE:(p + 1) * PAGE_SIZE]
+        state, seq = struct.unpack_from("<II", buf, 0)
+        if state == 0xFFFFFFFF:
+            continue
+        if struct.unpack_from("<I", buf, 28)[0] != crc32(buf[4:28]):
+            raise ValueError(f"page {p}: header CRC mismatch")
+        i = 0
+        while i < ENTRIES_PER_PAGE:
+            if (buf[32 + i // 4] >> (2 * (i % 4))) & 3 != 2:
+                i += 1
+                continue
+            e = buf[ENTRY_OFFSET + i * ENTRY_SIZE:ENTRY_OFFSET + (i + 1) * ENTRY_SIZE]
+            if struct.unpack_from("<I", e, 4)[0] != crc32(e[0:4] + e[8:32]):
+                raise ValueError(f"page {p} entry {i}: CRC mismatch")
+            ns, etype, span = e[0], e[1], e[2]
+            key = e[8:24].split(b"\x00")[0].decode()
+            if etype == TYPE_U8:
+                value = e[24]
+            elif etype == TYPE_SZ:
+                size, _, dcrc = struct.unpack_from("<HHI", e, 24)
+                start = ENTRY_OFFSET + (i + 1) * ENTRY_SIZE
+                data = buf[start:start + size]
+                if crc32(data) != dcrc:
+                    raise ValueError(f"'{key}': data CRC mismatch")
+                value = data[:-1].decode("utf-8")
+            else:
+                raise ValueError(f"'{key}': unexpected type 0x{etype:02x}")
+            if ns == 0:
+                names[value] = key
+            else:
+                items.append((ns, key, value))
+            i += span
+    out = {}
+    for ns, key, value in items:
+        out.setdefault(names[ns], {})[key] = value
+    return out
+
+
+# ============================================================================
+#  Main
+# ============================================================================
+
+def load_schema(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    try:
+        schema = json.loads(extract_schema(text, path))
+    except json.JSONDecodeError as e:
+        sys.exit(f"{path}: invalid JSON schema: {e}")
+    params = schema.get("params")
+    if not isinstance(params, list):
+        sys.exit(f"{path}: 'params' array not found")
+    for p in params:
+        if p.get("type", "string") not in TYPES or p.get("pattern", "anything") not in PATTERNS:
+            sys.exit(f"{path}: '{p.get('key')}': unknown type/pattern (run gen_device_params.py)")
+    return params
+
+
+def build_values(params, row, where):
+    """Per-device values as the firmware would hold them, or a list of errors."""
+    by_key = {p["key"]: p for p in params}
+    errors = []
+    for col in row:
+        if col == IMAGE_COLUMN:
+            continue
+        if col not in by_key:
+            errors.append(f"{where}: unknown parameter '{col}'")
+        elif not by_key[col].get("provisioning", False):
+            errors.append(f"{where}: '{col}' is not a provisioning parameter")
+
+    values = {}
+    for p in params:
+        if not p.get("provisioning", False):
+            continue
+        cell = row.get(p["key"])
+        raw = cell if cell not in (None, "") else str(p.get("default", ""))
+        v = normalize(p, raw)
+        reason = validate(p, v)
+        if reason:
+            errors.append(f"{where}: '{p['key']}' = '{v}': {reason}")
+        values[p["key"]] = v
+    return values, errors
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("device_params", help="path to DeviceParams.h")
+    ap.add_argument("csv", help="per-device values (header row = parameter keys)")
+    ap.add_argument("-d", "--out-dir", default=".", help="output directory (default: .)")
+    ap.add_argument("--size", default="0x5000", help="NVS partition size (default: 0x5000)")
+    ap.add_argument("--fw-id", help="last_fw_id to record (default: version_prog default)")
+    args = ap.parse_args()
+
+    params = load_schema(args.device_params)
+    size = int(args.size, 0)
+
+    fw_id = args.fw_id
+    if fw_id is None:
+        fw_id = next((str(p.get("default", "")) for p in params if p["key"] == "version_prog"), "")
+
+    with open(args.csv, newline="", encoding="utf-8") as f:
+        rows = [{k.strip(): (v or "") for k, v in r.items() if k} for r in csv.DictReader(f)]
+    if not rows:
+        sys.exit(f"{args.csv}: no device rows")
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    failed = 0
+    for n, row in enumerate(rows, start=1):
+        where = f"{args.csv}:{n + 1}"
+        values, errors = build_values(params, row, where)
+        if errors:
+            for e in errors:
+                print(e, file=sys.stderr)
+            failed += 1
+            continue
+
+        img = NvsImage(size)
+        expected = {}
+        for key, v in values.items():
+            short = nvs_key(key)
+            img.put_str(NAMESPACE, short, v)
+            expected[short] = v
+        img.put_u8(NAMESPACE, KEY_FORCE_PROV, 0)
+        expected[KEY_FORCE_PROV] = 0
+        if fw_id:
+            img.put_str(NAMESPACE, KEY_LAST_FW_ID, fw_id)
+            expected[KEY_LAST_FW_ID] = fw_id
+        image = img.render()
+
+        readback = read_image(image).get(NAMESPACE, {})
+        if readback != expected:
+            sys.exit(f"{where}: image verification failed")
+
+        name = re.sub(r"[^A-Za-z0-9_.-]", "_", row.get(IMAGE_COLUMN) or f"row{n}")
+        out = os.path.join(args.out_dir, f"{name}.nvs.bin")
+        with open(out, "wb") as f:
+            f.write(image)
+        print(f"{out}: {len(values)} parameters, {len(image)} bytes")
+
+    if failed:
+        sys.exit(f"{failed} row(s) rejected, no image written for them")
+
+
+if __name__ == "__main__":
+    main()
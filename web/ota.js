@@ -0,0 +1,43 @@
+// TIMER 10 minutes (600 secondes)
+var timeoutSec = 600;
+function updateCountdown(){
+  var m = Math.floor(timeoutSec/60);
+  var s = timeoutSec % 60;
+  document.getElementById('countdown').innerText =
+    'Time remaining: ' + m + 'm ' + (s<10?'0':'') + s + 's';
+  timeoutSec--;
+}
+setInterval(updateCountdown, 1000);
+
+// RESET TIMER FRONTEND
+function resetTimer(){ timeoutSec = 600; }
+document.getElementById('file').addEventListener('change', resetTimer);
+
+// UPLOAD + PROGRESSION
+function startUpload(){
+  var f = document.getElementById('file').files[0];
+  if(!f){ alert('Select a file first'); return; }
+  resetTimer(); // activité détectée
+
+  var xhr = new XMLHttpRequest();
+  xhr.open('POST', '/upload', true);
+
+  // PROGRESSION
+  xhr.upload.onprogress = function(e){
+    resetTimer(); // activité → reset
+    if(e.lengthComputable){
+      var p = Math.round((e.loaded / e.total) * 100);
+      document.getElementById('bar').style.width = p + '%';
+      document.getElementById('status').innerText = p + '%';
+    }
+  };
+
+  // FIN UPLOAD
+  xhr.onload = function(){
+    document.getElementById('status').innerHTML = 'Upload complete. Device rebooting…';
+  };
+
+  var form = new FormData();
+  form.append('firmware', f);
+  xhr.send(form);
+}
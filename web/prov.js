@@ -0,0 +1,47 @@
+function updateProvisioningStatus() {
+  var form = document.getElementById('provForm');
+  var fields = form.querySelectorAll('input, select');
+  var allValid = true;
+  for (var i = 0; i < fields.length; i++) {
+    if (!fields[i].checkValidity()) {
+      allValid = false;
+      break;
+    }
+  }
+  var status = document.getElementById('cfgStatus');
+  var btn = document.getElementById('saveBtn');
+  if (allValid) {
+    status.textContent = 'Valid configuration';
+    status.className = 'status-badge status-ok';
+    btn.textContent = 'Save configuration';
+    btn.className = 'save-normal';
+    btn.dataset.mode = 'normal';
+  } else {
+    status.textContent = 'Invalid configuration';
+    status.className = 'status-badge status-bad';
+    btn.textContent = 'Save invalid configuration';
+    btn.className = 'save-force';
+    btn.dataset.mode = 'force';
+  }
+}
+
+function submitProvisioningForm(ev) {
+  ev.preventDefault();
+  var form = document.getElementById('provForm');
+  var btn = document.getElementById('saveBtn');
+  var mode = btn.dataset.mode || 'normal';
+  if (mode === 'force') {
+    form.action = '/forceSave';
+  } else {
+    form.action = '/save';
+  }
+  form.submit();
+}
+
+document.addEventListener('DOMContentLoaded', function() {
+  var form = document.getElementById('provForm');
+  var btn = document.getElementById('saveBtn');
+  form.addEventListener('input', updateProvisioningStatus);
+  btn.addEventListener('click', submitProvisioningForm);
+  updateProvisioningStatus();
+});